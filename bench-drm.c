@@ -0,0 +1,319 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+#include <dlfcn.h>
+
+
+/**
+ * The maximum number of ioctls per call, after the first call,
+ * for the operations whose ioctl count shall not regress;
+ * only checked when drm-simulator.so is loaded
+ */
+static const struct budget {
+	/**
+	 * The name of the operation
+	 */
+	const char *operation;
+
+	/**
+	 * The maximum number of ioctls with the legacy gamma ioctls
+	 */
+	unsigned long long int legacy;
+
+	/**
+	 * The maximum number of ioctls with atomic modesetting
+	 */
+	unsigned long long int atomic;
+} budgets[] = {
+	{"get_crtc_information", 3, 2},
+	{"get_gamma_ramps16",    1, 4},
+	{"set_gamma_ramps16",    1, 3}
+};
+
+/**
+ * The number of times each operation is benchmarked
+ */
+static size_t iterations = 1000;
+
+/**
+ * Latency of each call in the current benchmark, in nanoseconds
+ */
+static unsigned long long int *latencies;
+
+/**
+ * `libgamma_drm_simulator_ioctls` from drm-simulator.so,
+ * `NULL` if the simulator is not loaded
+ */
+static unsigned long long int (*simulator_ioctls)(void);
+
+/**
+ * Whether the benchmarked CRTC uses atomic modesetting
+ */
+static int atomic;
+
+/**
+ * Whether an operation has exceeded its ioctl budget
+ */
+static int over_budget = 0;
+
+
+/**
+ * Get the time on the monotonic clock
+ *
+ * @return  The time, in nanoseconds
+ */
+static unsigned long long int
+now(void)
+{
+	struct timespec ts;
+	if (clock_gettime(CLOCK_MONOTONIC, &ts)) {
+		perror("clock_gettime");
+		exit(1);
+	}
+	return (unsigned long long int)ts.tv_sec * 1000000000ULL + (unsigned long long int)ts.tv_nsec;
+}
+
+
+/**
+ * Get the number of ioctls that have been made
+ *
+ * @return  The number of ioctls, 0 if drm-simulator.so is not loaded
+ */
+static unsigned long long int
+ioctls(void)
+{
+	return simulator_ioctls ? simulator_ioctls() : 0;
+}
+
+
+/**
+ * Compare two latencies, for `qsort`
+ *
+ * @param   a  One of the latencies
+ * @param   b  The other latency
+ * @return     Negative if `a` is less than `b`, positive if `a`
+ *             is greater than `b`, zero if they are equal
+ */
+static int
+latency_cmp(const void *a, const void *b)
+{
+	unsigned long long int x = *(const unsigned long long int *)a;
+	unsigned long long int y = *(const unsigned long long int *)b;
+	return x < y ? -1 : x > y;
+}
+
+
+/**
+ * Print the result of a benchmark, the latencies in `latencies` are
+ * sorted, and check the operation's ioctl budget, if it has one
+ *
+ * @param  name    The name of the operation
+ * @param  elapsed The total run time, in nanoseconds
+ * @param  total   The number of ioctls made during the benchmark
+ * @param  steady  The greatest number of ioctls made by a call other than the first
+ */
+static void
+report(const char *name, unsigned long long int elapsed, unsigned long long int total, unsigned long long int steady)
+{
+	unsigned long long int sum = 0, max;
+	size_t i;
+
+	qsort(latencies, iterations, sizeof(*latencies), latency_cmp);
+	for (i = 0; i < iterations; i++)
+		sum += latencies[i];
+	printf("%s\t%s\t%zu\t%llu\t%llu\t%.1f\t%.0f\t", atomic ? "atomic" : "legacy", name, iterations,
+	       latencies[iterations / 2], latencies[iterations - 1 - iterations / 100],
+	       (double)sum / (double)iterations, (double)iterations / ((double)elapsed / 1e9));
+	if (!simulator_ioctls) {
+		printf("-\t-\n");
+		return;
+	}
+	printf("%.2f\t%llu\n", (double)total / (double)iterations, steady);
+
+	for (i = 0; i < sizeof(budgets) / sizeof(*budgets); i++) {
+		if (strcmp(budgets[i].operation, name))
+			continue;
+		max = atomic ? budgets[i].atomic : budgets[i].legacy;
+		if (steady > max && iterations > 1) {
+			fprintf(stderr, "%s makes %llu ioctls per call, but at most %llu are expected\n", name, steady, max);
+			over_budget = 1;
+		}
+	}
+}
+
+
+/**
+ * Benchmark an operation, calling it once per iteration
+ *
+ * If the operation fails, the error is printed to
+ * standard error and the benchmark is abandoned
+ *
+ * @param  NAME     The name of the operation
+ * @param  CLEANUP  Statement to run, untimed, after each successful call
+ * @param  ...      The operation, it shall evaluate to zero on success
+ */
+#define BENCHMARK(NAME, CLEANUP, ...)\
+	do {\
+		unsigned long long int start__, elapsed__ = 0, total__ = 0, steady__ = 0, n__, t__;\
+		size_t i__;\
+		int r__;\
+		for (i__ = 0; i__ < iterations; i__++) {\
+			n__ = ioctls();\
+			start__ = now();\
+			r__ = (__VA_ARGS__);\
+			t__ = now() - start__;\
+			if (r__) {\
+				libgamma_perror(NAME, r__);\
+				break;\
+			}\
+			n__ = ioctls() - n__;\
+			total__ += n__;\
+			if (i__ && n__ > steady__)\
+				steady__ = n__;\
+			latencies[i__] = t__;\
+			elapsed__ += t__;\
+			CLEANUP;\
+		}\
+		if (i__ == iterations)\
+			report(NAME, elapsed__, total__, steady__);\
+	} while (0)
+
+
+/**
+ * Benchmark the Linux DRM adjustment method,
+ * using the first CRTC on the first graphics card
+ *
+ * @return  0 on success, 1 on failure
+ */
+static int
+benchmark(void)
+{
+	struct libgamma_site_state site, other_site;
+	struct libgamma_partition_state partition, other_partition;
+	struct libgamma_crtc_state crtc, other_crtc;
+	struct libgamma_crtc_information info;
+	struct libgamma_gamma_ramps16 ramps;
+	struct libgamma_drm_card_data *card;
+	int r;
+
+	if ((r = libgamma_site_initialise(&site, LIBGAMMA_METHOD_LINUX_DRM, NULL))) {
+		libgamma_perror("libgamma_site_initialise", r);
+		return 1;
+	}
+	if ((r = libgamma_partition_initialise(&partition, &site, 0))) {
+		libgamma_perror("libgamma_partition_initialise", r);
+		libgamma_site_destroy(&site);
+		return 1;
+	}
+	if ((r = libgamma_crtc_initialise(&crtc, &partition, 0))) {
+		libgamma_perror("libgamma_crtc_initialise", r);
+		libgamma_partition_destroy(&partition);
+		libgamma_site_destroy(&site);
+		return 1;
+	}
+	card = partition.data;
+	atomic = !!card->gamma_lut_props[crtc.crtc];
+
+	BENCHMARK("site_initialise", libgamma_site_destroy(&other_site),
+	          libgamma_site_initialise(&other_site, LIBGAMMA_METHOD_LINUX_DRM, NULL));
+
+	BENCHMARK("partition_initialise", libgamma_partition_destroy(&other_partition),
+	          libgamma_partition_initialise(&other_partition, &site, 0));
+
+	BENCHMARK("crtc_initialise", libgamma_crtc_destroy(&other_crtc),
+	          libgamma_crtc_initialise(&other_crtc, &partition, 0));
+
+	/* Information that is not available is reported in the
+	 * structure, and is not a failure of the benchmark */
+	BENCHMARK("get_crtc_information", libgamma_crtc_information_destroy(&info),
+	          (libgamma_get_crtc_information(&info, sizeof(info), &crtc, (1ULL << LIBGAMMA_CRTC_INFO_COUNT) - 1), 0));
+
+	if ((r = libgamma_get_crtc_information(&info, sizeof(info), &crtc, LIBGAMMA_CRTC_INFO_GAMMA_SIZE))) {
+		r = info.gamma_size_error;
+		if (r > 0) {
+			errno = r;
+			r = LIBGAMMA_ERRNO_SET;
+		}
+		libgamma_perror("libgamma_get_crtc_information", r);
+	} else {
+		ramps.red_size   = info.  red_gamma_size;
+		ramps.green_size = info.green_gamma_size;
+		ramps.blue_size  = info. blue_gamma_size;
+		if (libgamma_gamma_ramps16_initialise(&ramps)) {
+			perror("libgamma_gamma_ramps16_initialise");
+		} else {
+			BENCHMARK("get_gamma_ramps16", (void)0, libgamma_crtc_get_gamma_ramps16(&crtc, &ramps));
+			/* Apply the gamma ramps that are already applied, so the display is not changed */
+			BENCHMARK("set_gamma_ramps16", (void)0, libgamma_crtc_set_gamma_ramps16(&crtc, &ramps));
+			libgamma_gamma_ramps16_destroy(&ramps);
+		}
+	}
+
+	libgamma_crtc_destroy(&crtc);
+	libgamma_partition_destroy(&partition);
+	libgamma_site_destroy(&site);
+	return 0;
+}
+
+
+/**
+ * Benchmark the Linux DRM adjustment method, the output is
+ * tab-separated with one line per operation, preceded by a
+ * header line
+ *
+ * If drm-simulator.so is loaded with LD_PRELOAD, the number
+ * of ioctls is reported, and the exit status is 2 if an
+ * operation makes more ioctls than expected
+ *
+ * @param   argc  The number of command line arguments
+ * @param   argv  Command line arguments, the only optional argument
+ *                is the number of times to run each operation
+ * @return        0 on success, 1 on failure, 2 if an ioctl budget is exceeded
+ */
+int
+main(int argc, char *argv[])
+{
+	int rc;
+
+	if (argc > 2 || (argc == 2 && (!isdigit(*argv[1]) || !atoll(argv[1])))) {
+		fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+		return 1;
+	}
+	if (argc == 2)
+		iterations = (size_t)atoll(argv[1]);
+
+	latencies = calloc(iterations, sizeof(*latencies));
+	if (!latencies) {
+		perror("calloc");
+		return 1;
+	}
+
+	*(void **)&simulator_ioctls = dlsym(RTLD_DEFAULT, "libgamma_drm_simulator_ioctls");
+
+	printf("mode\toperation\tcalls\tp50_ns\tp99_ns\tmean_ns\tcalls_per_second\tioctls_per_call\tsteady_ioctls\n");
+	rc = benchmark();
+
+	free(latencies);
+	if (fflush(stdout) || ferror(stdout)) {
+		perror("printf");
+		return 1;
+	}
+	return rc ? rc : over_budget ? 2 : 0;
+}
+
+
+#else
+
+
+int
+main(void)
+{
+	fprintf(stderr, "Linux DRM is not available\n");
+	return 1;
+}
+
+
+#endif
@@ -0,0 +1,404 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_DUMMY
+#include "common.h"
+
+
+#ifdef HAVE_LIBGAMMA_METHOD_DUMMY
+
+
+/**
+ * The gamma ramp types
+ *
+ * @param  X:macro  Macro that expands, with the parameters
+ *                  (ramps suffix, element type, maximum value,
+ *                  input type of the `libgamma_crtc_set_gamma_ramps*_f` functions)
+ */
+#define LIST_RAMPS(X)\
+	X(ramps8,  uint8_t,  UINT8_MAX,              float)\
+	X(ramps16, uint16_t, UINT16_MAX,             float)\
+	X(ramps32, uint32_t, UINT32_MAX,             float)\
+	X(ramps64, uint64_t, 18446744073709549568., float)\
+	X(rampsf,  float,    1,                      float)\
+	X(rampsd,  double,   1,                      double)
+
+
+/**
+ * The number of calls to `malloc`, `calloc`, and `realloc`
+ */
+static unsigned long long int allocations = 0;
+
+#ifdef __GLIBC__
+void *__libc_malloc(size_t);
+void *__libc_calloc(size_t, size_t);
+void *__libc_realloc(void *, size_t);
+
+/**
+ * Wrapper for `malloc` that counts the allocations
+ *
+ * @param   n  The number of bytes to allocate
+ * @return     The allocation
+ */
+void *
+malloc(size_t n)
+{
+	allocations += 1;
+	return __libc_malloc(n);
+}
+
+/**
+ * Wrapper for `calloc` that counts the allocations
+ *
+ * @param   n  The number of elements to allocate
+ * @param   m  The size of each element
+ * @return     The allocation
+ */
+void *
+calloc(size_t n, size_t m)
+{
+	allocations += 1;
+	return __libc_calloc(n, m);
+}
+
+/**
+ * Wrapper for `realloc` that counts the allocations
+ *
+ * @param   p  The allocation to resize
+ * @param   n  The new number of bytes
+ * @return     The new allocation
+ */
+void *
+realloc(void *p, size_t n)
+{
+	allocations += 1;
+	return __libc_realloc(p, n);
+}
+#endif
+
+
+/**
+ * The CRTC:s in the topology
+ */
+static struct libgamma_crtc_state *crtcs;
+
+/**
+ * The number of elements in `crtcs`
+ */
+static size_t crtc_count = 0;
+
+/**
+ * The number of times each operation is benchmarked
+ */
+static size_t iterations = 10000;
+
+/**
+ * Latency of each call in the current benchmark, in nanoseconds
+ */
+static unsigned long long int *latencies;
+
+
+/* Identity functions for `libgamma_crtc_set_gamma_ramps*_f` */
+#define X(RAMPS, TYPE, MAX, ARG)\
+	static TYPE\
+	identity_##RAMPS(ARG x)\
+	{\
+		return (TYPE)(x * MAX);\
+	}
+LIST_RAMPS(X)
+#undef X
+
+
+/**
+ * Get the time on the monotonic clock
+ *
+ * @return  The time, in nanoseconds
+ */
+static unsigned long long int
+now(void)
+{
+	struct timespec ts;
+	if (clock_gettime(CLOCK_MONOTONIC, &ts)) {
+		perror("clock_gettime");
+		exit(1);
+	}
+	return (unsigned long long int)ts.tv_sec * 1000000000ULL + (unsigned long long int)ts.tv_nsec;
+}
+
+
+/**
+ * Compare two latencies, for `qsort`
+ *
+ * @param   a  One of the latencies
+ * @param   b  The other latency
+ * @return     Negative if `a` is less than `b`, positive if `a`
+ *             is greater than `b`, zero if they are equal
+ */
+static int
+latency_cmp(const void *a, const void *b)
+{
+	unsigned long long int x = *(const unsigned long long int *)a;
+	unsigned long long int y = *(const unsigned long long int *)b;
+	return x < y ? -1 : x > y;
+}
+
+
+/**
+ * Print the result of a benchmark, the latencies in `latencies` are sorted
+ *
+ * @param  name     The name of the operation
+ * @param  elapsed  The total run time, in nanoseconds
+ * @param  allocs   The number of allocations made during the benchmark
+ */
+static void
+report(const char *name, unsigned long long int elapsed, unsigned long long int allocs)
+{
+	unsigned long long int total = 0;
+	size_t i;
+	qsort(latencies, iterations, sizeof(*latencies), latency_cmp);
+	for (i = 0; i < iterations; i++)
+		total += latencies[i];
+	printf("%s\t%zu\t%llu\t%llu\t%.1f\t%.0f\t", name, iterations,
+	       latencies[iterations / 2], latencies[iterations - 1 - iterations / 100],
+	       (double)total / (double)iterations, (double)iterations / ((double)elapsed / 1e9));
+#ifdef __GLIBC__
+	printf("%.2f\n", (double)allocs / (double)iterations);
+#else
+	(void) allocs;
+	printf("-\n");
+#endif
+}
+
+
+/**
+ * Benchmark an operation, calling it once per
+ * iteration, on the CRTC:s in turn
+ *
+ * @param  NAME  The name of the operation
+ * @param  ...   The operation, `crtc` is the CRTC state to use,
+ *               it shall evaluate to zero on success
+ */
+#define BENCHMARK(NAME, ...)\
+	do {\
+		unsigned long long int start__, end__, allocs__ = allocations, t__;\
+		struct libgamma_crtc_state *crtc;\
+		size_t i__;\
+		int r__;\
+		start__ = now();\
+		for (i__ = 0; i__ < iterations; i__++) {\
+			crtc = &crtcs[i__ % crtc_count];\
+			t__ = now();\
+			r__ = (__VA_ARGS__);\
+			latencies[i__] = now() - t__;\
+			if (r__) {\
+				libgamma_perror(NAME, r__);\
+				return 1;\
+			}\
+		}\
+		end__ = now();\
+		report(NAME, end__ - start__, allocations - allocs__);\
+	} while (0)
+
+
+/**
+ * Print usage information and exit
+ *
+ * @param  argv0  The name of the program
+ */
+static void
+usage(const char *argv0)
+{
+	fprintf(stderr, "usage: %s [-s sites] [-p partitions] [-c crtcs] [-r red-size] [-g green-size] "
+	                "[-b blue-size] [-d 8|16|32|64|-1|-2] [-n iterations]\n", argv0);
+	exit(1);
+}
+
+
+/**
+ * Parse a numerical command line argument
+ *
+ * @param   arg    The argument
+ * @param   argv0  The name of the program
+ * @return         The value of the argument
+ */
+static size_t
+parse_size(const char *arg, const char *argv0)
+{
+	char *end;
+	unsigned long long int value;
+	if (!isdigit(*arg))
+		usage(argv0);
+	errno = 0;
+	value = strtoull(arg, &end, 10);
+	if (errno || *end || !value || value > SIZE_MAX)
+		usage(argv0);
+	return (size_t)value;
+}
+
+
+/**
+ * Benchmark the public API on the dummy adjustment method,
+ * the output is tab-separated with one line per operation,
+ * preceded by a header line
+ *
+ * @param   argc  The number of command line arguments
+ * @param   argv  Command line arguments
+ * @return        0 on success, 1 on failure
+ */
+int
+main(int argc, char *argv[])
+{
+	struct libgamma_dummy_configurations *config = &libgamma_dummy_internal_configurations;
+	struct libgamma_site_state *sites;
+	struct libgamma_partition_state *partitions;
+	struct libgamma_crtc_information info;
+	size_t site_count = 1, partition_count = 1, crtc_count_per_partition = 4;
+	size_t red_size = 1024, green_size = 1024, blue_size = 1024;
+	size_t s, p, c;
+	char site_name[3 * sizeof(size_t) + 1], *site;
+	signed depth = 16;
+	int opt, r;
+#define X(RAMPS, TYPE, MAX, ARG)\
+	struct libgamma_gamma_##RAMPS RAMPS;
+	LIST_RAMPS(X)
+#undef X
+
+	while ((opt = getopt(argc, argv, "s:p:c:r:g:b:d:n:")) != -1) {
+		switch (opt) {
+		case 's':  site_count               = parse_size(optarg, argv[0]); break;
+		case 'p':  partition_count          = parse_size(optarg, argv[0]); break;
+		case 'c':  crtc_count_per_partition = parse_size(optarg, argv[0]); break;
+		case 'r':  red_size                 = parse_size(optarg, argv[0]); break;
+		case 'g':  green_size               = parse_size(optarg, argv[0]); break;
+		case 'b':  blue_size                = parse_size(optarg, argv[0]); break;
+		case 'n':  iterations               = parse_size(optarg, argv[0]); break;
+		case 'd':
+			depth = (signed)atoi(optarg);
+			if (depth != 8 && depth != 16 && depth != 32 && depth != 64 && depth != -1 && depth != -2)
+				usage(argv[0]);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (optind != argc)
+		usage(argv[0]);
+
+	/* Configure the topology */
+	config->real_method = LIBGAMMA_METHOD_DUMMY;
+	config->site_count = site_count;
+	config->default_partition_count = partition_count;
+	config->default_crtc_count = crtc_count_per_partition;
+	config->inherit_sites = 0;
+	config->inherit_partition_count = 0;
+	config->inherit_crtc_count = 0;
+	config->stalled_start = 0;
+	config->capabilities.multiple_sites = 1;
+	config->capabilities.multiple_partitions = 1;
+	config->capabilities.multiple_crtcs = 1;
+	config->crtc_info_template.red_gamma_size = red_size;
+	config->crtc_info_template.green_gamma_size = green_size;
+	config->crtc_info_template.blue_gamma_size = blue_size;
+	config->crtc_info_template.gamma_depth = depth;
+
+	/* Build the topology */
+	sites = calloc(site_count, sizeof(*sites));
+	partitions = calloc(site_count * partition_count, sizeof(*partitions));
+	crtcs = calloc(site_count * partition_count * crtc_count_per_partition, sizeof(*crtcs));
+	latencies = calloc(iterations, sizeof(*latencies));
+	if (!sites || !partitions || !crtcs || !latencies) {
+		perror("calloc");
+		return 1;
+	}
+	for (s = 0; s < site_count; s++) {
+		sprintf(site_name, "%zu", s);
+		site = strdup(site_name);
+		if (!site) {
+			perror("strdup");
+			return 1;
+		}
+		if ((r = libgamma_site_initialise(&sites[s], LIBGAMMA_METHOD_DUMMY, site))) {
+			libgamma_perror("libgamma_site_initialise", r);
+			return 1;
+		}
+		for (p = 0; p < partition_count; p++) {
+			if ((r = libgamma_partition_initialise(&partitions[s * partition_count + p], &sites[s], p))) {
+				libgamma_perror("libgamma_partition_initialise", r);
+				return 1;
+			}
+			for (c = 0; c < crtc_count_per_partition; c++) {
+				if ((r = libgamma_crtc_initialise(&crtcs[crtc_count++], &partitions[s * partition_count + p], c))) {
+					libgamma_perror("libgamma_crtc_initialise", r);
+					return 1;
+				}
+			}
+		}
+	}
+
+	/* Allocate gamma ramps, and fill them with a linear curve */
+#define X(RAMPS, TYPE, MAX, ARG)\
+	RAMPS.red_size = red_size;\
+	RAMPS.green_size = green_size;\
+	RAMPS.blue_size = blue_size;\
+	if (libgamma_gamma_##RAMPS##_initialise(&RAMPS)) {\
+		perror("libgamma_gamma_"#RAMPS"_initialise");\
+		return 1;\
+	}\
+	for (c = 0; c < red_size; c++)\
+		RAMPS.red[c] = identity_##RAMPS((ARG)c / (ARG)(red_size > 1 ? red_size - 1 : 1));\
+	for (c = 0; c < green_size; c++)\
+		RAMPS.green[c] = identity_##RAMPS((ARG)c / (ARG)(green_size > 1 ? green_size - 1 : 1));\
+	for (c = 0; c < blue_size; c++)\
+		RAMPS.blue[c] = identity_##RAMPS((ARG)c / (ARG)(blue_size > 1 ? blue_size - 1 : 1));
+	LIST_RAMPS(X)
+#undef X
+
+	printf("operation\tcalls\tp50_ns\tp99_ns\tmean_ns\tcalls_per_second\tallocations_per_call\n");
+
+#define X(RAMPS, TYPE, MAX, ARG)\
+	BENCHMARK("set_gamma_"#RAMPS, libgamma_crtc_set_gamma_##RAMPS(crtc, &RAMPS));\
+	BENCHMARK("get_gamma_"#RAMPS, libgamma_crtc_get_gamma_##RAMPS(crtc, &RAMPS));\
+	BENCHMARK("set_gamma_"#RAMPS"_f",\
+	          libgamma_crtc_set_gamma_##RAMPS##_f(crtc, identity_##RAMPS, identity_##RAMPS, identity_##RAMPS));
+	LIST_RAMPS(X)
+#undef X
+
+	BENCHMARK("get_crtc_information",
+	          (libgamma_get_crtc_information(&info, sizeof(info), crtc, (1ULL << LIBGAMMA_CRTC_INFO_COUNT) - 1),
+	           libgamma_crtc_information_destroy(&info), 0));
+
+	BENCHMARK("crtc_restore", libgamma_crtc_restore(crtc));
+
+	for (c = 0; c < crtc_count; c++)
+		libgamma_crtc_destroy(&crtcs[c]);
+	for (p = 0; p < site_count * partition_count; p++)
+		libgamma_partition_destroy(&partitions[p]);
+	for (s = 0; s < site_count; s++)
+		libgamma_site_destroy(&sites[s]);
+#define X(RAMPS, TYPE, MAX, ARG)\
+	libgamma_gamma_##RAMPS##_destroy(&RAMPS);
+	LIST_RAMPS(X)
+#undef X
+	free(crtcs);
+	free(partitions);
+	free(sites);
+	free(latencies);
+
+	if (fflush(stdout) || ferror(stdout)) {
+		perror("printf");
+		return 1;
+	}
+	return 0;
+}
+
+
+#else
+
+
+int
+main(void)
+{
+	fprintf(stderr, "the dummy adjustment method is not available\n");
+	return 1;
+}
+
+
+#endif
@@ -0,0 +1,287 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Just an arbitrary version
+ */
+#define ANY bits64
+
+
+/**
+ * The depths of gamma ramps, `-1` for `float`, `-2` for `double`
+ */
+static const signed depths[] = {8, 16, 32, 64, -1, -2};
+
+/**
+ * The sizes of the gamma ramps (per channel) to benchmark
+ */
+static const size_t sizes[] = {256, 1024, 4096, 16384, 65536};
+
+/**
+ * The minimum number of nanoseconds to run each benchmark
+ */
+static unsigned long long int min_time = 100000000ULL;
+
+/**
+ * Gamma ramps, in the depth of the adjustment method, that
+ * `get_ramps` copies to the gamma ramps it is given
+ */
+static union gamma_ramps_any system_ramps;
+
+/**
+ * The depth of `system_ramps`
+ */
+static signed system_depth;
+
+
+/**
+ * Get the name of a depth, as used in the output
+ *
+ * @param   depth  The depth, `-1` for `float`, `-2` for `double`
+ * @return         The name of the depth
+ */
+static const char *
+depth_name(signed depth)
+{
+	switch (depth) {
+	case  8:  return "8";
+	case 16:  return "16";
+	case 32:  return "32";
+	case 64:  return "64";
+	case -1:  return "f";
+	default:  return "d";
+	}
+}
+
+
+/**
+ * Get the time on the monotonic clock
+ *
+ * @return  The time, in nanoseconds
+ */
+static unsigned long long int
+now(void)
+{
+	struct timespec ts;
+	if (clock_gettime(CLOCK_MONOTONIC, &ts)) {
+		perror("clock_gettime");
+		exit(1);
+	}
+	return (unsigned long long int)ts.tv_sec * 1000000000ULL + (unsigned long long int)ts.tv_nsec;
+}
+
+
+/**
+ * Allocate gamma ramps, and fill them with a linear curve
+ *
+ * @param  ramps  Output parameter for the gamma ramps
+ * @param  depth  The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @param  size   The size of each gamma ramp
+ */
+static void
+allocate_ramps(union gamma_ramps_any *restrict ramps, signed depth, size_t size)
+{
+	size_t i, n = 3 * size;
+	double x;
+	char *buf = malloc(n * libgamma_internal_stop_size(depth));
+	if (!buf) {
+		perror("malloc");
+		exit(1);
+	}
+	ramps->ANY.red_size = ramps->ANY.green_size = ramps->ANY.blue_size = size;
+	ramps->ANY.red   = (void *)buf;
+	ramps->ANY.green = (void *)&buf[1 * size * libgamma_internal_stop_size(depth)];
+	ramps->ANY.blue  = (void *)&buf[2 * size * libgamma_internal_stop_size(depth)];
+	for (i = 0; i < n; i++) {
+		x = (double)(i % size) / (double)(size - 1);
+		switch (depth) {
+		case  8:  ((uint8_t  *)buf)[i] = (uint8_t)(x * UINT8_MAX);   break;
+		case 16:  ((uint16_t *)buf)[i] = (uint16_t)(x * UINT16_MAX); break;
+		case 32:  ((uint32_t *)buf)[i] = (uint32_t)(x * UINT32_MAX); break;
+		case 64:  ((uint64_t *)buf)[i] = (uint64_t)(x * 18446744073709549568.); break;
+		case -1:  ((float    *)buf)[i] = (float)x; break;
+		default:  ((double   *)buf)[i] = x;        break;
+		}
+	}
+}
+
+
+/**
+ * Stand-in for an adjustment method's function
+ * for applying gamma ramps, it does nothing
+ *
+ * @param   this   Ignored
+ * @param   ramps  Ignored
+ * @return         Zero
+ */
+static int
+set_ramps(struct libgamma_crtc_state *restrict this, const union gamma_ramps_any *restrict ramps)
+{
+	(void) this;
+	(void) ramps;
+	return 0;
+}
+
+
+/**
+ * Stand-in for an adjustment method's function for reading
+ * gamma ramps, it copies `system_ramps` to the gamma ramps
+ *
+ * @param   this   Ignored
+ * @param   ramps  Output parameter for the gamma ramps
+ * @return         Zero
+ */
+static int
+get_ramps(struct libgamma_crtc_state *restrict this, union gamma_ramps_any *restrict ramps)
+{
+	size_t n = libgamma_internal_stop_size(system_depth);
+	(void) this;
+	memcpy(ramps->ANY.red,   system_ramps.ANY.red,   ramps->ANY.red_size   * n);
+	memcpy(ramps->ANY.green, system_ramps.ANY.green, ramps->ANY.green_size * n);
+	memcpy(ramps->ANY.blue,  system_ramps.ANY.blue,  ramps->ANY.blue_size  * n);
+	return 0;
+}
+
+
+/**
+ * Print the result of a benchmark
+ *
+ * @param  name        The name of the benchmark
+ * @param  depth_out   The depth of the output, `-1` for `float`, `-2` for `double`
+ * @param  depth_in    The depth of the input, `-1` for `float`, `-2` for `double`
+ * @param  size        The size of each gamma ramp
+ * @param  iterations  The number of times the benchmarked operation was run
+ * @param  elapsed     The total run time, in nanoseconds
+ */
+static void
+report(const char *name, signed depth_out, signed depth_in, size_t size,
+       unsigned long long int iterations, unsigned long long int elapsed)
+{
+	double stops = (double)iterations * 3. * (double)size;
+	double bytes = stops * (double)(libgamma_internal_stop_size(depth_in) + libgamma_internal_stop_size(depth_out));
+	printf("%s\t%s\t%s\t%zu\t%llu\t%.4f\t%.0f\n", name, depth_name(depth_out), depth_name(depth_in),
+	       size, iterations, (double)elapsed / stops, bytes / ((double)elapsed / 1e9));
+}
+
+
+/**
+ * Run a benchmark for at least `min_time` nanoseconds
+ *
+ * @param  NAME       The name of the benchmark
+ * @param  DEPTH_OUT  The depth of the output, `-1` for `float`, `-2` for `double`
+ * @param  DEPTH_IN   The depth of the input, `-1` for `float`, `-2` for `double`
+ * @param  SIZE       The size of each gamma ramp
+ * @param  ...        The benchmarked statement
+ */
+#define BENCHMARK(NAME, DEPTH_OUT, DEPTH_IN, SIZE, ...)\
+	do {\
+		unsigned long long int iterations__ = 0, start__ = now(), elapsed__;\
+		do {\
+			__VA_ARGS__;\
+			iterations__ += 1;\
+		} while ((elapsed__ = now() - start__) < min_time);\
+		report(NAME, DEPTH_OUT, DEPTH_IN, SIZE, iterations__, elapsed__);\
+	} while (0)
+
+
+/**
+ * Benchmark gamma ramp translation, the output is tab-separated
+ * with one line per benchmark, preceded by a header line
+ *
+ * @param   argc  The number of command line arguments
+ * @param   argv  Command line arguments, the only optional argument is
+ *                the minimum number of milliseconds to run each benchmark
+ * @return        0 on success, 1 on failure
+ */
+int
+main(int argc, char *argv[])
+{
+	struct libgamma_site_state site;
+	struct libgamma_partition_state partition;
+	struct libgamma_crtc_state crtc;
+	union gamma_ramps_any in, out;
+	uint64_t *ramps64;
+	size_t s, i, j, size;
+	signed depth_in, depth_out;
+	translate_fun *translate;
+	int r;
+
+	if (argc > 2 || (argc == 2 && !isdigit(*argv[1]))) {
+		fprintf(stderr, "usage: %s [minimum-milliseconds-per-benchmark]\n", argv[0]);
+		return 1;
+	}
+	if (argc == 2)
+		min_time = strtoull(argv[1], NULL, 10) * 1000000ULL;
+
+	memset(&site, 0, sizeof(site));
+	memset(&partition, 0, sizeof(partition));
+	memset(&crtc, 0, sizeof(crtc));
+	site.method = LIBGAMMA_METHOD_DUMMY;
+	partition.site = &site;
+	crtc.partition = &partition;
+
+	printf("benchmark\tdepth_out\tdepth_in\tramp_size\titerations\tns_per_stop\tbytes_per_second\n");
+
+	for (s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+		size = sizes[s];
+
+		ramps64 = malloc(3 * size * sizeof(*ramps64));
+		if (!ramps64) {
+			perror("malloc");
+			return 1;
+		}
+
+		for (i = 0; i < sizeof(depths) / sizeof(*depths); i++) {
+			depth_in = depths[i];
+			allocate_ramps(&in, depth_in, size);
+			BENCHMARK("to_64", 64, depth_in, size,
+			          libgamma_internal_translate_to_64(depth_in, 3 * size, ramps64, &in));
+			BENCHMARK("from_64", depth_in, 64, size,
+			          libgamma_internal_translate_from_64(depth_in, 3 * size, &in, ramps64));
+			free(in.ANY.red);
+		}
+
+		for (i = 0; i < sizeof(depths) / sizeof(*depths); i++) {
+			depth_in = depths[i];
+			allocate_ramps(&in, depth_in, size);
+			for (j = 0; j < sizeof(depths) / sizeof(*depths); j++) {
+				depth_out = depths[j];
+				allocate_ramps(&out, depth_out, size);
+
+				translate = libgamma_internal_scalar_translator(depth_out, depth_in);
+				BENCHMARK("scalar", depth_out, depth_in, size, translate(3 * size, out.ANY.red, in.ANY.red));
+
+				translate = libgamma_internal_translator(depth_out, depth_in);
+				BENCHMARK("translate", depth_out, depth_in, size, translate(3 * size, out.ANY.red, in.ANY.red));
+
+				/* The user's gamma ramps are `in`, and the adjustment method's are `depth_out` */
+				BENCHMARK("set", depth_out, depth_in, size,
+				          if ((r = libgamma_internal_translated_ramp_set(&crtc, &in, depth_in, depth_out, set_ramps))) {
+				                  libgamma_perror("libgamma_internal_translated_ramp_set", r);
+				                  return 1;
+				          });
+
+				/* The user's gamma ramps are `in`, and the adjustment method's are `out` */
+				system_ramps = out;
+				system_depth = depth_out;
+				BENCHMARK("get", depth_in, depth_out, size,
+				          if ((r = libgamma_internal_translated_ramp_get(&crtc, &in, depth_in, depth_out, get_ramps))) {
+				                  libgamma_perror("libgamma_internal_translated_ramp_get", r);
+				                  return 1;
+				          });
+
+				free(out.ANY.red);
+			}
+			free(in.ANY.red);
+		}
+
+		free(ramps64);
+	}
+
+	if (fflush(stdout) || ferror(stdout)) {
+		perror("printf");
+		return 1;
+	}
+	return 0;
+}
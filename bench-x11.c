@@ -0,0 +1,295 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#define IN_LIBGAMMA_X_VIDMODE
+#include "common.h"
+
+
+#if defined(HAVE_LIBGAMMA_METHOD_X_RANDR) || defined(HAVE_LIBGAMMA_METHOD_X_VIDMODE)
+
+
+/**
+ * The number of times each operation is benchmarked
+ */
+static size_t iterations = 1000;
+
+/**
+ * Latency of each call in the current benchmark, in nanoseconds
+ */
+static unsigned long long int *latencies;
+
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+/**
+ * The number of requests `sequence` has sent
+ * to count the requests sent by the library
+ */
+static unsigned long long int probes = 0;
+#endif
+
+
+/**
+ * Get the time on the monotonic clock
+ *
+ * @return  The time, in nanoseconds
+ */
+static unsigned long long int
+now(void)
+{
+	struct timespec ts;
+	if (clock_gettime(CLOCK_MONOTONIC, &ts)) {
+		perror("clock_gettime");
+		exit(1);
+	}
+	return (unsigned long long int)ts.tv_sec * 1000000000ULL + (unsigned long long int)ts.tv_nsec;
+}
+
+
+/**
+ * Get the number of requests that have been sent
+ * over a site's connection to the display server
+ *
+ * @param   site  The site state
+ * @return        The number of requests, not counting the
+ *                requests sent by this function
+ */
+static unsigned long long int
+sequence(struct libgamma_site_state *restrict site)
+{
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	struct libgamma_x_randr_site_data *randr;
+	xcb_get_input_focus_cookie_t cookie;
+#endif
+
+	switch (site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	case LIBGAMMA_METHOD_X_RANDR:
+		/* XCB does not tell the sequence number of the last
+		 * request, so send a request without waiting for it */
+		randr = site->data;
+		cookie = xcb_get_input_focus(randr->connection);
+		xcb_discard_reply(randr->connection, cookie.sequence);
+		return (unsigned long long int)cookie.sequence - ++probes;
+#endif
+#ifdef HAVE_LIBGAMMA_METHOD_X_VIDMODE
+	case LIBGAMMA_METHOD_X_VIDMODE:
+		return (unsigned long long int)NextRequest((Display *)site->data) - 1;
+#endif
+	default:
+		return 0;
+	}
+}
+
+
+/**
+ * Compare two latencies, for `qsort`
+ *
+ * @param   a  One of the latencies
+ * @param   b  The other latency
+ * @return     Negative if `a` is less than `b`, positive if `a`
+ *             is greater than `b`, zero if they are equal
+ */
+static int
+latency_cmp(const void *a, const void *b)
+{
+	unsigned long long int x = *(const unsigned long long int *)a;
+	unsigned long long int y = *(const unsigned long long int *)b;
+	return x < y ? -1 : x > y;
+}
+
+
+/**
+ * Print the result of a benchmark, the latencies in `latencies` are sorted
+ *
+ * @param  method    The adjustment method
+ * @param  name      The name of the operation
+ * @param  elapsed   The total run time, in nanoseconds
+ * @param  requests  The number of requests sent to the display server
+ *                   during the benchmark, `ULLONG_MAX` if not known
+ */
+static void
+report(int method, const char *name, unsigned long long int elapsed, unsigned long long int requests)
+{
+	unsigned long long int total = 0;
+	size_t i;
+	qsort(latencies, iterations, sizeof(*latencies), latency_cmp);
+	for (i = 0; i < iterations; i++)
+		total += latencies[i];
+	printf("%s\t%s\t%zu\t%llu\t%llu\t%.1f\t%.0f\t", libgamma_name_of_method(method), name, iterations,
+	       latencies[iterations / 2], latencies[iterations - 1 - iterations / 100],
+	       (double)total / (double)iterations, (double)iterations / ((double)elapsed / 1e9));
+	if (requests == ULLONG_MAX)
+		printf("-\n");
+	else
+		printf("%.2f\n", (double)requests / (double)iterations);
+}
+
+
+/**
+ * Benchmark an operation, calling it once per iteration
+ *
+ * If the operation fails, the error is printed to
+ * standard error and the benchmark is abandoned
+ *
+ * @param  SITE     Pointer to the site state, `NULL` if requests cannot be counted
+ * @param  NAME     The name of the operation
+ * @param  CLEANUP  Statement to run, untimed, after each successful call
+ * @param  ...      The operation, it shall evaluate to zero on success
+ */
+#define BENCHMARK(SITE, NAME, CLEANUP, ...)\
+	do {\
+		unsigned long long int start__, elapsed__ = 0, requests__ = 0, seq__ = 0, t__;\
+		size_t i__;\
+		int r__;\
+		for (i__ = 0; i__ < iterations; i__++) {\
+			if (SITE)\
+				seq__ = sequence(SITE);\
+			start__ = now();\
+			r__ = (__VA_ARGS__);\
+			t__ = now() - start__;\
+			if (r__) {\
+				libgamma_perror(NAME, r__);\
+				break;\
+			}\
+			if (SITE)\
+				requests__ += sequence(SITE) - seq__;\
+			latencies[i__] = t__;\
+			elapsed__ += t__;\
+			CLEANUP;\
+		}\
+		if (i__ == iterations)\
+			report(method, NAME, elapsed__, (SITE) ? requests__ : ULLONG_MAX);\
+	} while (0)
+
+
+/**
+ * Benchmark an adjustment method on the display server
+ * in `$DISPLAY`, using the first CRTC on the first screen
+ *
+ * @param   method  The adjustment method
+ * @return          0 on success, 1 on failure
+ */
+static int
+benchmark_method(int method)
+{
+	struct libgamma_site_state site, other_site;
+	struct libgamma_partition_state partition, other_partition;
+	struct libgamma_crtc_state crtc, other_crtc;
+	struct libgamma_crtc_information info;
+	struct libgamma_gamma_ramps16 ramps;
+	struct libgamma_site_state *counted = &site, *uncounted = NULL;
+	int r;
+
+	if ((r = libgamma_site_initialise(&site, method, NULL))) {
+		libgamma_perror("libgamma_site_initialise", r);
+		return 1;
+	}
+	if ((r = libgamma_partition_initialise(&partition, &site, 0))) {
+		libgamma_perror("libgamma_partition_initialise", r);
+		libgamma_site_destroy(&site);
+		return 1;
+	}
+	if ((r = libgamma_crtc_initialise(&crtc, &partition, 0))) {
+		libgamma_perror("libgamma_crtc_initialise", r);
+		libgamma_partition_destroy(&partition);
+		libgamma_site_destroy(&site);
+		return 1;
+	}
+
+	BENCHMARK(uncounted, "site_initialise", libgamma_site_destroy(&other_site),
+	          libgamma_site_initialise(&other_site, method, NULL));
+
+	BENCHMARK(counted, "partition_initialise", libgamma_partition_destroy(&other_partition),
+	          libgamma_partition_initialise(&other_partition, &site, 0));
+
+	BENCHMARK(counted, "crtc_initialise", libgamma_crtc_destroy(&other_crtc),
+	          libgamma_crtc_initialise(&other_crtc, &partition, 0));
+
+	/* Information that is not available is reported in the
+	 * structure, and is not a failure of the benchmark */
+	BENCHMARK(counted, "get_crtc_information", libgamma_crtc_information_destroy(&info),
+	          (libgamma_get_crtc_information(&info, sizeof(info), &crtc, (1ULL << LIBGAMMA_CRTC_INFO_COUNT) - 1), 0));
+
+	if ((r = libgamma_get_crtc_information(&info, sizeof(info), &crtc, LIBGAMMA_CRTC_INFO_GAMMA_SIZE))) {
+		r = info.gamma_size_error;
+		if (r > 0) {
+			errno = r;
+			r = LIBGAMMA_ERRNO_SET;
+		}
+		libgamma_perror("libgamma_get_crtc_information", r);
+	} else {
+		ramps.red_size   = info.  red_gamma_size;
+		ramps.green_size = info.green_gamma_size;
+		ramps.blue_size  = info. blue_gamma_size;
+		if (libgamma_gamma_ramps16_initialise(&ramps)) {
+			perror("libgamma_gamma_ramps16_initialise");
+		} else {
+			BENCHMARK(counted, "get_gamma_ramps16", (void)0, libgamma_crtc_get_gamma_ramps16(&crtc, &ramps));
+			/* Apply the gamma ramps that are already applied, so the display is not changed */
+			BENCHMARK(counted, "set_gamma_ramps16", (void)0, libgamma_crtc_set_gamma_ramps16(&crtc, &ramps));
+			libgamma_gamma_ramps16_destroy(&ramps);
+		}
+	}
+
+	libgamma_crtc_destroy(&crtc);
+	libgamma_partition_destroy(&partition);
+	libgamma_site_destroy(&site);
+	return 0;
+}
+
+
+/**
+ * Benchmark the X adjustment methods on the display server in `$DISPLAY`,
+ * the output is tab-separated with one line per adjustment method
+ * and operation, preceded by a header line
+ *
+ * @param   argc  The number of command line arguments
+ * @param   argv  Command line arguments, the only optional argument
+ *                is the number of times to run each operation
+ * @return        0 on success, 1 on failure
+ */
+int
+main(int argc, char *argv[])
+{
+	int rc = 0;
+
+	if (argc > 2 || (argc == 2 && (!isdigit(*argv[1]) || !atoll(argv[1])))) {
+		fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+		return 1;
+	}
+	if (argc == 2)
+		iterations = (size_t)atoll(argv[1]);
+
+	latencies = calloc(iterations, sizeof(*latencies));
+	if (!latencies) {
+		perror("calloc");
+		return 1;
+	}
+
+	printf("method\toperation\tcalls\tp50_ns\tp99_ns\tmean_ns\tcalls_per_second\trequests_per_call\n");
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	rc |= benchmark_method(LIBGAMMA_METHOD_X_RANDR);
+#endif
+#ifdef HAVE_LIBGAMMA_METHOD_X_VIDMODE
+	rc |= benchmark_method(LIBGAMMA_METHOD_X_VIDMODE);
+#endif
+
+	free(latencies);
+	if (fflush(stdout) || ferror(stdout)) {
+		perror("printf");
+		return 1;
+	}
+	return rc;
+}
+
+
+#else
+
+
+int
+main(void)
+{
+	fprintf(stderr, "neither X RandR nor X VidMode is available\n");
+	return 1;
+}
+
+
+#endif
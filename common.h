@@ -9,11 +9,14 @@
 #include <grp.h>
 #include <inttypes.h>
 #include <limits.h>
+#include <math.h>
+#include <stdatomic.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "config.h"
@@ -25,6 +28,8 @@
 
 
 #ifdef __linux__
+# include <sys/eventfd.h>
+# include <sys/timerfd.h>
 # ifndef O_CLOEXEC
 #  define O_CLOEXEC 02000000
 # endif
@@ -256,6 +261,16 @@ typedef int get_ramps_any_fun(struct libgamma_crtc_state *restrict, union gamma_
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
 typedef int set_ramps_any_fun(struct libgamma_crtc_state *restrict, const union gamma_ramps_any *restrict);
 
+/**
+ * A function for translating a gamma ramp from one depth to another
+ *
+ * @param  n    The number of stops in the gamma ramp
+ * @param  out  Output array of stops
+ * @param  in   Input array of stops
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+typedef void translate_fun(size_t, void *restrict, const void *restrict);
+
 
 
 /**
@@ -354,6 +369,336 @@ void libgamma_internal_translate_to_64(signed, size_t, uint64_t *restrict, const
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
 void libgamma_internal_translate_from_64(signed, size_t, union gamma_ramps_any *restrict, const uint64_t *restrict);
 
+/**
+ * Get the function that translates a gamma ramp
+ * directly from one depth to another
+ *
+ * @param   depth_out  The depth of the output gamma ramp, `-1` for `float`, `-2` for `double`
+ * @param   depth_in   The depth of the input gamma ramp, `-1` for `float`, `-2` for `double`
+ * @return             Function that translates `n` stops from `in` to `out`
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__returns_nonnull__, __warn_unused_result__)))
+translate_fun *libgamma_internal_translator(signed, signed);
+
+/**
+ * Get the function that translates a gamma ramp
+ * directly from one depth to another, without
+ * using any SIMD instructions
+ *
+ * @param   depth_out  The depth of the output gamma ramp, `-1` for `float`, `-2` for `double`
+ * @param   depth_in   The depth of the input gamma ramp, `-1` for `float`, `-2` for `double`
+ * @return             Function that translates `n` stops from `in` to `out`
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__const__, __returns_nonnull__, __warn_unused_result__)))
+translate_fun *libgamma_internal_scalar_translator(signed, signed);
+
+/**
+ * Get the function that translates a gamma ramp directly
+ * from one depth to another using SIMD instructions
+ *
+ * @param   depth_out  The depth of the output gamma ramp, `-1` for `float`, `-2` for `double`
+ * @param   depth_in   The depth of the input gamma ramp, `-1` for `float`, `-2` for `double`
+ * @param   set        The index of the kernel set to use, less than
+ *                     `libgamma_internal_simd_kernel_sets`, lower
+ *                     values are preferred
+ * @return             Function that translates `n` stops from `in` to `out`,
+ *                     `NULL` if the kernel set is not supported by the CPU
+ *                     or does not have a translator for the pair of depths
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__warn_unused_result__)))
+translate_fun *libgamma_internal_simd_translator(signed, signed, size_t);
+
+/**
+ * The number of SIMD kernel sets compiled into the library
+ */
+extern const size_t libgamma_internal_simd_kernel_sets;
+
+/**
+ * Make sure the sizes of a CRTC's gamma ramps are cached in
+ * its state, the cache is refreshed if the configuration of
+ * the partition has changed since the sizes were cached
+ * 
+ * @param   this  The CRTC state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_internal_cache_gamma_sizes(struct libgamma_crtc_state *restrict);
+
+/**
+ * Add a request submitted with `libgamma_crtc_get_gamma_ramps16_async`
+ * or `libgamma_crtc_set_gamma_ramps16_async` to the end of its site's
+ * queue of requests, and signal the site's request file descriptor
+ * if the request has already completed
+ * 
+ * @param  request  The request
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_internal_queue_request(struct libgamma_crtc_request *restrict);
+
+/**
+ * Check whether writing gamma ramps to a CRTC can be
+ * skipped because `this->deduplicate_writes` is set and
+ * the gamma ramps are identical to the gamma ramps that
+ * were last applied to the CRTC
+ * 
+ * @param   this         The CRTC state
+ * @param   ramps        The gamma ramps that are about to be applied
+ * @param   depth        The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @param   fingerprint  Output parameter for the fingerprint of `ramps`, to be passed
+ *                       to `libgamma_internal_record_write`
+ * @return               1 if the write can be skipped, 0 otherwise
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_internal_write_is_redundant(struct libgamma_crtc_state *restrict, const union gamma_ramps_any *restrict,
+                                         signed, uint64_t *restrict);
+
+/**
+ * Remember which gamma ramps were applied to a CRTC, so that
+ * `libgamma_internal_write_is_redundant` can recognise them
+ * 
+ * @param  this         The CRTC state
+ * @param  depth        The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @param  fingerprint  The fingerprint `libgamma_internal_write_is_redundant` output
+ * @param  result       The return value of the function that applied the gamma ramps,
+ *                      if non-zero, the state of the CRTC is forgotten
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_internal_record_write(struct libgamma_crtc_state *restrict, signed, uint64_t, int);
+
+/**
+ * Get the gamma ramps of a CRTC from the cache in
+ * its state, if `this->cache_reads` is set and the
+ * cache holds gamma ramps of the requested depth
+ * and sizes that have not expired
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to fill in
+ * @param   depth  The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @return         1 if the gamma ramps were read from the cache, 0 otherwise
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_internal_read_cached_ramps(struct libgamma_crtc_state *restrict, union gamma_ramps_any *restrict, signed);
+
+/**
+ * Store gamma ramps that were applied to, or read from,
+ * a CRTC in the cache in its state, if `this->cache_reads`
+ * is set; if the gamma ramps cannot be stored, the cache
+ * is emptied
+ * 
+ * @param  this   The CRTC state
+ * @param  ramps  The gamma ramps
+ * @param  depth  The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_internal_cache_ramps(struct libgamma_crtc_state *restrict, const union gamma_ramps_any *restrict, signed);
+
+/**
+ * Get the time on a clock that cannot be set
+ * 
+ * @return  The time, in milliseconds, from an arbitrary point in
+ *          time, or 0 if the clock is not available
+ */
+unsigned long long int libgamma_internal_monotonic_time(void);
+
+/**
+ * The number of sets of statistics counters, each thread
+ * is assigned one of them, they are shared by threads
+ * only if there are more threads than sets
+ */
+#define LIBGAMMA_INTERNAL_STATS_SHARDS 16
+
+/**
+ * Counters in `struct libgamma_method_stats`
+ * that are not specific to an operation
+ */
+enum libgamma_internal_stats_counter {
+	/**
+	 * `translated_bytes`
+	 */
+	LIBGAMMA_INTERNAL_STATS_TRANSLATED_BYTES,
+
+	/**
+	 * `allocations`
+	 */
+	LIBGAMMA_INTERNAL_STATS_ALLOCATIONS,
+
+	/**
+	 * `ignored_errors`
+	 */
+	LIBGAMMA_INTERNAL_STATS_IGNORED_ERRORS,
+
+	/**
+	 * The number of counters
+	 */
+	LIBGAMMA_INTERNAL_STATS_COUNTER_COUNT
+};
+
+/**
+ * A set of statistics counters, with the same layout
+ * as `struct libgamma_stats` except that each counter
+ * is atomic and the counters that are not specific
+ * to an operation are stored in an array
+ */
+struct libgamma_internal_stats_shard {
+	/**
+	 * Statistics for each adjustment method
+	 */
+	struct {
+		/**
+		 * Statistics for each operation
+		 */
+		struct {
+			atomic_ullong calls;
+			atomic_ullong errors;
+			atomic_ullong total_time;
+			atomic_ullong latency_histogram[LIBGAMMA_STATS_LATENCY_BUCKETS];
+		} operations[LIBGAMMA_STATS_OPERATION_COUNT];
+
+		/**
+		 * Counters indexed by `enum libgamma_internal_stats_counter`
+		 */
+		atomic_ullong counters[LIBGAMMA_INTERNAL_STATS_COUNTER_COUNT];
+	} methods[LIBGAMMA_METHOD_COUNT];
+
+	/**
+	 * Padding so that sets do not share cache lines,
+	 * which would slow down the threads using them
+	 */
+	char padding[64];
+};
+
+/**
+ * The state of the runtime statistics
+ */
+struct libgamma_internal_stats {
+	/**
+	 * Whether statistics are collected
+	 */
+	atomic_int enabled;
+
+	/**
+	 * The number of threads that have been
+	 * assigned a set of counters
+	 */
+	atomic_uint threads;
+
+	/**
+	 * The sets of counters
+	 */
+	struct libgamma_internal_stats_shard shards[LIBGAMMA_INTERNAL_STATS_SHARDS];
+};
+
+/**
+ * The state of the runtime statistics
+ */
+extern struct libgamma_internal_stats libgamma_internal_stats;
+
+/**
+ * Get the set of statistics counters for the calling thread
+ * 
+ * @return  The thread's set of counters
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__returns_nonnull__, __warn_unused_result__)))
+struct libgamma_internal_stats_shard *libgamma_internal_stats_shard(void);
+
+/**
+ * Get the time when an operation is started, for
+ * `libgamma_internal_stats_record`, if statistics
+ * are collected
+ * 
+ * @return  The time, in nanoseconds, on a clock that cannot
+ *          be set, 0 if statistics are not collected
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__warn_unused_result__)))
+unsigned long long int libgamma_internal_stats_start(void);
+
+/**
+ * Record a call to an adjustment method in the runtime statistics
+ * 
+ * @param  method     The adjustment method
+ * @param  operation  The operation
+ * @param  start      The return value of `libgamma_internal_stats_start`
+ *                    before the call, nothing is recorded if it is 0
+ * @param  error      Non-zero if the call failed
+ */
+void libgamma_internal_stats_record(int, enum libgamma_stats_operation, unsigned long long int, int);
+
+/**
+ * Add to a counter in the runtime statistics, if statistics are collected
+ * 
+ * @param  method   The adjustment method
+ * @param  counter  The counter
+ * @param  amount   The amount to add to the counter
+ */
+void libgamma_internal_stats_add(int, enum libgamma_internal_stats_counter, unsigned long long int);
+
+/**
+ * Get the CRTC's buffer for temporary gamma ramps,
+ * which is kept between calls so that it does not
+ * have to be reallocated every time gamma ramps
+ * are generated or converted
+ * 
+ * @param   this  The CRTC state
+ * @param   size  The number of bytes required
+ * @return        The buffer, `NULL` on allocation error
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+void *libgamma_internal_ramps_buffer(struct libgamma_crtc_state *restrict, size_t);
+
+/**
+ * Fill gamma ramps, of any depth, from parameters
+ * 
+ * @param   ramps   The gamma ramps to fill, the sizes must be set and the
+ *                  ramps must be allocated
+ * @param   depth   The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_internal_generate_ramps(union gamma_ramps_any *restrict, signed,
+                                     const struct libgamma_gamma_ramp_parameters *restrict);
+
+/**
+ * Get the depth that gamma ramps are stored
+ * in by the adjustment method, for a CRTC
+ * 
+ * @param   this        The CRTC state
+ * @param   depth_user  The depth to use if the adjustment method is flexible
+ *                      and the CRTC's depth cannot be queried, `-1` for
+ *                      `float`, `-2` for `double`
+ * @return              The native depth of the CRTC, `-1` for `float`,
+ *                      `-2` for `double`, 0 if the adjustment method
+ *                      is not available
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+signed libgamma_internal_native_depth(struct libgamma_crtc_state *restrict, signed);
+
+/**
+ * Prepare gamma ramps for fast application to a CRTC
+ * 
+ * @param   this        The CRTC state
+ * @param   prepared    Output parameter for the prepared gamma ramps
+ * @param   ramps       The gamma ramps to prepare
+ * @param   depth_user  The depth of the gamma ramps that are provided by the user,
+ *                      `-1` for `float`, `-2` for `double`
+ * @return              Zero on success, otherwise (negative) the value of an
+ *                      error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_internal_prepare_ramps(struct libgamma_crtc_state *restrict, struct libgamma_prepared_ramps *restrict,
+                                    const union gamma_ramps_any *restrict, signed);
+
+/**
+ * Get the size of a stop in a gamma ramp
+ * 
+ * @param   depth  The depth of the gamma ramp, `-1` for `float`, `-2` for `double`
+ * @return         The size of a stop, in bytes
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__const__, __warn_unused_result__)))
+size_t libgamma_internal_stop_size(signed);
+
 /**
  * Allocate and initalise a gamma ramp with any depth
  * 
@@ -0,0 +1,1350 @@
+/* See LICENSE file for copyright and license details. */
+
+/*
+ * This file is compiled into drm-simulator.so, which can be
+ * loaded with LD_PRELOAD in place of graphics cards, so that
+ * the Linux DRM adjustment method can be tested and benchmarked
+ * on machines without graphics cards or without access to them
+ *
+ * It intercepts `open`, `stat` and `close` for /dev/dri/card*,
+ * and implements all libdrm functions that libgamma uses, it
+ * does not call into libdrm. It is configured with these
+ * environment variables, read when it is first used:
+ *
+ *   LIBGAMMA_DRMSIM_CARDS       The number of graphics cards (default 1)
+ *   LIBGAMMA_DRMSIM_CRTCS       The number of CRTC:s per card (default 2)
+ *   LIBGAMMA_DRMSIM_CONNECTORS  The number of connectors per card (default 2),
+ *                               connector i is connected to CRTC i, and
+ *                               connectors without a CRTC are disconnected
+ *   LIBGAMMA_DRMSIM_GAMMA_SIZE  The size of the legacy gamma ramps (default 256)
+ *   LIBGAMMA_DRMSIM_LUT_SIZE    The size of the "GAMMA_LUT" property, zero (the
+ *                               default) if the cards do not support atomic
+ *                               modesetting
+ *   LIBGAMMA_DRMSIM_REFRESH     The refresh rate of the CRTC:s' 1920x1080 mode,
+ *                               in hertz (default 60), zero if the CRTC:s are
+ *                               not configured
+ *   LIBGAMMA_DRMSIM_EDID        Pathname of a file with the EDID of the monitors,
+ *                               a 128 byte EDID 1.3 is used by default
+ *   LIBGAMMA_DRMSIM_GID         The group that owns the cards (default the
+ *                               effective group of the process)
+ *   LIBGAMMA_DRMSIM_LATENCY     The number of nanoseconds each ioctl takes (default 0)
+ *   LIBGAMMA_DRMSIM_FAIL        Comma-separated list of FUNCTION=ERROR, which
+ *                               makes every call to FUNCTION fail with the
+ *                               errno value ERROR, e.g. "open=EACCES" or
+ *                               "drmModeCrtcSetGamma=EBUSY"
+ *   LIBGAMMA_DRMSIM_STATS       If set, the number of calls, ioctls and
+ *                               failures per function are printed to
+ *                               standard error at exit
+ *
+ * The number of ioctls that would have been made by libdrm, since the
+ * library was loaded, is returned by `libgamma_drm_simulator_ioctls`,
+ * which can be looked up with `dlsym`
+ *
+ * The simulator is not thread-safe
+ */
+#include <sys/stat.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+
+
+/**
+ * The simulated functions, and the number of ioctls
+ * libdrm makes per call to each of them
+ *
+ * @param  NAME    The name of the function
+ * @param  IOCTLS  The number of ioctls the function makes
+ */
+#define LIST_FUNCTIONS(_)\
+	_(open, 0)\
+	_(drmSetClientCap, 1)\
+	_(drmModeGetResources, 2)\
+	_(drmModeGetCrtc, 1)\
+	_(drmModeGetConnector, 2)\
+	_(drmModeGetEncoder, 1)\
+	_(drmModeGetProperty, 2)\
+	_(drmModeGetPropertyBlob, 2)\
+	_(drmModeObjectGetProperties, 2)\
+	_(drmModeCrtcGetGamma, 1)\
+	_(drmModeCrtcSetGamma, 1)\
+	_(drmModeCreatePropertyBlob, 1)\
+	_(drmModeDestroyPropertyBlob, 1)\
+	_(drmModeAtomicAlloc, 0)\
+	_(drmModeAtomicAddProperty, 0)\
+	_(drmModeAtomicCommit, 1)
+
+/**
+ * Errors that can be named in LIBGAMMA_DRMSIM_FAIL,
+ * errors can also be specified by their numbers
+ */
+#define LIST_ERRORS(_)\
+	_(EPERM) _(ENOENT) _(EINTR) _(EIO) _(ENXIO) _(EBADF) _(EAGAIN) _(ENOMEM)\
+	_(EACCES) _(EBUSY) _(ENODEV) _(EINVAL) _(ENOSPC) _(EINPROGRESS)
+
+/**
+ * The IDs of the simulated objects, object i of
+ * a type has the ID of its type's base plus i
+ */
+enum {
+	EDID_PROP = 1,
+	GAMMA_LUT_PROP = 2,
+	GAMMA_LUT_SIZE_PROP = 3,
+	CRTC_BASE = 100,
+	CONNECTOR_BASE = 200,
+	ENCODER_BASE = 300,
+	EDID_BLOB_BASE = 400,
+	BLOB_BASE = 1000
+};
+
+/**
+ * Indices for the simulated functions
+ */
+enum function {
+#define X(NAME, IOCTLS)\
+	FN_##NAME,
+	LIST_FUNCTIONS(X)
+#undef X
+	FUNCTION_COUNT
+};
+
+
+/**
+ * A property blob created with `drmModeCreatePropertyBlob`
+ */
+struct blob {
+	/**
+	 * The next blob
+	 */
+	struct blob *next;
+
+	/**
+	 * The data of the blob
+	 */
+	void *data;
+
+	/**
+	 * The size of `data`, in bytes
+	 */
+	uint32_t length;
+
+	/**
+	 * The ID of the blob
+	 */
+	uint32_t id;
+
+	/**
+	 * Whether `drmModeDestroyPropertyBlob` has been called for the
+	 * blob, it is kept until it is no longer used by any CRTC
+	 */
+	int destroyed;
+};
+
+/**
+ * A simulated graphics card
+ */
+struct card {
+	/**
+	 * The legacy gamma ramps of each CRTC, all red ramps are stored
+	 * first, then all green ramps, then all blue ramps, CRTC-major
+	 */
+	uint16_t *ramps;
+
+	/**
+	 * The value of the "GAMMA_LUT" property of each CRTC
+	 */
+	uint32_t *luts;
+};
+
+/**
+ * Atomic modesetting request
+ */
+struct _drmModeAtomicReq {
+	/**
+	 * The properties to set
+	 */
+	struct {
+		uint32_t object;
+		uint32_t property;
+		uint64_t value;
+	} *items;
+
+	/**
+	 * The number of elements in `items`
+	 */
+	size_t count;
+
+	/**
+	 * The number of elements allocated for `items`
+	 */
+	size_t size;
+};
+
+
+/**
+ * The names of the simulated functions
+ */
+static const char *const function_names[] = {
+#define X(NAME, IOCTLS)\
+	#NAME,
+	LIST_FUNCTIONS(X)
+#undef X
+};
+
+/**
+ * The number of ioctls each simulated function makes
+ */
+static const unsigned function_ioctls[] = {
+#define X(NAME, IOCTLS)\
+	IOCTLS,
+	LIST_FUNCTIONS(X)
+#undef X
+};
+
+/**
+ * The number of times each simulated function has been called
+ */
+static unsigned long long int calls[FUNCTION_COUNT];
+
+/**
+ * The number of times each simulated function has failed
+ */
+static unsigned long long int failures[FUNCTION_COUNT];
+
+/**
+ * The error each simulated function shall fail
+ * with, zero for functions that shall not fail
+ */
+static int fail_with[FUNCTION_COUNT];
+
+/**
+ * The total number of ioctls
+ */
+static unsigned long long int ioctls = 0;
+
+/**
+ * Whether the configuration has been loaded
+ */
+static int configured = 0;
+
+/**
+ * Configuration, see the top of the file
+ */
+static int cards = 1, crtcs = 2, connectors = 2;
+static uint32_t gamma_size = 256, lut_size = 0, refresh = 60;
+static gid_t gid;
+static unsigned long long int latency = 0;
+static int print_stats = 0;
+
+/**
+ * The EDID of the monitors
+ */
+static unsigned char *edid = NULL;
+
+/**
+ * The size of `edid`, in bytes
+ */
+static uint32_t edid_length;
+
+/**
+ * The state of the simulated cards
+ */
+static struct card *card_states;
+
+/**
+ * The card, plus 1, that each file descriptor
+ * is open to, indexed by file descriptor
+ */
+static int *fd_cards = NULL;
+
+/**
+ * The number of elements in `fd_cards`
+ */
+static size_t fd_cards_size = 0;
+
+/**
+ * The property blobs that have been created
+ */
+static struct blob *blobs = NULL;
+
+/**
+ * The ID of the next property blob
+ */
+static uint32_t next_blob = BLOB_BASE;
+
+/**
+ * The real functions that are intercepted
+ */
+static int (*real_open)(const char *, int, ...) = NULL;
+static int (*real_close)(int) = NULL;
+static int (*real_stat)(const char *restrict, struct stat *restrict) = NULL;
+#ifdef __GLIBC__
+static int (*real_open64)(const char *, int, ...) = NULL;
+static int (*real_stat64)(const char *restrict, struct stat64 *restrict) = NULL;
+#endif
+
+
+/**
+ * Get the number of ioctls that would have been
+ * made by libdrm, since the simulator was loaded
+ *
+ * @return  The number of ioctls
+ */
+unsigned long long int libgamma_drm_simulator_ioctls(void);
+unsigned long long int
+libgamma_drm_simulator_ioctls(void)
+{
+	return ioctls;
+}
+
+
+/**
+ * Look up a real function, and exit if it is missing
+ *
+ * @param   name  The name of the function
+ * @return        The function
+ */
+static void *
+real(const char *name)
+{
+	void *f = dlsym(RTLD_NEXT, name);
+	if (!f) {
+		fprintf(stderr, "drm-simulator: cannot find %s: %s\n", name, dlerror());
+		exit(1);
+	}
+	return f;
+}
+
+
+/**
+ * Parse a non-negative integer in an environment
+ * variable, and exit if it is malformatted
+ *
+ * @param   name   The name of the environment variable
+ * @param   value  The value to use if the environment variable is not set
+ * @return         The value of the environment variable
+ */
+static unsigned long long int
+number(const char *name, unsigned long long int value)
+{
+	const char *s = getenv(name);
+	char *end;
+	if (!s || !*s)
+		return value;
+	errno = 0;
+	value = strtoull(s, &end, 10);
+	if (errno || *end || *s == '-') {
+		fprintf(stderr, "drm-simulator: invalid value of %s: %s\n", name, s);
+		exit(1);
+	}
+	return value;
+}
+
+
+/**
+ * Parse LIBGAMMA_DRMSIM_FAIL, and exit if it is malformatted
+ */
+static void
+parse_failures(void)
+{
+	char *s = getenv("LIBGAMMA_DRMSIM_FAIL"), *item, *error, *end;
+	size_t i;
+	int e;
+
+	if (!s || !*s)
+		return;
+	s = strdup(s);
+	if (!s) {
+		perror("drm-simulator");
+		exit(1);
+	}
+
+	for (item = strtok(s, ","); item; item = strtok(NULL, ",")) {
+		error = strchr(item, '=');
+		if (!error)
+			goto invalid;
+		*error++ = '\0';
+		for (i = 0; i < FUNCTION_COUNT; i++)
+			if (!strcmp(item, function_names[i]))
+				break;
+		if (i == FUNCTION_COUNT)
+			goto invalid;
+#define X(ERROR)\
+		if (!strcmp(error, #ERROR))\
+			e = ERROR;\
+		else
+		LIST_ERRORS(X)
+#undef X
+		{
+			e = (int)strtol(error, &end, 10);
+			if (e <= 0 || *end)
+				goto invalid;
+		}
+		fail_with[i] = e;
+	}
+
+	free(s);
+	return;
+
+invalid:
+	fprintf(stderr, "drm-simulator: invalid value of LIBGAMMA_DRMSIM_FAIL\n");
+	exit(1);
+}
+
+
+/**
+ * Load the EDID of the monitors, and exit on failure
+ */
+static void
+load_edid(void)
+{
+	static unsigned char default_edid[128] = {
+		0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, /* Magic number */
+		0x30, 0xE1, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, /* Manufacturer ("LGA"), product and serial number */
+		0x01, 0x22, 0x01, 0x03,                         /* Week and year of manufacture, and EDID 1.3 */
+		0x80, 0x3C, 0x22, 0x78, 0x0A,                   /* Digital, 60 cm × 34 cm, gamma 2.2, RGB */
+		0xEE, 0x91, 0xA3, 0x54, 0x4C, 0x99, 0x26, 0x0F, 0x50, 0x54  /* sRGB chromaticities */
+	};
+	const char *path = getenv("LIBGAMMA_DRMSIM_EDID");
+	unsigned char sum = 0;
+	size_t i, size = 0;
+	ssize_t r;
+	int fd;
+
+	if (!path || !*path) {
+		for (i = 0; i < 127; i++)
+			sum = (unsigned char)(sum + default_edid[i]);
+		default_edid[127] = (unsigned char)-sum;
+		edid = default_edid;
+		edid_length = sizeof(default_edid);
+		return;
+	}
+
+	fd = real_open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		goto fail;
+	for (;;) {
+		if (size == edid_length) {
+			edid = realloc(edid, edid_length = edid_length ? 2 * edid_length : 256);
+			if (!edid)
+				goto fail;
+		}
+		r = read(fd, &edid[size], edid_length - size);
+		if (r <= 0) {
+			if (!r)
+				break;
+			if (errno == EINTR)
+				continue;
+			goto fail;
+		}
+		size += (size_t)r;
+	}
+	real_close(fd);
+	edid_length = (uint32_t)size;
+	return;
+
+fail:
+	perror("drm-simulator: LIBGAMMA_DRMSIM_EDID");
+	exit(1);
+}
+
+
+/**
+ * Load the configuration, unless already loaded, and
+ * set up the cards, with identity gamma ramps
+ */
+static void
+configure(void)
+{
+	size_t i, n;
+	int c;
+
+	if (configured)
+		return;
+	configured = 1;
+
+	real_open  = real("open");
+	real_close = real("close");
+	real_stat  = real("stat");
+#ifdef __GLIBC__
+	real_open64 = real("open64");
+	real_stat64 = real("stat64");
+#endif
+
+	cards       = (int)number("LIBGAMMA_DRMSIM_CARDS", 1);
+	crtcs       = (int)number("LIBGAMMA_DRMSIM_CRTCS", 2);
+	connectors  = (int)number("LIBGAMMA_DRMSIM_CONNECTORS", 2);
+	gamma_size  = (uint32_t)number("LIBGAMMA_DRMSIM_GAMMA_SIZE", 256);
+	lut_size    = (uint32_t)number("LIBGAMMA_DRMSIM_LUT_SIZE", 0);
+	refresh     = (uint32_t)number("LIBGAMMA_DRMSIM_REFRESH", 60);
+	gid         = (gid_t)number("LIBGAMMA_DRMSIM_GID", (unsigned long long int)getegid());
+	latency     = number("LIBGAMMA_DRMSIM_LATENCY", 0);
+	print_stats = !!getenv("LIBGAMMA_DRMSIM_STATS");
+	parse_failures();
+	load_edid();
+
+	n = (size_t)crtcs * gamma_size;
+	card_states = calloc((size_t)cards + 1, sizeof(*card_states));
+	if (!card_states)
+		goto fail;
+	for (c = 0; c < cards; c++) {
+		card_states[c].ramps = malloc((3 * n + 1) * sizeof(uint16_t));
+		card_states[c].luts = calloc((size_t)crtcs + 1, sizeof(uint32_t));
+		if (!card_states[c].ramps || !card_states[c].luts)
+			goto fail;
+		for (i = 0; i < 3 * n; i++)
+			card_states[c].ramps[i] = (uint16_t)((i % gamma_size) * UINT16_MAX / (gamma_size > 1 ? gamma_size - 1 : 1));
+	}
+	return;
+
+fail:
+	perror("drm-simulator");
+	exit(1);
+}
+
+
+/**
+ * Print the statistics, if LIBGAMMA_DRMSIM_STATS is set
+ */
+__attribute__((__destructor__))
+static void
+report(void)
+{
+	size_t i;
+	if (!print_stats)
+		return;
+	fprintf(stderr, "function\tcalls\tioctls\tfailures\n");
+	for (i = 0; i < FUNCTION_COUNT; i++)
+		if (calls[i])
+			fprintf(stderr, "%s\t%llu\t%llu\t%llu\n", function_names[i], calls[i],
+			        calls[i] * function_ioctls[i], failures[i]);
+	fprintf(stderr, "total\t-\t%llu\t-\n", ioctls);
+}
+
+
+/**
+ * Account for a call to a simulated function, and
+ * simulate its latency and configured failure
+ *
+ * @param   function  The called function
+ * @return            Zero if the call shall proceed, -1 if the
+ *                    call shall fail, `errno` is set to the error
+ */
+static int
+enter(enum function function)
+{
+	struct timespec ts;
+	unsigned long long int ns, end;
+
+	configure();
+
+	calls[function] += 1;
+	ioctls += function_ioctls[function];
+
+	/* Sleeping is too imprecise for the latency of an ioctl, so busy-wait */
+	ns = latency * function_ioctls[function];
+	if (ns) {
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		end = (unsigned long long int)ts.tv_sec * 1000000000ULL + (unsigned long long int)ts.tv_nsec + ns;
+		do
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+		while ((unsigned long long int)ts.tv_sec * 1000000000ULL + (unsigned long long int)ts.tv_nsec < end);
+	}
+
+	if (fail_with[function]) {
+		failures[function] += 1;
+		errno = fail_with[function];
+		return -1;
+	}
+	return 0;
+}
+
+
+/**
+ * Get the card a file descriptor is open to
+ *
+ * @param   fd  The file descriptor
+ * @return      The card, `NULL` with `errno` set to
+ *              `EBADF` if `fd` is not open to a card
+ */
+static struct card *
+get_card(int fd)
+{
+	if (fd < 0 || (size_t)fd >= fd_cards_size || !fd_cards[fd]) {
+		errno = EBADF;
+		return NULL;
+	}
+	return &card_states[fd_cards[fd] - 1];
+}
+
+
+/**
+ * Get the index of a CRTC from its ID
+ *
+ * @param   id  The ID of the CRTC
+ * @return      The index of the CRTC, -1 with
+ *              `errno` set to `ENOENT` if there
+ *              is no such CRTC
+ */
+static int
+get_crtc(uint32_t id)
+{
+	if (id < CRTC_BASE || id - CRTC_BASE >= (uint32_t)crtcs) {
+		errno = ENOENT;
+		return -1;
+	}
+	return (int)(id - CRTC_BASE);
+}
+
+
+/**
+ * Get the created property blob with a specific ID
+ *
+ * @param   id  The ID of the blob
+ * @return      The blob, `NULL` if not found
+ */
+static struct blob *
+get_blob(uint32_t id)
+{
+	struct blob *blob;
+	for (blob = blobs; blob; blob = blob->next)
+		if (blob->id == id)
+			return blob;
+	return NULL;
+}
+
+
+/**
+ * Free a property blob that has been destroyed,
+ * unless it is still used by a CRTC
+ *
+ * @param  id  The ID of the blob
+ */
+static void
+release_blob(uint32_t id)
+{
+	struct blob **blobp, *blob;
+	int c, i;
+
+	for (c = 0; c < cards; c++)
+		for (i = 0; i < crtcs; i++)
+			if (card_states[c].luts[i] == id)
+				return;
+
+	for (blobp = &blobs; *blobp; blobp = &(*blobp)->next) {
+		blob = *blobp;
+		if (blob->id == id) {
+			if (blob->destroyed) {
+				*blobp = blob->next;
+				free(blob->data);
+				free(blob);
+			}
+			return;
+		}
+	}
+}
+
+
+/**
+ * Get the index of the card that a pathname refers to
+ *
+ * @param   path  The pathname
+ * @return        The index of the card, -1 if the pathname
+ *                is not the pathname of a card, which may
+ *                not exist
+ */
+static int
+card_path(const char *path)
+{
+	char expected[sizeof(DRM_DIR_NAME) + sizeof("/card")];
+	size_t n;
+	long int i;
+	char *end;
+
+	n = (size_t)sprintf(expected, "%s/card", DRM_DIR_NAME);
+	if (strncmp(path, expected, n) || path[n] < '0' || path[n] > '9')
+		return -1;
+	errno = 0;
+	i = strtol(&path[n], &end, 10);
+	if (errno || *end || i > INT32_MAX)
+		return -1;
+	return (int)i;
+}
+
+
+/**
+ * Open a simulated card
+ *
+ * @param   c      The index of the card
+ * @param   flags  The flags passed to `open`
+ * @return         A file descriptor for the card, -1 on failure
+ */
+static int
+open_card(int c, int flags)
+{
+	int *new, fd;
+
+	if (enter(FN_open))
+		return -1;
+	if (c >= cards) {
+		errno = ENOENT;
+		return -1;
+	}
+
+	fd = real_open("/dev/null", (flags & (O_ACCMODE | O_CLOEXEC | O_NONBLOCK)));
+	if (fd < 0)
+		return -1;
+	if ((size_t)fd >= fd_cards_size) {
+		new = realloc(fd_cards, ((size_t)fd + 1) * sizeof(*fd_cards));
+		if (!new) {
+			real_close(fd);
+			errno = ENOMEM;
+			return -1;
+		}
+		memset(&new[fd_cards_size], 0, ((size_t)fd + 1 - fd_cards_size) * sizeof(*new));
+		fd_cards = new;
+		fd_cards_size = (size_t)fd + 1;
+	}
+	fd_cards[fd] = c + 1;
+	return fd;
+}
+
+
+/**
+ * Get the attributes of a simulated card
+ *
+ * @param   c     The index of the card
+ * @param   attr  Output parameter for the attributes
+ * @return        0 on success, -1 on failure
+ */
+static int
+stat_card(int c, struct stat *restrict attr)
+{
+	if (c >= cards) {
+		errno = ENOENT;
+		return -1;
+	}
+	memset(attr, 0, sizeof(*attr));
+	attr->st_mode = S_IFCHR | 0660;
+	attr->st_uid = 0;
+	attr->st_gid = gid;
+	attr->st_nlink = 1;
+	return 0;
+}
+
+
+int
+open(const char *path, int flags, ...)
+{
+	va_list args;
+	mode_t mode = 0;
+	int c;
+	configure();
+	if (flags & O_CREAT) {
+		va_start(args, flags);
+		mode = va_arg(args, mode_t);
+		va_end(args);
+	}
+	c = card_path(path);
+	return c < 0 ? real_open(path, flags, mode) : open_card(c, flags);
+}
+
+
+int
+stat(const char *restrict path, struct stat *restrict attr)
+{
+	int c;
+	configure();
+	c = card_path(path);
+	return c < 0 ? real_stat(path, attr) : stat_card(c, attr);
+}
+
+
+#ifdef __GLIBC__
+int
+open64(const char *path, int flags, ...)
+{
+	va_list args;
+	mode_t mode = 0;
+	int c;
+	configure();
+	if (flags & O_CREAT) {
+		va_start(args, flags);
+		mode = va_arg(args, mode_t);
+		va_end(args);
+	}
+	c = card_path(path);
+	return c < 0 ? real_open64(path, flags, mode) : open_card(c, flags);
+}
+
+
+int
+stat64(const char *restrict path, struct stat64 *restrict attr)
+{
+	struct stat st;
+	int c;
+	configure();
+	c = card_path(path);
+	if (c < 0)
+		return real_stat64(path, attr);
+	if (stat_card(c, &st))
+		return -1;
+	memset(attr, 0, sizeof(*attr));
+	attr->st_mode = st.st_mode;
+	attr->st_uid = st.st_uid;
+	attr->st_gid = st.st_gid;
+	attr->st_nlink = st.st_nlink;
+	return 0;
+}
+#endif
+
+
+int
+close(int fd)
+{
+	configure();
+	if (fd >= 0 && (size_t)fd < fd_cards_size)
+		fd_cards[fd] = 0;
+	return real_close(fd);
+}
+
+
+int
+drmSetClientCap(int fd, uint64_t capability, uint64_t value)
+{
+	if (enter(FN_drmSetClientCap) || !get_card(fd))
+		return -1;
+	/* Atomic modesetting is only supported if the "GAMMA_LUT" property is */
+	if (capability == DRM_CLIENT_CAP_ATOMIC && value && !lut_size) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+	return 0;
+}
+
+
+drmModeResPtr
+drmModeGetResources(int fd)
+{
+	drmModeRes *res;
+	int i;
+
+	if (enter(FN_drmModeGetResources) || !get_card(fd))
+		return NULL;
+
+	res = calloc(1, sizeof(*res));
+	if (!res)
+		return NULL;
+	res->count_crtcs = crtcs;
+	res->count_connectors = connectors;
+	res->count_encoders = connectors;
+	res->crtcs = malloc(((size_t)crtcs + 1) * sizeof(*res->crtcs));
+	res->connectors = malloc(((size_t)connectors + 1) * sizeof(*res->connectors));
+	res->encoders = malloc(((size_t)connectors + 1) * sizeof(*res->encoders));
+	if (!res->crtcs || !res->connectors || !res->encoders) {
+		drmModeFreeResources(res);
+		errno = ENOMEM;
+		return NULL;
+	}
+	for (i = 0; i < crtcs; i++)
+		res->crtcs[i] = (uint32_t)(CRTC_BASE + i);
+	for (i = 0; i < connectors; i++) {
+		res->connectors[i] = (uint32_t)(CONNECTOR_BASE + i);
+		res->encoders[i] = (uint32_t)(ENCODER_BASE + i);
+	}
+	res->max_width = res->max_height = 16384;
+	return res;
+}
+
+
+void
+drmModeFreeResources(drmModeResPtr ptr)
+{
+	if (ptr) {
+		free(ptr->fbs);
+		free(ptr->crtcs);
+		free(ptr->connectors);
+		free(ptr->encoders);
+		free(ptr);
+	}
+}
+
+
+drmModeCrtcPtr
+drmModeGetCrtc(int fd, uint32_t crtcId)
+{
+	drmModeCrtc *crtc;
+
+	if (enter(FN_drmModeGetCrtc) || !get_card(fd) || get_crtc(crtcId) < 0)
+		return NULL;
+
+	crtc = calloc(1, sizeof(*crtc));
+	if (!crtc)
+		return NULL;
+	crtc->crtc_id = crtcId;
+	crtc->gamma_size = (int)gamma_size;
+	if (refresh) {
+		/* CEA-861 timings for 1920x1080 */
+		crtc->mode_valid = 1;
+		crtc->width = crtc->mode.hdisplay = 1920;
+		crtc->height = crtc->mode.vdisplay = 1080;
+		crtc->mode.htotal = 2200;
+		crtc->mode.vtotal = 1125;
+		crtc->mode.clock = refresh * 2200U * 1125U / 1000U;
+		crtc->mode.vrefresh = refresh;
+	}
+	return crtc;
+}
+
+
+void
+drmModeFreeCrtc(drmModeCrtcPtr ptr)
+{
+	free(ptr);
+}
+
+
+drmModeConnectorPtr
+drmModeGetConnector(int fd, uint32_t connectorId)
+{
+	/* The types of the connectors, in order, repeated if there are more connectors */
+	static const uint32_t types[] = {
+		DRM_MODE_CONNECTOR_DisplayPort, DRM_MODE_CONNECTOR_HDMIA, DRM_MODE_CONNECTOR_DVID, DRM_MODE_CONNECTOR_VGA
+	};
+	drmModeConnector *connector;
+	uint32_t i;
+
+	if (enter(FN_drmModeGetConnector) || !get_card(fd))
+		return NULL;
+	i = connectorId - CONNECTOR_BASE;
+	if (connectorId < CONNECTOR_BASE || i >= (uint32_t)connectors) {
+		errno = ENOENT;
+		return NULL;
+	}
+
+	connector = calloc(1, sizeof(*connector));
+	if (!connector)
+		return NULL;
+	connector->connector_id = connectorId;
+	connector->connector_type = types[i % (sizeof(types) / sizeof(*types))];
+	connector->connector_type_id = i / (uint32_t)(sizeof(types) / sizeof(*types)) + 1;
+	connector->subpixel = DRM_MODE_SUBPIXEL_HORIZONTAL_RGB;
+	if (i >= (uint32_t)crtcs) {
+		connector->connection = DRM_MODE_DISCONNECTED;
+		return connector;
+	}
+
+	connector->connection = DRM_MODE_CONNECTED;
+	connector->encoder_id = ENCODER_BASE + i;
+	connector->mmWidth = 600;
+	connector->mmHeight = 340;
+	connector->props = malloc(sizeof(*connector->props));
+	connector->prop_values = malloc(sizeof(*connector->prop_values));
+	connector->encoders = malloc(sizeof(*connector->encoders));
+	if (!connector->props || !connector->prop_values || !connector->encoders) {
+		drmModeFreeConnector(connector);
+		errno = ENOMEM;
+		return NULL;
+	}
+	connector->count_props = 1;
+	connector->props[0] = EDID_PROP;
+	connector->prop_values[0] = EDID_BLOB_BASE + i;
+	connector->count_encoders = 1;
+	connector->encoders[0] = connector->encoder_id;
+	return connector;
+}
+
+
+void
+drmModeFreeConnector(drmModeConnectorPtr ptr)
+{
+	if (ptr) {
+		free(ptr->modes);
+		free(ptr->props);
+		free(ptr->prop_values);
+		free(ptr->encoders);
+		free(ptr);
+	}
+}
+
+
+drmModeEncoderPtr
+drmModeGetEncoder(int fd, uint32_t encoder_id)
+{
+	drmModeEncoder *encoder;
+	uint32_t i;
+
+	if (enter(FN_drmModeGetEncoder) || !get_card(fd))
+		return NULL;
+	i = encoder_id - ENCODER_BASE;
+	if (encoder_id < ENCODER_BASE || i >= (uint32_t)connectors) {
+		errno = ENOENT;
+		return NULL;
+	}
+
+	encoder = calloc(1, sizeof(*encoder));
+	if (!encoder)
+		return NULL;
+	encoder->encoder_id = encoder_id;
+	encoder->crtc_id = i < (uint32_t)crtcs ? CRTC_BASE + i : 0;
+	encoder->possible_crtcs = crtcs < 32 ? (UINT32_C(1) << crtcs) - 1 : UINT32_MAX;
+	return encoder;
+}
+
+
+void
+drmModeFreeEncoder(drmModeEncoderPtr ptr)
+{
+	free(ptr);
+}
+
+
+drmModePropertyPtr
+drmModeGetProperty(int fd, uint32_t propertyId)
+{
+	drmModePropertyRes *prop;
+	const char *name;
+
+	if (enter(FN_drmModeGetProperty) || !get_card(fd))
+		return NULL;
+	switch (propertyId) {
+	case EDID_PROP:
+		name = "EDID";
+		break;
+	case GAMMA_LUT_PROP:
+		name = "GAMMA_LUT";
+		break;
+	case GAMMA_LUT_SIZE_PROP:
+		name = "GAMMA_LUT_SIZE";
+		break;
+	default:
+		errno = ENOENT;
+		return NULL;
+	}
+
+	prop = calloc(1, sizeof(*prop));
+	if (!prop)
+		return NULL;
+	prop->prop_id = propertyId;
+	strcpy(prop->name, name);
+	return prop;
+}
+
+
+void
+drmModeFreeProperty(drmModePropertyPtr ptr)
+{
+	if (ptr) {
+		free(ptr->values);
+		free(ptr->enums);
+		free(ptr->blob_ids);
+		free(ptr);
+	}
+}
+
+
+drmModePropertyBlobPtr
+drmModeGetPropertyBlob(int fd, uint32_t blob_id)
+{
+	drmModePropertyBlobRes *res;
+	struct blob *blob = NULL;
+	const void *data;
+	uint32_t length;
+
+	if (enter(FN_drmModeGetPropertyBlob) || !get_card(fd))
+		return NULL;
+	if (blob_id >= EDID_BLOB_BASE && blob_id - EDID_BLOB_BASE < (uint32_t)connectors) {
+		data = edid;
+		length = edid_length;
+	} else if ((blob = get_blob(blob_id))) {
+		/* Like in the kernel, a destroyed blob can still
+		 * be read while it is used by a CRTC, otherwise
+		 * it would already have been released */
+		data = blob->data;
+		length = blob->length;
+	} else {
+		errno = ENOENT;
+		return NULL;
+	}
+
+	res = calloc(1, sizeof(*res));
+	if (!res)
+		return NULL;
+	res->id = blob_id;
+	res->length = length;
+	res->data = malloc(length ? length : 1);
+	if (!res->data) {
+		free(res);
+		return NULL;
+	}
+	memcpy(res->data, data, length);
+	return res;
+}
+
+
+void
+drmModeFreePropertyBlob(drmModePropertyBlobPtr ptr)
+{
+	if (ptr) {
+		free(ptr->data);
+		free(ptr);
+	}
+}
+
+
+drmModeObjectPropertiesPtr
+drmModeObjectGetProperties(int fd, uint32_t object_id, uint32_t object_type)
+{
+	drmModeObjectProperties *props;
+	struct card *card;
+	int i;
+
+	if (enter(FN_drmModeObjectGetProperties) || !(card = get_card(fd)))
+		return NULL;
+
+	props = calloc(1, sizeof(*props));
+	if (!props)
+		return NULL;
+	props->props = malloc(2 * sizeof(*props->props));
+	props->prop_values = malloc(2 * sizeof(*props->prop_values));
+	if (!props->props || !props->prop_values) {
+		drmModeFreeObjectProperties(props);
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	if (object_type == DRM_MODE_OBJECT_CRTC) {
+		if ((i = get_crtc(object_id)) < 0)
+			goto fail;
+		if (lut_size) {
+			props->count_props = 2;
+			props->props[0] = GAMMA_LUT_PROP;
+			props->prop_values[0] = card->luts[i];
+			props->props[1] = GAMMA_LUT_SIZE_PROP;
+			props->prop_values[1] = lut_size;
+		}
+	} else if (object_type == DRM_MODE_OBJECT_CONNECTOR) {
+		if (object_id < CONNECTOR_BASE || object_id - CONNECTOR_BASE >= (uint32_t)connectors) {
+			errno = ENOENT;
+			goto fail;
+		}
+		if (object_id - CONNECTOR_BASE < (uint32_t)crtcs) {
+			props->count_props = 1;
+			props->props[0] = EDID_PROP;
+			props->prop_values[0] = EDID_BLOB_BASE + (object_id - CONNECTOR_BASE);
+		}
+	} else {
+		errno = EINVAL;
+		goto fail;
+	}
+	return props;
+
+fail:
+	drmModeFreeObjectProperties(props);
+	return NULL;
+}
+
+
+void
+drmModeFreeObjectProperties(drmModeObjectPropertiesPtr ptr)
+{
+	if (ptr) {
+		free(ptr->props);
+		free(ptr->prop_values);
+		free(ptr);
+	}
+}
+
+
+int
+drmModeCrtcGetGamma(int fd, uint32_t crtc_id, uint32_t size, uint16_t *red, uint16_t *green, uint16_t *blue)
+{
+	struct card *card;
+	size_t off, n;
+	int i;
+
+	if (enter(FN_drmModeCrtcGetGamma) || !(card = get_card(fd)) || (i = get_crtc(crtc_id)) < 0)
+		return -errno;
+	if (size != gamma_size) {
+		errno = EINVAL;
+		return -errno;
+	}
+	n = (size_t)crtcs * gamma_size;
+	off = (size_t)i * gamma_size;
+	memcpy(red,   &card->ramps[0 * n + off], gamma_size * sizeof(*red));
+	memcpy(green, &card->ramps[1 * n + off], gamma_size * sizeof(*green));
+	memcpy(blue,  &card->ramps[2 * n + off], gamma_size * sizeof(*blue));
+	return 0;
+}
+
+
+int
+drmModeCrtcSetGamma(int fd, uint32_t crtc_id, uint32_t size, const uint16_t *red,
+                    const uint16_t *green, const uint16_t *blue)
+{
+	struct card *card;
+	size_t off, n;
+	int i;
+
+	if (enter(FN_drmModeCrtcSetGamma) || !(card = get_card(fd)) || (i = get_crtc(crtc_id)) < 0)
+		return -errno;
+	if (size != gamma_size) {
+		errno = EINVAL;
+		return -errno;
+	}
+	n = (size_t)crtcs * gamma_size;
+	off = (size_t)i * gamma_size;
+	memcpy(&card->ramps[0 * n + off], red,   gamma_size * sizeof(*red));
+	memcpy(&card->ramps[1 * n + off], green, gamma_size * sizeof(*green));
+	memcpy(&card->ramps[2 * n + off], blue,  gamma_size * sizeof(*blue));
+	return 0;
+}
+
+
+int
+drmModeCreatePropertyBlob(int fd, const void *data, size_t size, uint32_t *id)
+{
+	struct blob *blob;
+
+	if (enter(FN_drmModeCreatePropertyBlob) || !get_card(fd))
+		return -errno;
+	if (!size || size > UINT32_MAX) {
+		errno = EINVAL;
+		return -errno;
+	}
+
+	blob = calloc(1, sizeof(*blob));
+	if (!blob)
+		return -errno;
+	blob->data = malloc(size);
+	if (!blob->data) {
+		free(blob);
+		return -errno;
+	}
+	memcpy(blob->data, data, size);
+	blob->length = (uint32_t)size;
+	blob->id = next_blob++;
+	blob->next = blobs;
+	blobs = blob;
+	*id = blob->id;
+	return 0;
+}
+
+
+int
+drmModeDestroyPropertyBlob(int fd, uint32_t id)
+{
+	struct blob *blob;
+
+	if (enter(FN_drmModeDestroyPropertyBlob) || !get_card(fd))
+		return -errno;
+	blob = get_blob(id);
+	if (!blob || blob->destroyed) {
+		errno = ENOENT;
+		return -errno;
+	}
+	blob->destroyed = 1;
+	release_blob(id);
+	return 0;
+}
+
+
+drmModeAtomicReqPtr
+drmModeAtomicAlloc(void)
+{
+	if (enter(FN_drmModeAtomicAlloc))
+		return NULL;
+	return calloc(1, sizeof(struct _drmModeAtomicReq));
+}
+
+
+void
+drmModeAtomicFree(drmModeAtomicReqPtr req)
+{
+	if (req) {
+		free(req->items);
+		free(req);
+	}
+}
+
+
+int
+drmModeAtomicAddProperty(drmModeAtomicReqPtr req, uint32_t object_id, uint32_t property_id, uint64_t value)
+{
+	void *new;
+
+	if (enter(FN_drmModeAtomicAddProperty))
+		return -errno;
+	if (!req) {
+		errno = EINVAL;
+		return -errno;
+	}
+	if (req->count == req->size) {
+		new = realloc(req->items, (req->size ? 2 * req->size : 8) * sizeof(*req->items));
+		if (!new)
+			return -errno;
+		req->items = new;
+		req->size = req->size ? 2 * req->size : 8;
+	}
+	req->items[req->count].object = object_id;
+	req->items[req->count].property = property_id;
+	req->items[req->count].value = value;
+	return (int)++req->count;
+}
+
+
+int
+drmModeAtomicCommit(int fd, drmModeAtomicReqPtr req, uint32_t flags, void *user_data)
+{
+	struct card *card;
+	struct blob *blob;
+	uint32_t old;
+	size_t i;
+	int crtc;
+
+	(void) user_data;
+
+	if (enter(FN_drmModeAtomicCommit) || !(card = get_card(fd)))
+		return -errno;
+	if (!req || !lut_size) {
+		errno = EINVAL;
+		return -errno;
+	}
+
+	/* The request is validated in full before anything is changed */
+	for (i = 0; i < req->count; i++) {
+		if (get_crtc(req->items[i].object) < 0)
+			return -errno;
+		if (req->items[i].property != GAMMA_LUT_PROP || req->items[i].value > UINT32_MAX)
+			goto invalid;
+		if (!req->items[i].value)
+			continue;
+		blob = get_blob((uint32_t)req->items[i].value);
+		if (!blob || blob->destroyed || blob->length != lut_size * sizeof(struct drm_color_lut))
+			goto invalid;
+	}
+	if (flags & DRM_MODE_ATOMIC_TEST_ONLY)
+		return 0;
+
+	for (i = 0; i < req->count; i++) {
+		crtc = get_crtc(req->items[i].object);
+		old = card->luts[crtc];
+		card->luts[crtc] = (uint32_t)req->items[i].value;
+		if (old)
+			release_blob(old);
+	}
+	return 0;
+
+invalid:
+	errno = EINVAL;
+	return -errno;
+}
@@ -7,19 +7,33 @@
 
 
 union gamma_ramps_any ramps_;
+unsigned long long int start_;
+int r_, timed_ = 1;
+ramps_.TYPE = *ramps;
+if (libgamma_internal_read_cached_ramps(this, &ramps_, DEPTH))
+	return 0;
+start_ = libgamma_internal_stats_start();
 switch (this->partition->site->method) {
 #define X(CONST, CNAME, MDEPTH, MRAMPS)\
 case CONST:\
 	if (!(MDEPTH)) {\
-		return APPEND_RAMPS(libgamma_dummy_crtc_get_gamma_)(this, (void *)ramps); /* only dummy is flexible */\
+		timed_ = !libgamma_dummy_internal_crtc_translates(this, DEPTH);\
+		r_ = APPEND_RAMPS(libgamma_dummy_crtc_get_gamma_)(this, (void *)ramps); /* only dummy is flexible */\
 	} else if ((DEPTH) == (MDEPTH)) {\
-		return libgamma_##CNAME##_crtc_get_gamma_##MRAMPS(this, (void *)ramps);\
+		r_ = libgamma_##CNAME##_crtc_get_gamma_##MRAMPS(this, (void *)ramps);\
 	} else {\
-		ramps_.TYPE = *ramps;\
+		/* The gamma ramps are cached in the adjustment method's depth */\
 		return libgamma_internal_translated_ramp_get(this, &ramps_, DEPTH, MDEPTH, libgamma_crtc_get_gamma_##MRAMPS);\
-	}
+	}\
+	break;
 LIST_AVAILABLE_METHODS(X)
 #undef X
 default:
 	return LIBGAMMA_NO_SUCH_ADJUSTMENT_METHOD;
 }
+/* Translated gamma ramps are recorded when they are read in the adjustment method's depth */
+if (timed_)
+	libgamma_internal_stats_record(this->partition->site->method, LIBGAMMA_STATS_GET_GAMMA, start_, r_);
+if (!r_)
+	libgamma_internal_cache_ramps(this, &ramps_, DEPTH);
+return r_;
@@ -827,6 +827,32 @@ struct libgamma_site_state {
 	 * Rendering Manager, a partition is a graphics card.
 	 */
 	size_t partitions_available;
+
+	/**
+	 * Requests submitted with `libgamma_crtc_get_gamma_ramps16_async`
+	 * or `libgamma_crtc_set_gamma_ramps16_async` that have not been
+	 * dispatched, in the order they were submitted
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	struct libgamma_crtc_request *requests;
+
+	/**
+	 * The last request in `requests`, `NULL` if
+	 * there are no requests in `requests`
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	struct libgamma_crtc_request *requests_last;
+
+	/**
+	 * File descriptor that is signalled when a request completes
+	 * without waiting for the display server, -1 if it has not
+	 * been created by `libgamma_site_get_request_fd`
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	int request_fd;
 };
 
 
@@ -868,6 +894,17 @@ struct libgamma_partition_state {
 	 * online
 	 */
 	size_t crtcs_available;
+
+	/**
+	 * Incremented by `libgamma_site_process_events`
+	 * each time the configuration of the partition
+	 * changes, so that information cached in CRTC
+	 * states can be discarded; it is also incremented
+	 * when the gamma ramps are restored, or fail to
+	 * be committed, so that CRTC states forget which
+	 * gamma ramps they last applied
+	 */
+	unsigned long long int generation;
 };
 
 
@@ -895,6 +932,173 @@ struct libgamma_crtc_state {
 	 * The index of the CRTC within its partition
 	 */
 	size_t crtc;
+
+	/**
+	 * The value of `partition->generation` when the
+	 * gamma ramp sizes were cached
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	unsigned long long int cached_generation;
+
+	/**
+	 * The size of the red gamma ramp, as cached by
+	 * `libgamma_crtc_set_gamma_ramps*_f`, or 0 if not cached
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t cached_red_gamma_size;
+
+	/**
+	 * The size of the green gamma ramp, as cached by
+	 * `libgamma_crtc_set_gamma_ramps*_f`, or 0 if not cached
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t cached_green_gamma_size;
+
+	/**
+	 * The size of the blue gamma ramp, as cached by
+	 * `libgamma_crtc_set_gamma_ramps*_f`, or 0 if not cached
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t cached_blue_gamma_size;
+
+	/**
+	 * Buffer that `libgamma_crtc_set_gamma_ramps*_f` reuses
+	 * for the gamma ramps it generates
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	void *ramps_buffer;
+
+	/**
+	 * The allocation size of `ramps_buffer`, in bytes
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t ramps_buffer_size;
+
+	/**
+	 * Whether `libgamma_crtc_set_gamma_ramps*` and
+	 * `libgamma_crtc_apply_prepared` shall skip the write
+	 * if the gamma ramps are identical to the gamma ramps
+	 * this state last applied to the CRTC
+	 * 
+	 * This is 0 after `libgamma_crtc_initialise`, set it
+	 * to non-zero to enable the deduplication; it should
+	 * only be enabled if no other program is expected to
+	 * change the gamma ramps of the CRTC
+	 */
+	int deduplicate_writes;
+
+	/**
+	 * The depth of the gamma ramps last applied,
+	 * 0 if not known, used when `deduplicate_writes`
+	 * is non-zero
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	signed applied_depth;
+
+	/**
+	 * The value of `partition->generation` when the
+	 * gamma ramps were last applied
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	unsigned long long int applied_generation;
+
+	/**
+	 * Fingerprint of the gamma ramps last applied
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	uint64_t applied_fingerprint;
+
+	/**
+	 * Whether `libgamma_crtc_get_gamma_ramps*` shall
+	 * return the gamma ramps this state last applied
+	 * to, or read from, the CRTC, instead of reading
+	 * them from the CRTC again
+	 * 
+	 * This is 0 after `libgamma_crtc_initialise`, set it
+	 * to non-zero to enable the cache; unless `read_cache_ttl`
+	 * is set, it should only be enabled if no other program
+	 * is expected to change the gamma ramps of the CRTC
+	 */
+	int cache_reads;
+
+	/**
+	 * The number of milliseconds gamma ramps are kept
+	 * in the cache enabled by `cache_reads`, 0 to keep
+	 * them until the configuration of the partition
+	 * changes or `libgamma_crtc_invalidate_cache` is called
+	 * 
+	 * This is 0 after `libgamma_crtc_initialise`
+	 */
+	unsigned long int read_cache_ttl;
+
+	/**
+	 * The depth of the gamma ramps in `read_cache`,
+	 * 0 if the cache is empty
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	signed read_cache_depth;
+
+	/**
+	 * The value of `partition->generation` when the
+	 * gamma ramps in `read_cache` were stored
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	unsigned long long int read_cache_generation;
+
+	/**
+	 * The time, in milliseconds on the monotonic clock,
+	 * when the gamma ramps in `read_cache` were stored
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	unsigned long long int read_cache_time;
+
+	/**
+	 * The size of the red gamma ramp in `read_cache`
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t read_cache_red_size;
+
+	/**
+	 * The size of the green gamma ramp in `read_cache`
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t read_cache_green_size;
+
+	/**
+	 * The size of the blue gamma ramp in `read_cache`
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t read_cache_blue_size;
+
+	/**
+	 * The cached gamma ramps, the red, green, and
+	 * blue gamma ramps stored one after another
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	void *read_cache;
+
+	/**
+	 * The allocation size of `read_cache`, in bytes
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t read_cache_size;
 };
 
 
@@ -1589,6 +1793,57 @@ struct libgamma_gamma_ramps16 {
 };
 
 
+/**
+ * One stop in interleaved 16-bit gamma ramps
+ * 
+ * The layout is identical to that of the
+ * Linux kernel's `struct drm_color_lut`
+ */
+struct libgamma_gamma_stop16 {
+	/**
+	 * The value for the red channel
+	 */
+	uint16_t red;
+
+	/**
+	 * The value for the green channel
+	 */
+	uint16_t green;
+
+	/**
+	 * The value for the blue channel
+	 */
+	uint16_t blue;
+
+	/**
+	 * Unused, should be 0
+	 */
+	uint16_t reserved;
+};
+
+
+/**
+ * Interleaved gamma ramp structure for 16-bit gamma ramps
+ * 
+ * Unlike `struct libgamma_gamma_ramps16`, all channels
+ * have the same size, and are stored in one array, with
+ * the red, green, and blue values of each stop next to
+ * each other, which is the layout that Linux DRM uses
+ * natively, so no conversion is required for it
+ */
+struct libgamma_gamma_ramps16_interleaved {
+	/**
+	 * The number of stops in `stops`
+	 */
+	size_t size;
+
+	/**
+	 * The stops of the gamma ramps
+	 */
+	struct libgamma_gamma_stop16 *stops;
+};
+
+
 /**
  * Gamma ramp structure for 32-bit gamma ramps
  */
@@ -1734,107 +1989,693 @@ struct libgamma_gamma_rampsd {
 
 
 /**
- * Mapping function from [0, 1] float encoding value to [0, 2⁸ − 1] integer output value
+ * Gamma ramps that have been prepared, with
+ * `libgamma_crtc_prepare_gamma_ramps8` or one
+ * of its siblings, for fast application with
+ * `libgamma_crtc_apply_prepared`
  * 
- * @param   encoding  [0, 1] float encoding value
- * @return            [0, 2⁸ − 1] integer output value
+ * The gamma ramps are stored in the adjustment
+ * method's native depth, so that they can be
+ * applied without any allocation or conversion
  */
-typedef uint8_t libgamma_gamma_ramps8_fun(float);
+struct libgamma_prepared_ramps {
+	/**
+	 * The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+	 */
+	signed depth;
 
-/**
- * Mapping function from [0, 1] float encoding value to [0, 2¹⁶ − 1] integer output value
- * 
- * @param   encoding  [0, 1] float encoding value
- * @return            [0, 2¹⁶ − 1] integer output value
- */
-typedef uint16_t libgamma_gamma_ramps16_fun(float);
+	/**
+	 * The size of `red`
+	 */
+	size_t red_size;
 
-/**
- * Mapping function from [0, 1] float encoding value to [0, 2³² − 1] integer output value
- * 
- * @param   encoding  [0, 1] float encoding value
- * @return            [0, 2³² − 1] integer output value
- */
-typedef uint32_t libgamma_gamma_ramps32_fun(float);
+	/**
+	 * The size of `green`
+	 */
+	size_t green_size;
 
-/**
- * Mapping function from [0, 1] float encoding value to [0, 2⁶⁴ − 1] integer output value
- * 
- * @param   encoding  [0, 1] float encoding value
- * @return            [0, 2⁶⁴ − 1] integer output value
- */
-typedef uint64_t libgamma_gamma_ramps64_fun(float);
+	/**
+	 * The size of `blue`
+	 */
+	size_t blue_size;
 
-/**
- * Mapping function from [0, 1] float encoding value to [0, 1] float output value
- * 
- * @param   encoding  [0, 1] float encoding value
- * @return            [0, 1] float output value
- */
-typedef float libgamma_gamma_rampsf_fun(float);
+	/**
+	 * The gamma ramp for the red channel, the element type depends on `depth`
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	void *red;
 
-/**
- * Mapping function from [0, 1] double precision float encoding
- * value to [0, 1] double precision float output value
- * 
- * @param   encoding  [0, 1] float encoding value
- * @return            [0, 1] float output value
- */
-typedef double libgamma_gamma_rampsd_fun(double);
+	/**
+	 * The gamma ramp for the green channel, the element type depends on `depth`
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	void *green;
 
+	/**
+	 * The gamma ramp for the blue channel, the element type depends on `depth`
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	void *blue;
+};
 
 
-/**
- * Prints an error to stderr in a `perror` fashion
- * 
- * @param  name        The text to add at the beginning
- * @param  error_code  The error code, may be an `errno` value
- */
-LIBGAMMA_GCC_ONLY__(__attribute__((__access__(__read_only__, 1))))
-void libgamma_perror(const char *, int);
+struct libgamma_crtc_request;
 
 /**
- * Get a description of an error
+ * Function that is called when a request submitted with
+ * `libgamma_crtc_get_gamma_ramps16_async` or
+ * `libgamma_crtc_set_gamma_ramps16_async` completes
  * 
- * @param   error_code  The error code, may be an `errno` value, if
- *                      `LIBGAMMA_ERRNO_SET`, the current value of `errno`
- *                      will be used
- * @return              The description associated with the error code,
- *                      `NULL` if the error code is not recognised
+ * @param  request  The request, it may be reused or
+ *                  deallocated by the function
+ * @param  result   Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library
+ * @param  user     The user data passed along with the request
  */
-LIBGAMMA_GCC_ONLY__(__attribute__((__warn_unused_result__)))
-const char *libgamma_strerror(int);
+typedef void libgamma_crtc_request_callback_fun(struct libgamma_crtc_request *, int, void *);
 
 /**
- * Get a description of an error
+ * A gamma ramp request submitted with
+ * `libgamma_crtc_submit_get_gamma_ramps16`,
+ * `libgamma_crtc_submit_set_gamma_ramps16`,
+ * `libgamma_crtc_get_gamma_ramps16_async`, or
+ * `libgamma_crtc_set_gamma_ramps16_async`
  * 
- * @param   error_code  The error code, may be an `errno` value, if
- *                      `LIBGAMMA_ERRNO_SET`, the current value of `errno`
- *                      will be used
- * @param   buf         Buffer that shall be used if a description must be generated
- * @param   bufsize     The size of `buf`, 1024 is recommended
- * @return              The description associated with the error code;
- *                      can only be `NULL` if `buf` is `NULL`. If the buffer
- *                      is insufficient, a truncated but NUL-terminated
- *                      description is returned and `errno` is set to `ERANGE`;
- *                      `errno` is otherwise unmodified
+ * The request is finished once `libgamma_crtc_complete_request`
+ * has returned anything but `LIBGAMMA_ERRNO_SET` with `errno`
+ * set to `EAGAIN`, or once `libgamma_crtc_discard_request`
+ * has been called
  */
-LIBGAMMA_GCC_ONLY__(__attribute__((__warn_unused_result__, __access__(__write_only__, 2, 3))))
-const char *libgamma_strerror_r(int, char[], size_t);
+struct libgamma_crtc_request {
+	/**
+	 * The CRTC the request was submitted for
+	 */
+	struct libgamma_crtc_state *crtc;
 
-/**
- * Get the name of the definition associated with a `libgamma` error code
- * 
- * @param   value  The error code
- * @return         The name of the definition associated with the error code,
- *                 `NULL` if the error code does not exist
- */
-LIBGAMMA_GCC_ONLY__(__attribute__((__warn_unused_result__, __const__)))
-const char *libgamma_name_of_error(int);
+	/**
+	 * The gamma ramps that are filled in when the request
+	 * completes, `NULL` if the request sets the gamma ramps
+	 */
+	struct libgamma_gamma_ramps16 *ramps;
 
-/**
- * Get the value of a `libgamma` error definition referred to by name
- * 
+	/**
+	 * Whether the request is still waiting for the display server
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	int pending;
+
+	/**
+	 * The return value of the request, if it was
+	 * carried out immediately when it was submitted
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	int result;
+
+	/**
+	 * The value of `errno` after the request, if it was
+	 * carried out immediately when it was submitted
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	int error;
+
+	/**
+	 * Adjustment method implementation specific data
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	unsigned long long int data[2];
+
+	/**
+	 * The function to call when the request completes,
+	 * `NULL` if the request was not submitted asynchronously
+	 */
+	libgamma_crtc_request_callback_fun *callback;
+
+	/**
+	 * User data for `callback`
+	 */
+	void *user;
+
+	/**
+	 * The next request in the site's queue of requests
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	struct libgamma_crtc_request *next;
+};
+
+
+/**
+ * Gamma ramps staged in a transaction for one CRTC
+ * 
+ * You as a user of this library should not touch this
+ */
+struct libgamma_transaction_entry {
+	/**
+	 * The CRTC to apply the gamma ramps to
+	 */
+	struct libgamma_crtc_state *crtc;
+
+	/**
+	 * The index in the transaction's arena of the first
+	 * stop of the red channel, the other channels follow
+	 */
+	size_t offset;
+
+	/**
+	 * The size of the red channel
+	 */
+	size_t red_size;
+
+	/**
+	 * The size of the green channel
+	 */
+	size_t green_size;
+
+	/**
+	 * The size of the blue channel
+	 */
+	size_t blue_size;
+};
+
+
+/**
+ * Gamma ramps for multiple CRTC:s in a site, that
+ * are staged so that they can be applied together
+ * 
+ * Initialise with `libgamma_transaction_initialise`,
+ * stage gamma ramps with `libgamma_transaction_set_gamma_ramps16`,
+ * and apply them with `libgamma_transaction_commit`
+ */
+struct libgamma_transaction {
+	/**
+	 * The site the CRTC:s belong to
+	 */
+	struct libgamma_site_state *site;
+
+	/**
+	 * The number of CRTC:s with staged gamma ramps
+	 */
+	size_t count;
+
+	/**
+	 * The staged gamma ramps
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	struct libgamma_transaction_entry *entries;
+
+	/**
+	 * The allocation size of `entries`, in elements
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t entries_size;
+
+	/**
+	 * Memory shared by all staged gamma ramps
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	uint16_t *arena;
+
+	/**
+	 * The number of elements used in `arena`
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t arena_used;
+
+	/**
+	 * The allocation size of `arena`, in elements
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	size_t arena_size;
+};
+
+
+/**
+ * A gradual change of a CRTC's gamma ramps from
+ * one set of prepared gamma ramps to another
+ * 
+ * Initialise with `libgamma_transition_initialise`,
+ * and call `libgamma_transition_step` each time the
+ * file descriptor returned by `libgamma_transition_get_fd`
+ * becomes readable, or after the delay it outputs
+ */
+struct libgamma_transition {
+	/**
+	 * The CRTC whose gamma ramps are changed
+	 */
+	struct libgamma_crtc_state *crtc;
+
+	/**
+	 * The gamma ramps at the beginning of the transition,
+	 * they must not be destroyed before the transition
+	 */
+	const struct libgamma_prepared_ramps *from;
+
+	/**
+	 * The gamma ramps at the end of the transition,
+	 * they must not be destroyed before the transition
+	 */
+	const struct libgamma_prepared_ramps *to;
+
+	/**
+	 * The duration of the transition, in milliseconds
+	 */
+	unsigned long int duration;
+
+	/**
+	 * The number of milliseconds between frames
+	 * 
+	 * `libgamma_transition_initialise` sets this to the
+	 * refresh period of the CRTC's mode if the adjustment
+	 * method can report it (Linux DRM and X RandR), and
+	 * otherwise to 16 (about 60 frames per second); it
+	 * may be increased to apply fewer frames
+	 */
+	unsigned long int frame_interval;
+
+	/**
+	 * The time, in milliseconds on the monotonic
+	 * clock, when the transition began
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	unsigned long long int start_time;
+
+	/**
+	 * The frame that is being applied, allocated
+	 * in the same depth as `from` and `to`
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	struct libgamma_prepared_ramps frame;
+
+	/**
+	 * File descriptor returned by `libgamma_transition_get_fd`,
+	 * -1 if it has not been created
+	 * 
+	 * You as a user of this library should not touch this
+	 */
+	int timer_fd;
+};
+
+
+/**
+ * Operations that are counted and timed
+ * in `struct libgamma_operation_stats`
+ */
+enum libgamma_stats_operation {
+	/**
+	 * Initialisation of sites, partitions and CRTC:s
+	 */
+	LIBGAMMA_STATS_INITIALISE = 0,
+
+	/**
+	 * Reading of information about CRTC:s
+	 */
+	LIBGAMMA_STATS_GET_INFORMATION,
+
+	/**
+	 * Reading of gamma ramps
+	 */
+	LIBGAMMA_STATS_GET_GAMMA,
+
+	/**
+	 * Writing of gamma ramps
+	 */
+	LIBGAMMA_STATS_SET_GAMMA
+};
+
+/**
+ * The number of values defined in `enum libgamma_stats_operation`
+ * in the version of the library the program is compiled against
+ * 
+ * This value is not affected by the version of the library the program
+ * is linked against, it is however used when compiling the library
+ */
+#define LIBGAMMA_STATS_OPERATION_COUNT 4
+
+/**
+ * The number of buckets in the latency histograms in
+ * `struct libgamma_operation_stats`
+ */
+#define LIBGAMMA_STATS_LATENCY_BUCKETS 32
+
+
+/**
+ * Statistics for one operation with one adjustment method
+ * 
+ * Only the time spent in the adjustment method is measured,
+ * that is, the time spent waiting for the display server
+ * or the kernel, and not the time the library spends
+ * converting gamma ramps between depths
+ */
+struct libgamma_operation_stats {
+	/**
+	 * The number of calls to the adjustment method
+	 */
+	uint64_t calls;
+
+	/**
+	 * The number of calls that failed, for
+	 * `LIBGAMMA_STATS_GET_INFORMATION` the number of
+	 * calls where at least one requested field could
+	 * not be read
+	 */
+	uint64_t errors;
+
+	/**
+	 * The sum of the latencies of the calls, in nanoseconds
+	 */
+	uint64_t total_time;
+
+	/**
+	 * Histogram of the latencies of the calls, element `i` is the number
+	 * of calls that took at least 2 to the power of `i` nanoseconds, but
+	 * less than 2 to the power of `i + 1` nanoseconds; except that
+	 * the first element also counts calls that took less than
+	 * 1 nanosecond, and the last element counts all calls that
+	 * took 2 to the power of `LIBGAMMA_STATS_LATENCY_BUCKETS - 1`
+	 * nanoseconds or longer
+	 */
+	uint64_t latency_histogram[LIBGAMMA_STATS_LATENCY_BUCKETS];
+};
+
+
+/**
+ * Statistics for one adjustment method
+ */
+struct libgamma_method_stats {
+	/**
+	 * Statistics for each operation, indexed by
+	 * `enum libgamma_stats_operation`
+	 */
+	struct libgamma_operation_stats operations[LIBGAMMA_STATS_OPERATION_COUNT];
+
+	/**
+	 * The number of bytes of gamma ramps the library has converted between
+	 * the depth used by the user and the depth used by the adjustment method
+	 */
+	uint64_t translated_bytes;
+
+	/**
+	 * The number of memory allocations the library has made for gamma ramps,
+	 * allocations made by the adjustment method are not included
+	 */
+	uint64_t allocations;
+
+	/**
+	 * The number of errors reported by the display server or the kernel
+	 * that the adjustment method ignored, for example because the gamma
+	 * ramps cannot be changed while another process is the DRM master
+	 */
+	uint64_t ignored_errors;
+};
+
+
+/**
+ * Runtime statistics, collected after
+ * `libgamma_stats_enable` has been called,
+ * and retrieved with `libgamma_stats_get`
+ */
+struct libgamma_stats {
+	/**
+	 * Statistics for each adjustment method,
+	 * indexed by the adjustment method
+	 */
+	struct libgamma_method_stats methods[LIBGAMMA_METHOD_COUNT];
+};
+
+
+/**
+ * Parameters for generating gamma ramps with
+ * `libgamma_gamma_ramps8_generate`, one of its
+ * siblings, or `libgamma_crtc_set_gamma_parametric`
+ * 
+ * Each channel's output value for an encoding
+ * value `x` is calculated by first applying the
+ * contrast, `(x − 1/2) ⋅ contrast + 1/2`, then
+ * the gamma, `x ^ (1 / gamma)`, then the brightness,
+ * `min + x ⋅ (max − min)`, and last the whitepoint;
+ * after the contrast and after the whitepoint
+ * the value is clamped to [0, 1]
+ * 
+ * Use `libgamma_gamma_ramp_parameters_initialise`
+ * to initialise the parameters to the identity
+ */
+struct libgamma_gamma_ramp_parameters {
+	/**
+	 * The gamma of the red channel, must be positive; 1 for no adjustment
+	 */
+	double red_gamma;
+
+	/**
+	 * The gamma of the green channel, must be positive; 1 for no adjustment
+	 */
+	double green_gamma;
+
+	/**
+	 * The gamma of the blue channel, must be positive; 1 for no adjustment
+	 */
+	double blue_gamma;
+
+	/**
+	 * The contrast of the red channel; 1 for no adjustment
+	 */
+	double red_contrast;
+
+	/**
+	 * The contrast of the green channel; 1 for no adjustment
+	 */
+	double green_contrast;
+
+	/**
+	 * The contrast of the blue channel; 1 for no adjustment
+	 */
+	double blue_contrast;
+
+	/**
+	 * The output value of the red channel for the lowest
+	 * encoding value; 0 for no adjustment
+	 */
+	double red_min;
+
+	/**
+	 * The output value of the green channel for the lowest
+	 * encoding value; 0 for no adjustment
+	 */
+	double green_min;
+
+	/**
+	 * The output value of the blue channel for the lowest
+	 * encoding value; 0 for no adjustment
+	 */
+	double blue_min;
+
+	/**
+	 * The output value of the red channel for the highest
+	 * encoding value; 1 for no adjustment
+	 */
+	double red_max;
+
+	/**
+	 * The output value of the green channel for the highest
+	 * encoding value; 1 for no adjustment
+	 */
+	double green_max;
+
+	/**
+	 * The output value of the blue channel for the highest
+	 * encoding value; 1 for no adjustment
+	 */
+	double blue_max;
+
+	/**
+	 * The colour temperature of the whitepoint, in Kelvin;
+	 * 0 (or 6500) for no adjustment
+	 * 
+	 * The whitepoint is approximated for temperatures
+	 * in [1000, 40000], temperatures outside this range
+	 * are clamped into it; 6500 K yields a neutral
+	 * whitepoint, and the channels are scaled so that
+	 * the strongest channel is not dimmed
+	 */
+	double temperature;
+};
+
+
+/**
+ * Mapping function from [0, 1] float encoding value to [0, 2⁸ − 1] integer output value
+ * 
+ * @param   encoding  [0, 1] float encoding value
+ * @return            [0, 2⁸ − 1] integer output value
+ */
+typedef uint8_t libgamma_gamma_ramps8_fun(float);
+
+/**
+ * Mapping function from [0, 1] float encoding value to [0, 2¹⁶ − 1] integer output value
+ * 
+ * @param   encoding  [0, 1] float encoding value
+ * @return            [0, 2¹⁶ − 1] integer output value
+ */
+typedef uint16_t libgamma_gamma_ramps16_fun(float);
+
+/**
+ * Mapping function from [0, 1] float encoding value to [0, 2³² − 1] integer output value
+ * 
+ * @param   encoding  [0, 1] float encoding value
+ * @return            [0, 2³² − 1] integer output value
+ */
+typedef uint32_t libgamma_gamma_ramps32_fun(float);
+
+/**
+ * Mapping function from [0, 1] float encoding value to [0, 2⁶⁴ − 1] integer output value
+ * 
+ * @param   encoding  [0, 1] float encoding value
+ * @return            [0, 2⁶⁴ − 1] integer output value
+ */
+typedef uint64_t libgamma_gamma_ramps64_fun(float);
+
+/**
+ * Mapping function from [0, 1] float encoding value to [0, 1] float output value
+ * 
+ * @param   encoding  [0, 1] float encoding value
+ * @return            [0, 1] float output value
+ */
+typedef float libgamma_gamma_rampsf_fun(float);
+
+/**
+ * Mapping function from [0, 1] double precision float encoding
+ * value to [0, 1] double precision float output value
+ * 
+ * @param   encoding  [0, 1] float encoding value
+ * @return            [0, 1] float output value
+ */
+typedef double libgamma_gamma_rampsd_fun(double);
+
+/**
+ * Batch mapping function from [0, 1] float encoding values to [0, 2⁸ − 1] integer output values
+ * 
+ * @param  n          The number of stops to generate
+ * @param  encodings  The [0, 1] float encoding values, `n` ascending values
+ *                    evenly spaced from 0 to 1 (inclusively)
+ * @param  output     Output parameter for the [0, 2⁸ − 1] integer output values, `n` elements
+ */
+typedef void libgamma_gamma_ramps8_batch_fun(size_t, const float *restrict, uint8_t *restrict);
+
+/**
+ * Batch mapping function from [0, 1] float encoding values to [0, 2¹⁶ − 1] integer output values
+ * 
+ * @param  n          The number of stops to generate
+ * @param  encodings  The [0, 1] float encoding values, `n` ascending values
+ *                    evenly spaced from 0 to 1 (inclusively)
+ * @param  output     Output parameter for the [0, 2¹⁶ − 1] integer output values, `n` elements
+ */
+typedef void libgamma_gamma_ramps16_batch_fun(size_t, const float *restrict, uint16_t *restrict);
+
+/**
+ * Batch mapping function from [0, 1] float encoding values to [0, 2³² − 1] integer output values
+ * 
+ * @param  n          The number of stops to generate
+ * @param  encodings  The [0, 1] float encoding values, `n` ascending values
+ *                    evenly spaced from 0 to 1 (inclusively)
+ * @param  output     Output parameter for the [0, 2³² − 1] integer output values, `n` elements
+ */
+typedef void libgamma_gamma_ramps32_batch_fun(size_t, const float *restrict, uint32_t *restrict);
+
+/**
+ * Batch mapping function from [0, 1] float encoding values to [0, 2⁶⁴ − 1] integer output values
+ * 
+ * @param  n          The number of stops to generate
+ * @param  encodings  The [0, 1] float encoding values, `n` ascending values
+ *                    evenly spaced from 0 to 1 (inclusively)
+ * @param  output     Output parameter for the [0, 2⁶⁴ − 1] integer output values, `n` elements
+ */
+typedef void libgamma_gamma_ramps64_batch_fun(size_t, const float *restrict, uint64_t *restrict);
+
+/**
+ * Batch mapping function from [0, 1] float encoding values to [0, 1] float output values
+ * 
+ * @param  n          The number of stops to generate
+ * @param  encodings  The [0, 1] float encoding values, `n` ascending values
+ *                    evenly spaced from 0 to 1 (inclusively)
+ * @param  output     Output parameter for the [0, 1] float output values, `n` elements
+ */
+typedef void libgamma_gamma_rampsf_batch_fun(size_t, const float *restrict, float *restrict);
+
+/**
+ * Batch mapping function from [0, 1] double precision float encoding values to [0, 1] double precision float output values
+ * 
+ * @param  n          The number of stops to generate
+ * @param  encodings  The [0, 1] double precision float encoding values, `n` ascending values
+ *                    evenly spaced from 0 to 1 (inclusively)
+ * @param  output     Output parameter for the [0, 1] float output values, `n` elements
+ */
+typedef void libgamma_gamma_rampsd_batch_fun(size_t, const double *restrict, double *restrict);
+
+
+
+/**
+ * Prints an error to stderr in a `perror` fashion
+ * 
+ * @param  name        The text to add at the beginning
+ * @param  error_code  The error code, may be an `errno` value
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__access__(__read_only__, 1))))
+void libgamma_perror(const char *, int);
+
+/**
+ * Get a description of an error
+ * 
+ * @param   error_code  The error code, may be an `errno` value, if
+ *                      `LIBGAMMA_ERRNO_SET`, the current value of `errno`
+ *                      will be used
+ * @return              The description associated with the error code,
+ *                      `NULL` if the error code is not recognised
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__warn_unused_result__)))
+const char *libgamma_strerror(int);
+
+/**
+ * Get a description of an error
+ * 
+ * @param   error_code  The error code, may be an `errno` value, if
+ *                      `LIBGAMMA_ERRNO_SET`, the current value of `errno`
+ *                      will be used
+ * @param   buf         Buffer that shall be used if a description must be generated
+ * @param   bufsize     The size of `buf`, 1024 is recommended
+ * @return              The description associated with the error code;
+ *                      can only be `NULL` if `buf` is `NULL`. If the buffer
+ *                      is insufficient, a truncated but NUL-terminated
+ *                      description is returned and `errno` is set to `ERANGE`;
+ *                      `errno` is otherwise unmodified
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__warn_unused_result__, __access__(__write_only__, 2, 3))))
+const char *libgamma_strerror_r(int, char[], size_t);
+
+/**
+ * Get the name of the definition associated with a `libgamma` error code
+ * 
+ * @param   value  The error code
+ * @return         The name of the definition associated with the error code,
+ *                 `NULL` if the error code does not exist
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__warn_unused_result__, __const__)))
+const char *libgamma_name_of_error(int);
+
+/**
+ * Get the value of a `libgamma` error definition referred to by name
+ * 
  * @param   name  The name of the definition associated with the error code
  * @return        The error code, zero if the name is `NULL`
  *                or does not refer to a `libgamma` error
@@ -2235,6 +3076,118 @@ LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
 void libgamma_gamma_rampsd_free(struct libgamma_gamma_rampsd *restrict);
 
 
+/**
+ * Initialise gamma ramp parameters to the identity,
+ * that is, parameters that do not adjust anything
+ * 
+ * @param  this  The gamma ramp parameters
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_gamma_ramp_parameters_initialise(struct libgamma_gamma_ramp_parameters *restrict);
+
+/**
+ * Fill gamma ramps from parameters, 8-bit gamma-depth version
+ * 
+ * The gamma ramps are calculated directly in their depth,
+ * without any callback function or intermediate conversion
+ * 
+ * @param   this    The gamma ramps, must have been initialised, for example
+ *                  with `libgamma_gamma_ramps8_initialise`
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library; `EINVAL`
+ *                  if the parameters are invalid
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 2))))
+int libgamma_gamma_ramps8_generate(struct libgamma_gamma_ramps8 *restrict,
+                                   const struct libgamma_gamma_ramp_parameters *restrict);
+
+/**
+ * Fill gamma ramps from parameters, 16-bit gamma-depth version
+ * 
+ * The gamma ramps are calculated directly in their depth,
+ * without any callback function or intermediate conversion
+ * 
+ * @param   this    The gamma ramps, must have been initialised, for example
+ *                  with `libgamma_gamma_ramps16_initialise`
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library; `EINVAL`
+ *                  if the parameters are invalid
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 2))))
+int libgamma_gamma_ramps16_generate(struct libgamma_gamma_ramps16 *restrict,
+                                    const struct libgamma_gamma_ramp_parameters *restrict);
+
+/**
+ * Fill gamma ramps from parameters, 32-bit gamma-depth version
+ * 
+ * The gamma ramps are calculated directly in their depth,
+ * without any callback function or intermediate conversion
+ * 
+ * @param   this    The gamma ramps, must have been initialised, for example
+ *                  with `libgamma_gamma_ramps32_initialise`
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library; `EINVAL`
+ *                  if the parameters are invalid
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 2))))
+int libgamma_gamma_ramps32_generate(struct libgamma_gamma_ramps32 *restrict,
+                                    const struct libgamma_gamma_ramp_parameters *restrict);
+
+/**
+ * Fill gamma ramps from parameters, 64-bit gamma-depth version
+ * 
+ * The gamma ramps are calculated directly in their depth,
+ * without any callback function or intermediate conversion
+ * 
+ * @param   this    The gamma ramps, must have been initialised, for example
+ *                  with `libgamma_gamma_ramps64_initialise`
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library; `EINVAL`
+ *                  if the parameters are invalid
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 2))))
+int libgamma_gamma_ramps64_generate(struct libgamma_gamma_ramps64 *restrict,
+                                    const struct libgamma_gamma_ramp_parameters *restrict);
+
+/**
+ * Fill gamma ramps from parameters, `float` version
+ * 
+ * The gamma ramps are calculated directly in their depth,
+ * without any callback function or intermediate conversion
+ * 
+ * @param   this    The gamma ramps, must have been initialised, for example
+ *                  with `libgamma_gamma_rampsf_initialise`
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library; `EINVAL`
+ *                  if the parameters are invalid
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 2))))
+int libgamma_gamma_rampsf_generate(struct libgamma_gamma_rampsf *restrict,
+                                   const struct libgamma_gamma_ramp_parameters *restrict);
+
+/**
+ * Fill gamma ramps from parameters, `double` version
+ * 
+ * The gamma ramps are calculated directly in their depth,
+ * without any callback function or intermediate conversion
+ * 
+ * @param   this    The gamma ramps, must have been initialised, for example
+ *                  with `libgamma_gamma_rampsd_initialise`
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library; `EINVAL`
+ *                  if the parameters are invalid
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 2))))
+int libgamma_gamma_rampsd_generate(struct libgamma_gamma_rampsd *restrict,
+                                   const struct libgamma_gamma_ramp_parameters *restrict);
+
+
 
 /**
  * List available adjustment methods by their order of preference based on the environment
@@ -2343,6 +3296,94 @@ libgamma_site_free(struct libgamma_site_state *restrict this__)
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
 int libgamma_site_restore(struct libgamma_site_state *restrict);
 
+/**
+ * Get a file descriptor that becomes readable when the configuration
+ * of a site changes, for example because a monitor has been plugged
+ * in or unplugged; when it is readable, `libgamma_site_process_events`
+ * shall be called
+ * 
+ * The file descriptor is owned by the site state, it must not
+ * be read from or closed, and it is only valid until the site
+ * state is destroyed; with X RandR it is the file descriptor of
+ * the connection to the display server, and notifications may
+ * be read from it by other functions in the library, so
+ * `libgamma_site_process_events` should also be called before
+ * the file descriptor is waited on
+ * 
+ * @param   this  The site state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library; `errno` is
+ *                set to `ENOTSUP` if the adjustment method does not
+ *                support configuration change notifications
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_site_get_event_fd(struct libgamma_site_state *restrict, int *restrict);
+
+/**
+ * Process all pending configuration change events for a
+ * site, without blocking, and refresh the cached data for
+ * the partitions whose configuration has changed
+ * 
+ * The `generation` of each changed partition is incremented,
+ * which makes CRTC states in the partition discard the
+ * information they have cached; if the set of CRTC:s in a
+ * partition has changed, the partition must be reinitialised,
+ * this is reported by `errno` being set to `ESTALE`
+ * 
+ * @param   this  The site state, `libgamma_site_get_event_fd`
+ *                must have been called on it
+ * @return        1 if the configuration of at least one partition has
+ *                changed, 0 otherwise, or (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_site_process_events(struct libgamma_site_state *restrict);
+
+/**
+ * Get a file descriptor that becomes readable when requests
+ * submitted with `libgamma_crtc_get_gamma_ramps16_async` or
+ * `libgamma_crtc_set_gamma_ramps16_async` for CRTC:s in
+ * a site may have completed; when it is readable,
+ * `libgamma_site_dispatch_requests` shall be called
+ * 
+ * The file descriptor is owned by the site state, it must not
+ * be read from or closed, and it is only valid until the site
+ * state is destroyed; with X RandR it is the file descriptor of
+ * the connection to the display server, and replies may be read
+ * from it by other functions in the library, so
+ * `libgamma_site_dispatch_requests` should also be called before
+ * the file descriptor is waited on, and the file descriptor must
+ * not be waited on after a call that returned non-zero, as the
+ * callback functions may have caused replies to be read, so it
+ * shall be called again until it returns zero; with other
+ * adjustment methods it is an eventfd, which is only available
+ * on Linux
+ * 
+ * @param   this  The site state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_site_get_request_fd(struct libgamma_site_state *restrict, int *restrict);
+
+/**
+ * Call the callback functions for all requests, submitted with
+ * `libgamma_crtc_get_gamma_ramps16_async` or
+ * `libgamma_crtc_set_gamma_ramps16_async` for CRTC:s in a site,
+ * that have completed, without blocking
+ * 
+ * The callback functions may submit new requests, but
+ * must not discard requests other than their own; requests
+ * they submit are not dispatched until the next call
+ * 
+ * @param   this  The site state
+ * @return        The number of callback functions called
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+size_t libgamma_site_dispatch_requests(struct libgamma_site_state *restrict);
+
 
 
 /**
@@ -2389,6 +3430,59 @@ libgamma_partition_free(struct libgamma_partition_state *restrict this__)
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
 int libgamma_partition_restore(struct libgamma_partition_state *restrict);
 
+/**
+ * Start deferring gamma ramp updates for the CRTC:s in a partition,
+ * so that they can be applied together with `libgamma_partition_commit_updates`
+ * 
+ * Adjustment methods that can apply gamma ramps to multiple
+ * CRTC:s atomically (Linux DRM with atomic modesetting, which
+ * applies them in one commit per graphics card, so that all
+ * CRTC:s are updated on the same frame) will hold back the
+ * gamma ramps set with `libgamma_crtc_set_gamma_ramps16` and
+ * its siblings until `libgamma_partition_commit_updates` is
+ * called; other adjustment methods apply them immediately,
+ * as usual. Reading the gamma ramps of a CRTC does not return
+ * gamma ramps that have been held back
+ * 
+ * @param   this  The partition state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+int libgamma_partition_defer_updates(struct libgamma_partition_state *restrict);
+
+/**
+ * Apply all gamma ramp updates that have been held back since
+ * `libgamma_partition_defer_updates` was called, and stop deferring
+ * gamma ramp updates
+ * 
+ * @param   this  The partition state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+int libgamma_partition_commit_updates(struct libgamma_partition_state *restrict);
+
+/**
+ * Get the file descriptor of the connection to the display
+ * server or graphics card that a partition uses, so that
+ * requests submitted with `libgamma_crtc_submit_get_gamma_ramps16`
+ * and `libgamma_crtc_submit_set_gamma_ramps16` can be
+ * waited upon in an event loop
+ * 
+ * The file descriptor is owned by the site state or the
+ * partition state, and must not be read from or closed
+ * 
+ * @param   this  The partition state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library; `errno` is
+ *                set to `ENOTSUP` if the adjustment method does not
+ *                use a file descriptor
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_partition_get_fd(struct libgamma_partition_state *restrict, int *restrict);
+
 
 
 /**
@@ -2425,9 +3519,25 @@ libgamma_crtc_free(struct libgamma_crtc_state *restrict this__)
 	free(this__);
 }
 
+/**
+ * Forget cached information about a CRTC, such as its gamma ramp sizes
+ * and the gamma ramps it last applied or read
+ * 
+ * This is done automatically when applying gamma ramps fails, but
+ * should be done manually if you know that the CRTC has changed,
+ * for example because a monitor has been plugged in
+ * 
+ * @param  this  The CRTC state
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_crtc_invalidate_cache(struct libgamma_crtc_state *restrict);
+
 /**
  * Restore the gamma ramps for a CRTC to the system settings for that CRTC
  * 
+ * For Linux DRM, which does not have any system settings, these are
+ * the gamma ramps the CRTC had before libgamma first changed them
+ * 
  * @param   this  The CRTC state
  * @return        Zero on success, otherwise (negative) the value of an
  *                error identifier provided by this library
@@ -2563,6 +3673,33 @@ int libgamma_crtc_set_gamma_ramps8_f(struct libgamma_crtc_state *restrict, libga
                                      libgamma_gamma_ramps8_fun *, libgamma_gamma_ramps8_fun *);
 
 
+/**
+ * Set the gamma ramps for a CRTC, 8-bit gamma-depth batch function version
+ * 
+ * Unlike `libgamma_crtc_set_gamma_ramps8_f`, the functions are called
+ * once per channel, rather than once per stop, and receive all encoding
+ * values at once, letting them use vectorised arithmetic
+ * 
+ * Note that this will probably involve the library allocating temporary data
+ * 
+ * @param   this            The CRTC state
+ * @param   red_function    The function that generates the gamma ramp for the red channel
+ * @param   green_function  The function that generates the gamma ramp for the green channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @param   blue_function   The function that generates the gamma ramp for the blue channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @return                  Zero on success, otherwise (negative) the value of an
+ *                          error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__(1, 2))))
+int libgamma_crtc_set_gamma_ramps8_fb(struct libgamma_crtc_state *restrict, libgamma_gamma_ramps8_batch_fun *,
+                                      libgamma_gamma_ramps8_batch_fun *, libgamma_gamma_ramps8_batch_fun *);
+
+
 /**
  * Get the current gamma ramps for a CRTC, 16-bit gamma-depth version
  * 
@@ -2602,6 +3739,191 @@ int libgamma_crtc_set_gamma_ramps16_f(struct libgamma_crtc_state *restrict, libg
                                       libgamma_gamma_ramps16_fun *, libgamma_gamma_ramps16_fun *);
 
 
+/**
+ * Set the gamma ramps for a CRTC, 16-bit gamma-depth batch function version
+ * 
+ * Unlike `libgamma_crtc_set_gamma_ramps16_f`, the functions are called
+ * once per channel, rather than once per stop, and receive all encoding
+ * values at once, letting them use vectorised arithmetic
+ * 
+ * Note that this will probably involve the library allocating temporary data
+ * 
+ * @param   this            The CRTC state
+ * @param   red_function    The function that generates the gamma ramp for the red channel
+ * @param   green_function  The function that generates the gamma ramp for the green channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @param   blue_function   The function that generates the gamma ramp for the blue channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @return                  Zero on success, otherwise (negative) the value of an
+ *                          error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__(1, 2))))
+int libgamma_crtc_set_gamma_ramps16_fb(struct libgamma_crtc_state *restrict, libgamma_gamma_ramps16_batch_fun *,
+                                       libgamma_gamma_ramps16_batch_fun *, libgamma_gamma_ramps16_batch_fun *);
+
+
+/**
+ * Get the current gamma ramps for a CRTC, interleaved 16-bit gamma-depth version
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to fill with the current values,
+ *                 `ramps->size` must be set to the CRTC's gamma ramp
+ *                 size, which must be the same for all channels
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+int libgamma_crtc_get_gamma_ramps16_interleaved(struct libgamma_crtc_state *restrict,
+                                                struct libgamma_gamma_ramps16_interleaved *restrict);
+
+/**
+ * Set the gamma ramps for a CRTC, interleaved 16-bit gamma-depth version
+ * 
+ * With Linux DRM and atomic modesetting, the gamma ramps
+ * are uploaded directly from `ramps->stops`, without copying
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to apply
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 2))))
+int libgamma_crtc_set_gamma_ramps16_interleaved(struct libgamma_crtc_state *restrict,
+                                                const struct libgamma_gamma_ramps16_interleaved *restrict);
+
+/**
+ * Submit a request to get the current gamma ramps for a CRTC,
+ * 16-bit gamma-depth version, without waiting for a reply
+ * 
+ * With X RandR, the request is sent to the display server and
+ * `libgamma_crtc_complete_request` shall be called when the file
+ * descriptor returned by `libgamma_partition_get_fd` is readable;
+ * other adjustment methods carry out the request immediately,
+ * so this function blocks until it is done, which with X VidMode
+ * means waiting for a round trip to the display server
+ * 
+ * @param   request  Output parameter for the request
+ * @param   this     The CRTC state
+ * @param   ramps    The gamma ramps to fill with the current values
+ *                   when the request completes, must remain valid
+ *                   until then
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_crtc_submit_get_gamma_ramps16(struct libgamma_crtc_request *restrict, struct libgamma_crtc_state *restrict,
+                                           struct libgamma_gamma_ramps16 *restrict);
+
+/**
+ * Submit a request to set the gamma ramps for a CRTC,
+ * 16-bit gamma-depth version, without waiting for
+ * the display server to acknowledge it
+ * 
+ * With X RandR, the request is sent to the display server and
+ * `libgamma_crtc_complete_request` shall be called when the file
+ * descriptor returned by `libgamma_partition_get_fd` is readable;
+ * other adjustment methods carry out the request immediately,
+ * so this function blocks until it is done, which with X VidMode
+ * means waiting for a round trip to the display server
+ * 
+ * @param   request  Output parameter for the request
+ * @param   this     The CRTC state
+ * @param   ramps    The gamma ramps to apply, they are copied
+ *                   before the function returns
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 3), __warn_unused_result__)))
+int libgamma_crtc_submit_set_gamma_ramps16(struct libgamma_crtc_request *restrict, struct libgamma_crtc_state *restrict,
+                                           const struct libgamma_gamma_ramps16 *restrict);
+
+/**
+ * Complete a request submitted with `libgamma_crtc_submit_get_gamma_ramps16`
+ * or `libgamma_crtc_submit_set_gamma_ramps16`, without blocking
+ * 
+ * @param   request  The request
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library; if the
+ *                   reply has not arrived yet, `LIBGAMMA_ERRNO_SET` is
+ *                   returned with `errno` set to `EAGAIN`, and the
+ *                   function shall be called again later
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_crtc_complete_request(struct libgamma_crtc_request *restrict);
+
+/**
+ * Abandon a request submitted with `libgamma_crtc_submit_get_gamma_ramps16`,
+ * `libgamma_crtc_submit_set_gamma_ramps16`, `libgamma_crtc_get_gamma_ramps16_async`,
+ * or `libgamma_crtc_set_gamma_ramps16_async` that has not been completed
+ * 
+ * The request is still carried out, but its outcome is never reported
+ * 
+ * @param  request  The request
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_crtc_discard_request(struct libgamma_crtc_request *restrict);
+
+/**
+ * Get the current gamma ramps for a CRTC, 16-bit gamma-depth version,
+ * asynchronously; the callback function is called from
+ * `libgamma_site_dispatch_requests` once the request has completed
+ * 
+ * Requests for multiple CRTC:s are sent together, so that
+ * with X RandR they complete after a single round trip
+ * 
+ * Only X RandR carries out the request asynchronously; other
+ * adjustment methods carry it out before this function returns,
+ * and only defer the callback, so with X VidMode this function
+ * blocks for a round trip to the display server
+ * 
+ * @param   request   Output parameter for the request, must remain
+ *                    valid until the callback function is called
+ *                    or the request is discarded
+ * @param   this      The CRTC state
+ * @param   ramps     The gamma ramps to fill with the current values,
+ *                    must remain valid until the request completes
+ * @param   callback  The function to call when the request completes
+ * @param   user      User data for `callback`
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library, in which
+ *                    case `callback` will not be called
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__(1, 2, 3, 4), __warn_unused_result__)))
+int libgamma_crtc_get_gamma_ramps16_async(struct libgamma_crtc_request *restrict, struct libgamma_crtc_state *restrict,
+                                          struct libgamma_gamma_ramps16 *restrict, libgamma_crtc_request_callback_fun *, void *);
+
+/**
+ * Set the gamma ramps for a CRTC, 16-bit gamma-depth version,
+ * asynchronously; the callback function is called from
+ * `libgamma_site_dispatch_requests` once the request has completed
+ * 
+ * Only X RandR carries out the request asynchronously; other
+ * adjustment methods carry it out before this function returns,
+ * and only defer the callback, so with X VidMode this function
+ * blocks for a round trip to the display server
+ * 
+ * @param   request   Output parameter for the request, must remain
+ *                    valid until the callback function is called
+ *                    or the request is discarded
+ * @param   this      The CRTC state
+ * @param   ramps     The gamma ramps to apply, they are copied
+ *                    before the function returns
+ * @param   callback  The function to call when the request completes
+ * @param   user      User data for `callback`
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library, in which
+ *                    case `callback` will not be called
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__(1, 2, 3, 4), __access__(__read_only__, 3), __warn_unused_result__)))
+int libgamma_crtc_set_gamma_ramps16_async(struct libgamma_crtc_request *restrict, struct libgamma_crtc_state *restrict,
+                                          const struct libgamma_gamma_ramps16 *restrict,
+                                          libgamma_crtc_request_callback_fun *, void *);
+
+
 /**
  * Get the current gamma ramps for a CRTC, 32-bit gamma-depth version
  * 
@@ -2641,6 +3963,33 @@ int libgamma_crtc_set_gamma_ramps32_f(struct libgamma_crtc_state *restrict, libg
                                       libgamma_gamma_ramps32_fun *, libgamma_gamma_ramps32_fun *);
 
 
+/**
+ * Set the gamma ramps for a CRTC, 32-bit gamma-depth batch function version
+ * 
+ * Unlike `libgamma_crtc_set_gamma_ramps32_f`, the functions are called
+ * once per channel, rather than once per stop, and receive all encoding
+ * values at once, letting them use vectorised arithmetic
+ * 
+ * Note that this will probably involve the library allocating temporary data
+ * 
+ * @param   this            The CRTC state
+ * @param   red_function    The function that generates the gamma ramp for the red channel
+ * @param   green_function  The function that generates the gamma ramp for the green channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @param   blue_function   The function that generates the gamma ramp for the blue channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @return                  Zero on success, otherwise (negative) the value of an
+ *                          error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__(1, 2))))
+int libgamma_crtc_set_gamma_ramps32_fb(struct libgamma_crtc_state *restrict, libgamma_gamma_ramps32_batch_fun *,
+                                       libgamma_gamma_ramps32_batch_fun *, libgamma_gamma_ramps32_batch_fun *);
+
+
 /**
  * Get the current gamma ramps for a CRTC, 64-bit gamma-depth version
  * 
@@ -2680,6 +4029,33 @@ int libgamma_crtc_set_gamma_ramps64_f(struct libgamma_crtc_state *restrict, libg
                                       libgamma_gamma_ramps64_fun *, libgamma_gamma_ramps64_fun *);
 
 
+/**
+ * Set the gamma ramps for a CRTC, 64-bit gamma-depth batch function version
+ * 
+ * Unlike `libgamma_crtc_set_gamma_ramps64_f`, the functions are called
+ * once per channel, rather than once per stop, and receive all encoding
+ * values at once, letting them use vectorised arithmetic
+ * 
+ * Note that this will probably involve the library allocating temporary data
+ * 
+ * @param   this            The CRTC state
+ * @param   red_function    The function that generates the gamma ramp for the red channel
+ * @param   green_function  The function that generates the gamma ramp for the green channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @param   blue_function   The function that generates the gamma ramp for the blue channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @return                  Zero on success, otherwise (negative) the value of an
+ *                          error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__(1, 2))))
+int libgamma_crtc_set_gamma_ramps64_fb(struct libgamma_crtc_state *restrict, libgamma_gamma_ramps64_batch_fun *,
+                                       libgamma_gamma_ramps64_batch_fun *, libgamma_gamma_ramps64_batch_fun *);
+
+
 /**
  * Get the current gamma ramps for a CRTC, `float` version
  * 
@@ -2719,6 +4095,33 @@ int libgamma_crtc_set_gamma_rampsf_f(struct libgamma_crtc_state *restrict, libga
                                      libgamma_gamma_rampsf_fun *, libgamma_gamma_rampsf_fun *);
 
 
+/**
+ * Set the gamma ramps for a CRTC, `float` batch function version
+ * 
+ * Unlike `libgamma_crtc_set_gamma_rampsf_f`, the functions are called
+ * once per channel, rather than once per stop, and receive all encoding
+ * values at once, letting them use vectorised arithmetic
+ * 
+ * Note that this will probably involve the library allocating temporary data
+ * 
+ * @param   this            The CRTC state
+ * @param   red_function    The function that generates the gamma ramp for the red channel
+ * @param   green_function  The function that generates the gamma ramp for the green channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @param   blue_function   The function that generates the gamma ramp for the blue channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @return                  Zero on success, otherwise (negative) the value of an
+ *                          error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__(1, 2))))
+int libgamma_crtc_set_gamma_rampsf_fb(struct libgamma_crtc_state *restrict, libgamma_gamma_rampsf_batch_fun *,
+                                      libgamma_gamma_rampsf_batch_fun *, libgamma_gamma_rampsf_batch_fun *);
+
+
 /**
  * Get the current gamma ramps for a CRTC, `double` version
  * 
@@ -2758,6 +4161,369 @@ int libgamma_crtc_set_gamma_rampsd_f(struct libgamma_crtc_state *restrict, libga
                                      libgamma_gamma_rampsd_fun *, libgamma_gamma_rampsd_fun *);
 
 
+/**
+ * Set the gamma ramps for a CRTC, `double` batch function version
+ * 
+ * Unlike `libgamma_crtc_set_gamma_rampsd_f`, the functions are called
+ * once per channel, rather than once per stop, and receive all encoding
+ * values at once, letting them use vectorised arithmetic
+ * 
+ * Note that this will probably involve the library allocating temporary data
+ * 
+ * @param   this            The CRTC state
+ * @param   red_function    The function that generates the gamma ramp for the red channel
+ * @param   green_function  The function that generates the gamma ramp for the green channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @param   blue_function   The function that generates the gamma ramp for the blue channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @return                  Zero on success, otherwise (negative) the value of an
+ *                          error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__(1, 2))))
+int libgamma_crtc_set_gamma_rampsd_fb(struct libgamma_crtc_state *restrict, libgamma_gamma_rampsd_batch_fun *,
+                                      libgamma_gamma_rampsd_batch_fun *, libgamma_gamma_rampsd_batch_fun *);
+
+
+/**
+ * Set the gamma ramps for a CRTC, from parameters
+ * 
+ * The gamma ramps are calculated directly in the
+ * adjustment method's native depth, so neither a
+ * callback function nor any conversion is involved
+ * 
+ * @param   this    The CRTC state
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 2))))
+int libgamma_crtc_set_gamma_parametric(struct libgamma_crtc_state *restrict,
+                                       const struct libgamma_gamma_ramp_parameters *restrict);
+
+
+
+/**
+ * Prepare gamma ramps for fast application to a CRTC, 8-bit gamma-depth version
+ * 
+ * The prepared gamma ramps can be applied to any CRTC with the same
+ * adjustment method, but if its native gamma ramp depth differs from that
+ * of the CRTC used to prepare the gamma ramps, they will be re-encoded
+ * each time they are applied
+ * 
+ * @param   this      The CRTC state
+ * @param   prepared  Output parameter for the prepared gamma ramps, release
+ *                    with `libgamma_prepared_ramps_destroy` when no longer needed
+ * @param   ramps     The gamma ramps to prepare
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__write_only__, 2), __access__(__read_only__, 3))))
+int libgamma_crtc_prepare_gamma_ramps8(struct libgamma_crtc_state *restrict, struct libgamma_prepared_ramps *restrict,
+                                       const struct libgamma_gamma_ramps8 *restrict);
+
+/**
+ * Prepare gamma ramps for fast application to a CRTC, 16-bit gamma-depth version
+ * 
+ * The prepared gamma ramps can be applied to any CRTC with the same
+ * adjustment method, but if its native gamma ramp depth differs from that
+ * of the CRTC used to prepare the gamma ramps, they will be re-encoded
+ * each time they are applied
+ * 
+ * @param   this      The CRTC state
+ * @param   prepared  Output parameter for the prepared gamma ramps, release
+ *                    with `libgamma_prepared_ramps_destroy` when no longer needed
+ * @param   ramps     The gamma ramps to prepare
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__write_only__, 2), __access__(__read_only__, 3))))
+int libgamma_crtc_prepare_gamma_ramps16(struct libgamma_crtc_state *restrict, struct libgamma_prepared_ramps *restrict,
+                                        const struct libgamma_gamma_ramps16 *restrict);
+
+/**
+ * Prepare gamma ramps for fast application to a CRTC, 32-bit gamma-depth version
+ * 
+ * The prepared gamma ramps can be applied to any CRTC with the same
+ * adjustment method, but if its native gamma ramp depth differs from that
+ * of the CRTC used to prepare the gamma ramps, they will be re-encoded
+ * each time they are applied
+ * 
+ * @param   this      The CRTC state
+ * @param   prepared  Output parameter for the prepared gamma ramps, release
+ *                    with `libgamma_prepared_ramps_destroy` when no longer needed
+ * @param   ramps     The gamma ramps to prepare
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__write_only__, 2), __access__(__read_only__, 3))))
+int libgamma_crtc_prepare_gamma_ramps32(struct libgamma_crtc_state *restrict, struct libgamma_prepared_ramps *restrict,
+                                        const struct libgamma_gamma_ramps32 *restrict);
+
+/**
+ * Prepare gamma ramps for fast application to a CRTC, 64-bit gamma-depth version
+ * 
+ * The prepared gamma ramps can be applied to any CRTC with the same
+ * adjustment method, but if its native gamma ramp depth differs from that
+ * of the CRTC used to prepare the gamma ramps, they will be re-encoded
+ * each time they are applied
+ * 
+ * @param   this      The CRTC state
+ * @param   prepared  Output parameter for the prepared gamma ramps, release
+ *                    with `libgamma_prepared_ramps_destroy` when no longer needed
+ * @param   ramps     The gamma ramps to prepare
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__write_only__, 2), __access__(__read_only__, 3))))
+int libgamma_crtc_prepare_gamma_ramps64(struct libgamma_crtc_state *restrict, struct libgamma_prepared_ramps *restrict,
+                                        const struct libgamma_gamma_ramps64 *restrict);
+
+/**
+ * Prepare gamma ramps for fast application to a CRTC, `float` version
+ * 
+ * The prepared gamma ramps can be applied to any CRTC with the same
+ * adjustment method, but if its native gamma ramp depth differs from that
+ * of the CRTC used to prepare the gamma ramps, they will be re-encoded
+ * each time they are applied
+ * 
+ * @param   this      The CRTC state
+ * @param   prepared  Output parameter for the prepared gamma ramps, release
+ *                    with `libgamma_prepared_ramps_destroy` when no longer needed
+ * @param   ramps     The gamma ramps to prepare
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__write_only__, 2), __access__(__read_only__, 3))))
+int libgamma_crtc_prepare_gamma_rampsf(struct libgamma_crtc_state *restrict, struct libgamma_prepared_ramps *restrict,
+                                       const struct libgamma_gamma_rampsf *restrict);
+
+/**
+ * Prepare gamma ramps for fast application to a CRTC, `double` version
+ * 
+ * The prepared gamma ramps can be applied to any CRTC with the same
+ * adjustment method, but if its native gamma ramp depth differs from that
+ * of the CRTC used to prepare the gamma ramps, they will be re-encoded
+ * each time they are applied
+ * 
+ * @param   this      The CRTC state
+ * @param   prepared  Output parameter for the prepared gamma ramps, release
+ *                    with `libgamma_prepared_ramps_destroy` when no longer needed
+ * @param   ramps     The gamma ramps to prepare
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__write_only__, 2), __access__(__read_only__, 3))))
+int libgamma_crtc_prepare_gamma_rampsd(struct libgamma_crtc_state *restrict, struct libgamma_prepared_ramps *restrict,
+                                       const struct libgamma_gamma_rampsd *restrict);
+
+/**
+ * Apply prepared gamma ramps to a CRTC
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to apply, prepared with
+ *                 `libgamma_crtc_prepare_gamma_ramps8` or
+ *                 one of its siblings
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 2))))
+int libgamma_crtc_apply_prepared(struct libgamma_crtc_state *restrict, const struct libgamma_prepared_ramps *restrict);
+
+/**
+ * Release resources that are held by prepared gamma ramps
+ * 
+ * @param  this  The prepared gamma ramps
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_prepared_ramps_destroy(struct libgamma_prepared_ramps *restrict);
+
+/**
+ * Release resources that are held by prepared gamma ramps,
+ * as well as release the pointer to the structure
+ * 
+ * @param  this  The prepared gamma ramps
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+inline void
+libgamma_prepared_ramps_free(struct libgamma_prepared_ramps *restrict this__)
+{
+	libgamma_prepared_ramps_destroy(this__);
+	free(this__);
+}
+
+
+/**
+ * Initialise a transaction
+ * 
+ * @param  this  The transaction to initialise
+ * @param  site  The site the CRTC:s in the transaction will belong to
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_transaction_initialise(struct libgamma_transaction *restrict, struct libgamma_site_state *restrict);
+
+/**
+ * Release resources that are held by a transaction
+ * 
+ * @param  this  The transaction
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_transaction_destroy(struct libgamma_transaction *restrict);
+
+/**
+ * Remove all staged gamma ramps from a transaction,
+ * but keep its memory so that it can be reused
+ * 
+ * @param  this  The transaction
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_transaction_clear(struct libgamma_transaction *restrict);
+
+/**
+ * Stage gamma ramps for a CRTC in a transaction, 16-bit gamma-depth version
+ * 
+ * The gamma ramps are copied; if gamma ramps have already
+ * been staged for the CRTC, they are replaced
+ * 
+ * @param   this   The transaction
+ * @param   crtc   The CRTC state, the CRTC must belong to the transaction's site
+ * @param   ramps  The gamma ramps to apply
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __access__(__read_only__, 3), __warn_unused_result__)))
+int libgamma_transaction_set_gamma_ramps16(struct libgamma_transaction *restrict, struct libgamma_crtc_state *restrict,
+                                           const struct libgamma_gamma_ramps16 *restrict);
+
+/**
+ * Apply all gamma ramps staged in a transaction
+ * 
+ * With Linux DRM and atomic modesetting, the gamma ramps are
+ * applied in one commit per graphics card; with X RandR, all
+ * requests are sent before any is waited upon, so that only
+ * one round trip is made
+ * 
+ * The transaction is not cleared, so it can be committed again
+ * 
+ * @param   this  The transaction
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library; on failure
+ *                the gamma ramps are still applied to as many CRTC:s
+ *                as possible, and the first error is returned
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_transaction_commit(struct libgamma_transaction *restrict);
+
+
+/**
+ * Initialise a transition, and begin it
+ * 
+ * No gamma ramps are applied until `libgamma_transition_step`
+ * is called, which should be done immediately
+ * 
+ * @param   this      The transition to initialise
+ * @param   crtc      The CRTC whose gamma ramps shall be changed
+ * @param   from      The gamma ramps at the beginning of the transition
+ * @param   to        The gamma ramps at the end of the transition, must have
+ *                    the same depth and sizes as `from`
+ * @param   duration  The duration of the transition, in milliseconds
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_transition_initialise(struct libgamma_transition *restrict, struct libgamma_crtc_state *restrict,
+                                   const struct libgamma_prepared_ramps *, const struct libgamma_prepared_ramps *,
+                                   unsigned long int);
+
+/**
+ * Release resources that are held by a transition
+ * 
+ * The gamma ramps are left as they were last applied
+ * 
+ * @param  this  The transition
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_transition_destroy(struct libgamma_transition *restrict);
+
+/**
+ * Apply the frame of a transition that is due
+ * 
+ * Frames are interpolated from the time that has passed since
+ * the transition began, so frames that are due while this
+ * function is not called are skipped rather than delayed
+ * 
+ * @param   this   The transition
+ * @param   delay  Output parameter for the number of milliseconds to
+ *                 wait before calling this function again
+ * @return         1 if the transition has not finished, 0 if the final gamma
+ *                 ramps were applied, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_transition_step(struct libgamma_transition *restrict, unsigned long int *restrict);
+
+/**
+ * Get a file descriptor that becomes readable when the
+ * next frame of a transition is due
+ * 
+ * The file descriptor is owned by the transition and
+ * is closed by `libgamma_transition_destroy`; it is only
+ * available on Linux
+ * 
+ * @param   this  The transition
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_transition_get_fd(struct libgamma_transition *restrict, int *restrict);
+
+/**
+ * Start or stop collecting runtime statistics
+ * 
+ * Statistics are not collected unless this function
+ * has been called; when they are not collected, they
+ * cost nothing but a check of whether they are collected
+ * 
+ * Statistics are collected in per-thread counters,
+ * and are summed over all threads by `libgamma_stats_get`;
+ * no locks are taken when statistics are collected
+ * 
+ * @param   enable  Non-zero to collect statistics, zero to stop
+ * @return          Non-zero if statistics were collected
+ *                  before the function was called
+ */
+int libgamma_stats_enable(int);
+
+/**
+ * Get the runtime statistics that have been collected,
+ * since the library was loaded or `libgamma_stats_reset`
+ * was last called, summed over all threads
+ * 
+ * Calls that are in progress, in other threads, may be
+ * partially included, so the values are only consistent
+ * with each other if no other thread uses the library
+ * 
+ * @param  this  Output parameter for the statistics
+ * @param  size  Should be `sizeof(*this)`, used to let the
+ *               library know which version of the structure
+ *               is used (its size may grow in the future)
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_stats_get(struct libgamma_stats *restrict, size_t);
+
+/**
+ * Set all runtime statistics to zero
+ * 
+ * Calls that are in progress, in other threads,
+ * may be partially included in the statistics
+ * after this function returns
+ */
+void libgamma_stats_reset(void);
+
 
 #define LIBGAMMA_TYPEDEF__(T, N)\
 	LIBGAMMA_GCC_ONLY__(__attribute__((__deprecated__("Use "#T" "#N" instead of "#N"_t"))))\
@@ -0,0 +1,93 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Just an arbitrary version
+ */
+#define ANY bits64
+
+
+/**
+ * Apply gamma ramps of any depth to a CRTC
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to apply
+ * @param   depth  The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+static int
+set_gamma_any(struct libgamma_crtc_state *restrict this, const union gamma_ramps_any *restrict ramps, signed depth)
+{
+	switch (depth) {
+	case  8:  return libgamma_crtc_set_gamma_ramps8(this, &ramps->bits8);
+	case 16:  return libgamma_crtc_set_gamma_ramps16(this, &ramps->bits16);
+	case 32:  return libgamma_crtc_set_gamma_ramps32(this, &ramps->bits32);
+	case 64:  return libgamma_crtc_set_gamma_ramps64(this, &ramps->bits64);
+	case -1:  return libgamma_crtc_set_gamma_rampsf(this, &ramps->float_single);
+	case -2:  return libgamma_crtc_set_gamma_rampsd(this, &ramps->float_double);
+	default:
+		errno = EINVAL;
+		return LIBGAMMA_ERRNO_SET;
+	}
+}
+
+
+/**
+ * Apply prepared gamma ramps to a CRTC
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to apply
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+int
+libgamma_crtc_apply_prepared(struct libgamma_crtc_state *restrict this, const struct libgamma_prepared_ramps *restrict ramps)
+{
+	union gamma_ramps_any ramps_;
+	uint64_t fingerprint;
+	unsigned long long int start;
+	int r, native = 1;
+
+	ramps_.ANY.red_size   = ramps->red_size;
+	ramps_.ANY.green_size = ramps->green_size;
+	ramps_.ANY.blue_size  = ramps->blue_size;
+	ramps_.ANY.red        = ramps->red;
+	ramps_.ANY.green      = ramps->green;
+	ramps_.ANY.blue       = ramps->blue;
+
+	if (libgamma_internal_write_is_redundant(this, &ramps_, ramps->depth, &fingerprint))
+		return 0;
+
+	start = libgamma_internal_stats_start();
+	switch (this->partition->site->method) {
+#define X(CONST, CNAME, MDEPTH, MRAMPS)\
+	case CONST:\
+		if (!(MDEPTH)) {\
+			r = set_gamma_any(this, &ramps_, ramps->depth); /* only dummy is flexible */\
+			native = 0;\
+		} else if (ramps->depth == (MDEPTH)) {\
+			r = libgamma_##CNAME##_crtc_set_gamma_##MRAMPS(this, (const void *)&ramps_);\
+		} else {\
+			r = libgamma_internal_translated_ramp_set(this, &ramps_, ramps->depth, MDEPTH,\
+			                                          libgamma_crtc_set_gamma_##MRAMPS);\
+			native = 0;\
+		}\
+		break;
+	LIST_AVAILABLE_METHODS(X)
+#undef X
+	default:
+		return LIBGAMMA_NO_SUCH_ADJUSTMENT_METHOD;
+	}
+
+	/* Gamma ramps that were not applied directly are recorded by the function that applied them */
+	if (native)
+		libgamma_internal_stats_record(this->partition->site->method, LIBGAMMA_STATS_SET_GAMMA, start, r);
+	libgamma_internal_record_write(this, ramps->depth, fingerprint, r);
+	if (r)
+		this->read_cache_depth = 0;
+	else if (native)
+		libgamma_internal_cache_ramps(this, &ramps_, ramps->depth);
+	return r;
+}
@@ -0,0 +1,33 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Complete a request submitted with `libgamma_crtc_submit_get_gamma_ramps16`
+ * or `libgamma_crtc_submit_set_gamma_ramps16`, without blocking
+ * 
+ * @param   request  The request
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library; if the
+ *                   reply has not arrived yet, `LIBGAMMA_ERRNO_SET` is
+ *                   returned with `errno` set to `EAGAIN`
+ */
+int
+libgamma_crtc_complete_request(struct libgamma_crtc_request *restrict request)
+{
+	if (request->pending) {
+		switch (request->crtc->partition->site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+		case LIBGAMMA_METHOD_X_RANDR:
+			return libgamma_x_randr_complete_request(request);
+#endif
+		default:
+			/* This is not possible */
+			abort();
+		}
+	}
+
+	/* The request was carried out when it was submitted */
+	errno = request->error;
+	return request->result;
+}
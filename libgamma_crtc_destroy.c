@@ -20,4 +20,8 @@ libgamma_crtc_destroy(struct libgamma_crtc_state *restrict this)
 	default:
 		break;
 	}
+	free(this->ramps_buffer);
+	this->ramps_buffer = NULL;
+	free(this->read_cache);
+	this->read_cache = NULL;
 }
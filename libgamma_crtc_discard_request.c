@@ -0,0 +1,44 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Abandon a request submitted with `libgamma_crtc_submit_get_gamma_ramps16`,
+ * `libgamma_crtc_submit_set_gamma_ramps16`, `libgamma_crtc_get_gamma_ramps16_async`,
+ * or `libgamma_crtc_set_gamma_ramps16_async` that has not been completed
+ * 
+ * @param  request  The request
+ */
+void
+libgamma_crtc_discard_request(struct libgamma_crtc_request *restrict request)
+{
+	struct libgamma_site_state *restrict site = request->crtc->partition->site;
+	struct libgamma_crtc_request **queue, *previous = NULL;
+
+	/* Remove asynchronous requests from the site's queue */
+	if (request->callback) {
+		for (queue = &site->requests; *queue; previous = *queue, queue = &(*queue)->next) {
+			if (*queue == request) {
+				*queue = request->next;
+				if (site->requests_last == request)
+					site->requests_last = previous;
+				break;
+			}
+		}
+		request->next = NULL;
+	}
+
+	if (!request->pending)
+		return;
+
+	switch (site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	case LIBGAMMA_METHOD_X_RANDR:
+		libgamma_x_randr_discard_request(request);
+		break;
+#endif
+	default:
+		/* This is not possible */
+		abort();
+	}
+}
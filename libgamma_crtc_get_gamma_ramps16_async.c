@@ -0,0 +1,31 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the current gamma ramps for a CRTC, 16-bit gamma-depth version,
+ * asynchronously; the callback function is called from
+ * `libgamma_site_dispatch_requests` once the request has completed
+ * 
+ * @param   request   Output parameter for the request
+ * @param   this      The CRTC state
+ * @param   ramps     The gamma ramps to fill with the current values,
+ *                    must remain valid until the request completes
+ * @param   callback  The function to call when the request completes
+ * @param   user      User data for `callback`
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library
+ */
+int
+libgamma_crtc_get_gamma_ramps16_async(struct libgamma_crtc_request *restrict request, struct libgamma_crtc_state *restrict this,
+                                      struct libgamma_gamma_ramps16 *restrict ramps,
+                                      libgamma_crtc_request_callback_fun *callback, void *user)
+{
+	int r = libgamma_crtc_submit_get_gamma_ramps16(request, this, ramps);
+	if (r)
+		return r;
+	request->callback = callback;
+	request->user = user;
+	libgamma_internal_queue_request(request);
+	return 0;
+}
@@ -0,0 +1,58 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the current gamma ramps for a CRTC, interleaved 16-bit gamma-depth version
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to fill with the current values,
+ *                 `ramps->size` must be set to the CRTC's gamma ramp
+ *                 size, which must be the same for all channels
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+int
+libgamma_crtc_get_gamma_ramps16_interleaved(struct libgamma_crtc_state *restrict this,
+                                            struct libgamma_gamma_ramps16_interleaved *restrict ramps)
+{
+	struct libgamma_gamma_ramps16 planar;
+	size_t i, n = ramps->size;
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+	unsigned long long int start;
+#endif
+	int r;
+
+	switch (this->partition->site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+	case LIBGAMMA_METHOD_LINUX_DRM:
+		start = libgamma_internal_stats_start();
+		r = libgamma_linux_drm_crtc_get_gamma_ramps16_interleaved(this, ramps);
+		libgamma_internal_stats_record(LIBGAMMA_METHOD_LINUX_DRM, LIBGAMMA_STATS_GET_GAMMA, start, r);
+		return r;
+#endif
+	default:
+		break;
+	}
+
+	/* Other adjustment methods store each channel separately */
+	if (n > SIZE_MAX / 3 / sizeof(*planar.red)) {
+		errno = ENOMEM;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	planar.red = libgamma_internal_ramps_buffer(this, 3 * n * sizeof(*planar.red));
+	if (!planar.red)
+		return LIBGAMMA_ERRNO_SET;
+	planar.red_size = planar.green_size = planar.blue_size = n;
+	planar.green = &planar.  red[n];
+	planar.blue  = &planar.green[n];
+	if ((r = libgamma_crtc_get_gamma_ramps16(this, &planar)))
+		return r;
+	for (i = 0; i < n; i++) {
+		ramps->stops[i].red      = planar.  red[i];
+		ramps->stops[i].green    = planar.green[i];
+		ramps->stops[i].blue     = planar. blue[i];
+		ramps->stops[i].reserved = 0;
+	}
+	return 0;
+}
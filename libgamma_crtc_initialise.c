@@ -14,16 +14,31 @@
 int
 libgamma_crtc_initialise(struct libgamma_crtc_state *restrict this, struct libgamma_partition_state *restrict partition, size_t crtc)
 {
+	unsigned long long int start;
+	int r;
+
 	this->partition = partition;
 	this->crtc = crtc;
+	this->ramps_buffer = NULL;
+	this->ramps_buffer_size = 0;
+	this->deduplicate_writes = 0;
+	this->cache_reads = 0;
+	this->read_cache_ttl = 0;
+	this->read_cache = NULL;
+	this->read_cache_size = 0;
+	libgamma_crtc_invalidate_cache(this);
 
+	start = libgamma_internal_stats_start();
 	switch (partition->site->method) {
 #define X(CONST, CNAME, ...)\
 	case CONST:\
-		return libgamma_##CNAME##_crtc_initialise(this, partition, crtc);
+		r = libgamma_##CNAME##_crtc_initialise(this, partition, crtc);\
+		break;
 	LIST_AVAILABLE_METHODS(X)
 #undef X
 	default:
 		return LIBGAMMA_NO_SUCH_ADJUSTMENT_METHOD;
 	}
+	libgamma_internal_stats_record(partition->site->method, LIBGAMMA_STATS_INITIALISE, start, r);
+	return r;
 }
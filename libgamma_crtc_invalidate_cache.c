@@ -0,0 +1,20 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Forget cached information about a CRTC, such as its gamma ramp sizes
+ * and the gamma ramps it last applied or read
+ * 
+ * @param  this  The CRTC state
+ */
+void
+libgamma_crtc_invalidate_cache(struct libgamma_crtc_state *restrict this)
+{
+	this->cached_red_gamma_size = 0;
+	this->cached_green_gamma_size = 0;
+	this->cached_blue_gamma_size = 0;
+	this->cached_generation = this->partition->generation;
+	this->applied_depth = 0;
+	this->read_cache_depth = 0;
+}
@@ -0,0 +1,21 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Prepare gamma ramps for fast application to a CRTC, `double` version
+ * 
+ * @param   this      The CRTC state
+ * @param   prepared  Output parameter for the prepared gamma ramps
+ * @param   ramps     The gamma ramps to prepare
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library
+ */
+int
+libgamma_crtc_prepare_gamma_rampsd(struct libgamma_crtc_state *restrict this, struct libgamma_prepared_ramps *restrict prepared,
+                                   const struct libgamma_gamma_rampsd *restrict ramps)
+{
+	union gamma_ramps_any ramps_;
+	ramps_.float_double = *ramps;
+	return libgamma_internal_prepare_ramps(this, prepared, &ramps_, -2);
+}
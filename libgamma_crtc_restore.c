@@ -12,6 +12,10 @@
 int
 libgamma_crtc_restore(struct libgamma_crtc_state *restrict this)
 {
+	/* Forget which gamma ramps were last applied to, or read from, the CRTC */
+	this->applied_depth = 0;
+	this->read_cache_depth = 0;
+
 	switch (this->partition->site->method) {
 #define X(CONST, CNAME, ...)\
 	case CONST:\
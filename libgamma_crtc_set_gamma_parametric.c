@@ -0,0 +1,98 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Just an arbitrary version
+ */
+#define ANY bits64
+
+
+/**
+ * The gamma ramp depths, with their union member and element type
+ * 
+ * @param  X:macro  Macro that expands, with the parameters
+ *                  (depth, union member, ramps suffix, element type)
+ */
+#define LIST_DEPTHS(X)\
+	X( 8, bits8,        ramps8,  uint8_t)\
+	X(16, bits16,       ramps16, uint16_t)\
+	X(32, bits32,       ramps32, uint32_t)\
+	X(64, bits64,       ramps64, uint64_t)\
+	X(-1, float_single, rampsf,  float)\
+	X(-2, float_double, rampsd,  double)
+
+
+/**
+ * Set the gamma ramps for a CRTC, from parameters
+ * 
+ * The gamma ramps are calculated directly in the
+ * adjustment method's native depth, so neither a
+ * callback function nor any conversion is involved
+ * 
+ * @param   this    The CRTC state
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library
+ */
+int
+libgamma_crtc_set_gamma_parametric(struct libgamma_crtc_state *restrict this,
+                                   const struct libgamma_gamma_ramp_parameters *restrict params)
+{
+	union gamma_ramps_any ramps;
+	signed depth;
+	size_t n, size;
+	int e;
+
+	/* Get the adjustment method's native depth, so that the gamma
+	 * ramps can be generated in it and applied without translation */
+	depth = libgamma_internal_native_depth(this, 16);
+	switch (depth) {
+#define X(DEPTH, MEMBER, SUFFIX, TYPE)\
+	case DEPTH:\
+		size = sizeof(TYPE);\
+		break;
+	LIST_DEPTHS(X)
+#undef X
+	default:
+		return LIBGAMMA_NO_SUCH_ADJUSTMENT_METHOD;
+	}
+
+	/* Get the size of the gamma ramps, unless it is cached */
+	if ((e = libgamma_internal_cache_gamma_sizes(this)))
+		return e;
+
+	/* Copy the size of the gamma ramps and calculate the grand size */
+	n  = ramps.ANY.  red_size = this->cached_red_gamma_size;
+	n += ramps.ANY.green_size = this->cached_green_gamma_size;
+	n += ramps.ANY. blue_size = this->cached_blue_gamma_size;
+
+	/* Allocate gamma ramps, unless the buffer from the last call is large enough */
+	ramps.ANY.  red = libgamma_internal_ramps_buffer(this, n * size);
+	if (!ramps.ANY.red)
+		return LIBGAMMA_ERRNO_SET;
+	ramps.ANY.green = (void *)&((char *)ramps.ANY.  red)[ramps.ANY.  red_size * size];
+	ramps.ANY. blue = (void *)&((char *)ramps.ANY.green)[ramps.ANY.green_size * size];
+
+	/* Generate the gamma ramps */
+	if ((e = libgamma_internal_generate_ramps(&ramps, depth, params)))
+		return e;
+
+	/* Apply the gamma ramps, and if that fails, the cached
+	 * gamma ramp sizes may be stale (the error could be
+	 * `LIBGAMMA_GAMMA_RAMP_SIZE_CHANGED`), so forget them */
+	switch (depth) {
+#define X(DEPTH, MEMBER, SUFFIX, TYPE)\
+	case DEPTH:\
+		e = libgamma_crtc_set_gamma_##SUFFIX(this, &ramps.MEMBER);\
+		break;
+	LIST_DEPTHS(X)
+#undef X
+	default:
+		/* This is not possible */
+		abort();
+	}
+	if (e)
+		libgamma_crtc_invalidate_cache(this);
+	return e;
+}
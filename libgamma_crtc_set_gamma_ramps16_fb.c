@@ -0,0 +1,35 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Set the gamma ramps for a CRTC, 16-bit gamma-depth batch function version
+ * 
+ * Unlike `libgamma_crtc_set_gamma_ramps16_f`, the functions are called
+ * once per channel, rather than once per stop, and receive all encoding
+ * values at once, letting them use vectorised arithmetic
+ * 
+ * Note that this will probably involve the library allocating temporary data
+ * 
+ * @param   this            The CRTC state
+ * @param   red_function    The function that generates the gamma ramp for the red channel
+ * @param   green_function  The function that generates the gamma ramp for the green channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @param   blue_function   The function that generates the gamma ramp for the blue channel,
+ *                          `NULL` to use `red_function`, in which case the gamma ramp
+ *                          for the red channel is copied rather than regenerated if
+ *                          the channels have the same size
+ * @return                  Zero on success, otherwise (negative) the value of an
+ *                          error identifier provided by this library
+ */
+int
+libgamma_crtc_set_gamma_ramps16_fb(struct libgamma_crtc_state *restrict this, libgamma_gamma_ramps16_batch_fun *red_function,
+                                   libgamma_gamma_ramps16_batch_fun *green_function, libgamma_gamma_ramps16_batch_fun *blue_function)
+{
+#define TYPE uint16_t
+#define ENCODING float
+#define APPEND_RAMPS(X) X##ramps16
+#include "set_ramps_fun_batch.h"
+}
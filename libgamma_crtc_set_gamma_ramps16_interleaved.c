@@ -0,0 +1,59 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Set the gamma ramps for a CRTC, interleaved 16-bit gamma-depth version
+ * 
+ * With Linux DRM and atomic modesetting, the gamma ramps
+ * are uploaded directly from `ramps->stops`, without copying
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to apply
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+int
+libgamma_crtc_set_gamma_ramps16_interleaved(struct libgamma_crtc_state *restrict this,
+                                            const struct libgamma_gamma_ramps16_interleaved *restrict ramps)
+{
+	struct libgamma_gamma_ramps16 planar;
+	size_t i, n = ramps->size;
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+	unsigned long long int start;
+	int r;
+#endif
+
+	switch (this->partition->site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+	case LIBGAMMA_METHOD_LINUX_DRM:
+		/* This bypasses the deduplication and read cache in `libgamma_crtc_set_gamma_ramps16` */
+		this->applied_depth = 0;
+		this->read_cache_depth = 0;
+		start = libgamma_internal_stats_start();
+		r = libgamma_linux_drm_crtc_set_gamma_ramps16_interleaved(this, ramps);
+		libgamma_internal_stats_record(LIBGAMMA_METHOD_LINUX_DRM, LIBGAMMA_STATS_SET_GAMMA, start, r);
+		return r;
+#endif
+	default:
+		break;
+	}
+
+	/* Other adjustment methods store each channel separately */
+	if (n > SIZE_MAX / 3 / sizeof(*planar.red)) {
+		errno = ENOMEM;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	planar.red = libgamma_internal_ramps_buffer(this, 3 * n * sizeof(*planar.red));
+	if (!planar.red)
+		return LIBGAMMA_ERRNO_SET;
+	planar.red_size = planar.green_size = planar.blue_size = n;
+	planar.green = &planar.  red[n];
+	planar.blue  = &planar.green[n];
+	for (i = 0; i < n; i++) {
+		planar.  red[i] = ramps->stops[i].red;
+		planar.green[i] = ramps->stops[i].green;
+		planar. blue[i] = ramps->stops[i].blue;
+	}
+	return libgamma_crtc_set_gamma_ramps16(this, &planar);
+}
@@ -0,0 +1,45 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Submit a request to get the current gamma ramps for a CRTC,
+ * 16-bit gamma-depth version, without waiting for a reply
+ * 
+ * @param   request  Output parameter for the request
+ * @param   this     The CRTC state
+ * @param   ramps    The gamma ramps to fill with the current values
+ *                   when the request completes, must remain valid
+ *                   until then
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library
+ */
+int
+libgamma_crtc_submit_get_gamma_ramps16(struct libgamma_crtc_request *restrict request, struct libgamma_crtc_state *restrict this,
+                                       struct libgamma_gamma_ramps16 *restrict ramps)
+{
+	request->crtc = this;
+	request->ramps = ramps;
+	request->pending = 0;
+	request->callback = NULL;
+	request->user = NULL;
+	request->next = NULL;
+
+	switch (this->partition->site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	case LIBGAMMA_METHOD_X_RANDR:
+		return libgamma_x_randr_crtc_submit_get_gamma_ramps16(request);
+#endif
+	default:
+		break;
+	}
+
+	/* Other adjustment methods cannot send the request without
+	 * waiting for it, so the request is carried out immediately
+	 * and reported on completion; with X VidMode, this blocks
+	 * for a round trip to the display server, as Xlib has no
+	 * way to send the gamma ramp requests without waiting */
+	request->result = libgamma_crtc_get_gamma_ramps16(this, ramps);
+	request->error = errno;
+	return 0;
+}
@@ -0,0 +1,49 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Submit a request to set the gamma ramps for a CRTC,
+ * 16-bit gamma-depth version, without waiting for
+ * the display server to acknowledge it
+ * 
+ * @param   request  Output parameter for the request
+ * @param   this     The CRTC state
+ * @param   ramps    The gamma ramps to apply, they are copied
+ *                   before the function returns
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library
+ */
+int
+libgamma_crtc_submit_set_gamma_ramps16(struct libgamma_crtc_request *restrict request, struct libgamma_crtc_state *restrict this,
+                                       const struct libgamma_gamma_ramps16 *restrict ramps)
+{
+	request->crtc = this;
+	request->ramps = NULL;
+	request->pending = 0;
+	request->callback = NULL;
+	request->user = NULL;
+	request->next = NULL;
+
+	/* The gamma ramps of the CRTC are not known until the request completes */
+	this->applied_depth = 0;
+	this->read_cache_depth = 0;
+
+	switch (this->partition->site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	case LIBGAMMA_METHOD_X_RANDR:
+		return libgamma_x_randr_crtc_submit_set_gamma_ramps16(request, ramps);
+#endif
+	default:
+		break;
+	}
+
+	/* Other adjustment methods cannot send the request without
+	 * waiting for it, so the request is carried out immediately
+	 * and reported on completion; with X VidMode, this blocks
+	 * for a round trip to the display server, as Xlib has no
+	 * way to send the gamma ramp requests without waiting */
+	request->result = libgamma_crtc_set_gamma_ramps16(this, ramps);
+	request->error = errno;
+	return 0;
+}
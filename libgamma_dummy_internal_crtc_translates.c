@@ -0,0 +1,20 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_DUMMY
+#include "common.h"
+
+
+/**
+ * Check whether the gamma ramp functions for a CRTC will translate
+ * the gamma ramps and call the public function for the CRTC's
+ * gamma ramp depth, rather than access the gamma ramps directly
+ * 
+ * @param   this   The CRTC state
+ * @param   depth  The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @return         1 if the gamma ramps will be translated, 0 otherwise
+ */
+int
+libgamma_dummy_internal_crtc_translates(const struct libgamma_crtc_state *restrict this, signed depth)
+{
+	const struct libgamma_dummy_crtc *data = this->data;
+	return data->info.gamma_support && data->info.gamma_depth != depth;
+}
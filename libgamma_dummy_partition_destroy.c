@@ -21,5 +21,6 @@ libgamma_dummy_partition_destroy(struct libgamma_partition_state *restrict this)
 		}
 		free(data->crtcs);
 		data->crtcs = NULL;
+		data->state = NULL;
 	}
 }
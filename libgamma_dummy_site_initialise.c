@@ -45,7 +45,7 @@ libgamma_dummy_site_initialise(struct libgamma_site_state *restrict this, char *
 	if (!libgamma_dummy_internal_configurations.capabilities.multiple_crtcs)
 		crtcs = !!crtcs;
 
-	if (data->partition_count * sizeof(*data->partitions)) {
+	if (data->partition_count > SIZE_MAX / sizeof(*data->partitions)) {
 		errno = ENOMEM;
 		goto fail;
 	}
@@ -53,8 +53,11 @@ libgamma_dummy_site_initialise(struct libgamma_site_state *restrict this, char *
 	if (!data->partitions)
 		goto fail;
 
-	for (i = 0; i < data->partition_count; i++)
+	for (i = 0; i < data->partition_count; i++) {
 		data->partitions[i].crtc_count = crtcs;
+		data->partitions[i].state = NULL;
+		data->partitions[i].crtcs = NULL;
+	}
 
 	this->partitions_available = data->partition_count;
 
@@ -21,10 +21,16 @@ libgamma_dummy_site_restore(struct libgamma_site_state *restrict this)
 		return LIBGAMMA_ERRNO_SET;
 	}
 
-	for (j = 0; j < data->partition_count; j++)
+	for (j = 0; j < data->partition_count; j++) {
+		/* The CRTC:s are not allocated until the partition is initialised */
+		if (!data->partitions[j].crtcs)
+			continue;
 		for (i = 0; i < data->partitions[j].crtc_count; i++)
 			if (libgamma_dummy_internal_crtc_restore_forced(data->partitions[j].crtcs + i))
 				return -1;
+		if (data->partitions[j].state)
+			data->partitions[j].state->generation += 1;
+	}
 
 	return 0;
 }
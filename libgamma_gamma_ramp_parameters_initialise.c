@@ -0,0 +1,19 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Initialise gamma ramp parameters to the identity,
+ * that is, parameters that do not adjust anything
+ * 
+ * @param  this  The gamma ramp parameters
+ */
+void
+libgamma_gamma_ramp_parameters_initialise(struct libgamma_gamma_ramp_parameters *restrict this)
+{
+	this->red_gamma    = this->green_gamma    = this->blue_gamma    = 1;
+	this->red_contrast = this->green_contrast = this->blue_contrast = 1;
+	this->red_min      = this->green_min      = this->blue_min      = 0;
+	this->red_max      = this->green_max      = this->blue_max      = 1;
+	this->temperature  = 0;
+}
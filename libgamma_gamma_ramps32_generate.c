@@ -0,0 +1,25 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Fill gamma ramps from parameters, 32-bit gamma-depth version
+ * 
+ * The gamma ramps are calculated directly in their depth,
+ * without any callback function or intermediate conversion
+ * 
+ * @param   this    The gamma ramps, must have been initialised, for example
+ *                  with `libgamma_gamma_ramps32_initialise`
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library; `EINVAL`
+ *                  if the parameters are invalid
+ */
+int
+libgamma_gamma_ramps32_generate(struct libgamma_gamma_ramps32 *restrict this,
+                                const struct libgamma_gamma_ramp_parameters *restrict params)
+{
+	union gamma_ramps_any ramps_;
+	ramps_.bits32 = *this;
+	return libgamma_internal_generate_ramps(&ramps_, 32, params);
+}
@@ -17,6 +17,7 @@ libgamma_get_crtc_information(struct libgamma_crtc_information *restrict this, s
                               struct libgamma_crtc_state *restrict crtc, unsigned long long fields)
 {
 	struct libgamma_crtc_information info_;
+	unsigned long long int start;
 	int r, (*func)(struct libgamma_crtc_information *restrict, struct libgamma_crtc_state *restrict, unsigned long long);
 
 	this->edid = NULL;
@@ -33,13 +34,16 @@ libgamma_get_crtc_information(struct libgamma_crtc_information *restrict this, s
 		return LIBGAMMA_NO_SUCH_ADJUSTMENT_METHOD;
 	}
 
+	start = libgamma_internal_stats_start();
 	if (size == sizeof(info_)) {
 		r = func(this, crtc, fields);
+		libgamma_internal_stats_record(crtc->partition->site->method, LIBGAMMA_STATS_GET_INFORMATION, start, r);
 		this->struct_version = LIBGAMMA_CRTC_INFORMATION_STRUCT_VERSION;
 		return r;
 	} else {
 		info_.struct_version = LIBGAMMA_CRTC_INFORMATION_STRUCT_VERSION;
 		r = func(&info_, crtc, fields);
+		libgamma_internal_stats_record(crtc->partition->site->method, LIBGAMMA_STATS_GET_INFORMATION, start, r);
 		if (size < sizeof(info_)) {
 			memcpy(this, &info_, size);
 		} else {
@@ -0,0 +1,38 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Make sure the sizes of a CRTC's gamma ramps are cached in
+ * its state, the cache is refreshed if the configuration of
+ * the partition has changed since the sizes were cached
+ * 
+ * @param   this  The CRTC state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_internal_cache_gamma_sizes(struct libgamma_crtc_state *restrict this)
+{
+	struct libgamma_crtc_information info;
+	int e;
+
+	if (this->cached_generation != this->partition->generation)
+		libgamma_crtc_invalidate_cache(this);
+
+	if (this->cached_red_gamma_size || this->cached_green_gamma_size || this->cached_blue_gamma_size)
+		return 0;
+
+	if (libgamma_get_crtc_information(&info, sizeof(info), this, LIBGAMMA_CRTC_INFO_GAMMA_SIZE)) {
+		e = info.gamma_size_error;
+		if (e < 0)
+			return e;
+		errno = e;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	this->cached_red_gamma_size   = info.  red_gamma_size;
+	this->cached_green_gamma_size = info.green_gamma_size;
+	this->cached_blue_gamma_size  = info. blue_gamma_size;
+	this->cached_generation       = this->partition->generation;
+	return 0;
+}
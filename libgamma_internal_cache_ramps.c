@@ -0,0 +1,65 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Just an arbitrary version
+ */
+#define ANY bits64
+
+
+/**
+ * Store gamma ramps that were applied to, or read from,
+ * a CRTC in the cache in its state, if `this->cache_reads`
+ * is set; if the gamma ramps cannot be stored, the cache
+ * is emptied
+ * 
+ * @param  this   The CRTC state
+ * @param  ramps  The gamma ramps
+ * @param  depth  The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ */
+void
+libgamma_internal_cache_ramps(struct libgamma_crtc_state *restrict this, const union gamma_ramps_any *restrict ramps, signed depth)
+{
+	size_t n, red, green, blue;
+	char *cache;
+	int saved_errno;
+
+	this->read_cache_depth = 0;
+	if (!this->cache_reads)
+		return;
+
+	n = libgamma_internal_stop_size(depth);
+	if (ramps->ANY.red_size   > SIZE_MAX / n ||
+	    ramps->ANY.green_size > SIZE_MAX / n ||
+	    ramps->ANY.blue_size  > SIZE_MAX / n)
+		return;
+	red   = ramps->ANY.red_size   * n;
+	green = ramps->ANY.green_size * n;
+	blue  = ramps->ANY.blue_size  * n;
+	if (green > SIZE_MAX - red || blue > SIZE_MAX - red - green)
+		return;
+
+	if (red + green + blue > this->read_cache_size) {
+		saved_errno = errno;
+		cache = realloc(this->read_cache, red + green + blue);
+		errno = saved_errno;
+		if (!cache)
+			return;
+		libgamma_internal_stats_add(this->partition->site->method, LIBGAMMA_INTERNAL_STATS_ALLOCATIONS, 1);
+		this->read_cache = cache;
+		this->read_cache_size = red + green + blue;
+	}
+
+	cache = this->read_cache;
+	memcpy(cache, ramps->ANY.red, red);
+	memcpy(&cache[red], ramps->ANY.green, green);
+	memcpy(&cache[red + green], ramps->ANY.blue, blue);
+
+	this->read_cache_red_size   = ramps->ANY.red_size;
+	this->read_cache_green_size = ramps->ANY.green_size;
+	this->read_cache_blue_size  = ramps->ANY.blue_size;
+	this->read_cache_depth      = depth;
+	this->read_cache_generation = this->partition->generation;
+	this->read_cache_time       = this->read_cache_ttl ? libgamma_internal_monotonic_time() : 0;
+}
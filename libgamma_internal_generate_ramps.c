@@ -0,0 +1,302 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Just an arbitrary version
+ */
+#define ANY bits64
+
+
+/**
+ * The closed-form parameters for the generation of one channel
+ * 
+ * The output for the stop with index `i` is calculated as
+ * `CLAMP(CLAMP(i ⋅ step + start) ^ exponent ⋅ scale + offset)`
+ * where `CLAMP` clamps to [0, 1]
+ */
+struct channel {
+	/**
+	 * The difference in contrast-adjusted encoding value between two stops
+	 */
+	double step;
+
+	/**
+	 * The contrast-adjusted encoding value of the first stop
+	 */
+	double start;
+
+	/**
+	 * The reciprocal of the gamma
+	 */
+	double exponent;
+
+	/**
+	 * The brightness span, multiplied by the whitepoint factor
+	 */
+	double scale;
+
+	/**
+	 * The minimum brightness, multiplied by the whitepoint factor
+	 */
+	double offset;
+
+	/**
+	 * The number of stops
+	 */
+	size_t size;
+};
+
+
+/**
+ * Clamp a value to [0, 1]
+ * 
+ * @param   y  The value, must not be NaN
+ * @return     `y` clamped to [0, 1]
+ */
+#define CLAMP(y) ((y) < 0 ? 0 : (y) > 1 ? 1 : (y))
+
+/**
+ * Generate a gamma ramp, with two loops so that the
+ * exponentiation is skipped entirely (and the loop
+ * becomes vectorisable) when the gamma is 1
+ * 
+ * @param  STORE:macro  Macro that stores the [0, 1] value `y` in `out[i]`
+ */
+#define GENERATE(STORE)\
+	do {\
+		size_t i;\
+		double y;\
+		if (c->exponent == 1) {\
+			for (i = 0; i < c->size; i++) {\
+				y = (double)i * c->step + c->start;\
+				y = CLAMP(y) * c->scale + c->offset;\
+				y = CLAMP(y);\
+				STORE;\
+			}\
+		} else {\
+			for (i = 0; i < c->size; i++) {\
+				y = (double)i * c->step + c->start;\
+				y = pow(CLAMP(y), c->exponent) * c->scale + c->offset;\
+				y = CLAMP(y);\
+				STORE;\
+			}\
+		}\
+	} while (0)
+
+/**
+ * Generate a gamma ramp with an unsigned integer depth,
+ * rounding to the nearest integer
+ * 
+ * @param  TYPE  The element type
+ * @param  MAX   The maximum value of `TYPE`
+ */
+#define GENERATE_INTEGER(TYPE, MAX)\
+	GENERATE(((TYPE *)out)[i] = (TYPE)(y * (double)(MAX) + 0.5))
+
+
+/**
+ * Generate a gamma ramp for one channel directly in the target depth
+ * 
+ * @param  out    Output buffer for the gamma ramp
+ * @param  c      The parameters for the channel
+ * @param  depth  The depth of the gamma ramp, `-1` for `float`, `-2` for `double`
+ */
+static void
+generate(void *restrict out, const struct channel *restrict c, signed depth)
+{
+	switch (depth) {
+	case 8:
+		GENERATE_INTEGER(uint8_t, UINT8_MAX);
+		break;
+	case 16:
+		GENERATE_INTEGER(uint16_t, UINT16_MAX);
+		break;
+	case 32:
+		GENERATE_INTEGER(uint32_t, UINT32_MAX);
+		break;
+	case 64:
+		/* `UINT64_MAX` is rounded up to 2⁶⁴ when converted to `double`,
+		 * so 1 must be special-cased to avoid overflow, whereas the
+		 * product of 2⁶⁴ and anything less than 1 is exact and fits */
+		GENERATE(((uint64_t *)out)[i] = y < 1 ? (uint64_t)(y * (double)UINT64_MAX) : UINT64_MAX);
+		break;
+	case -1:
+		GENERATE(((float *)out)[i] = (float)y);
+		break;
+	default:
+		GENERATE(((double *)out)[i] = y);
+		break;
+	}
+}
+
+
+/**
+ * Calculate the relative intensities of the red, green,
+ * and blue channels for a blackbody colour temperature,
+ * using Tanner Helland's approximation of the CIE 1964
+ * 10-degree colour matching functions
+ * 
+ * @param  temperature  The colour temperature in Kelvin, [1000, 40000]
+ * @param  rgb          Output parameter for the red, green, and blue intensities
+ */
+static void
+blackbody(double temperature, double rgb[3])
+{
+	double t = temperature / 100;
+
+	if (t <= 66) {
+		rgb[0] = 255;
+		rgb[1] = 99.4708025861 * log(t) - 161.1195681661;
+	} else {
+		rgb[0] = 329.698727446 * pow(t - 60, -0.1332047592);
+		rgb[1] = 288.1221695283 * pow(t - 60, -0.0755148492);
+	}
+
+	if (t >= 66)
+		rgb[2] = 255;
+	else if (t <= 19)
+		rgb[2] = 0;
+	else
+		rgb[2] = 138.5177312231 * log(t - 10) - 305.0447927307;
+
+	rgb[0] = CLAMP(rgb[0] / 255);
+	rgb[1] = CLAMP(rgb[1] / 255);
+	rgb[2] = CLAMP(rgb[2] / 255);
+}
+
+
+/**
+ * Calculate the whitepoint factors for a colour temperature
+ * 
+ * The factors are relative to 6500 K, so that 6500 K
+ * yields 1 for all channels, and are then normalised
+ * so that the largest factor is 1
+ * 
+ * @param  temperature  The colour temperature in Kelvin, 0 for neutral
+ * @param  factors      Output parameter for the red, green, and blue factors
+ */
+static void
+whitepoint(double temperature, double factors[3])
+{
+	double neutral[3], max;
+	size_t i;
+
+	if (!temperature) {
+		factors[0] = factors[1] = factors[2] = 1;
+		return;
+	}
+
+	/* The approximation is only valid in [1000 K, 40000 K] */
+	if (temperature < 1000)
+		temperature = 1000;
+	else if (temperature > 40000)
+		temperature = 40000;
+
+	blackbody(temperature, factors);
+	blackbody(6500, neutral);
+
+	for (i = 0, max = 0; i < 3; i++) {
+		factors[i] /= neutral[i];
+		if (factors[i] > max)
+			max = factors[i];
+	}
+	for (i = 0; i < 3; i++)
+		factors[i] /= max;
+}
+
+
+/**
+ * Calculate the closed-form parameters for a channel
+ * 
+ * @param   c         Output parameter for the closed-form parameters
+ * @param   size      The number of stops in the gamma ramp
+ * @param   gamma     The gamma of the channel
+ * @param   contrast  The contrast of the channel
+ * @param   min       The minimum brightness of the channel
+ * @param   max       The maximum brightness of the channel
+ * @param   factor    The whitepoint factor of the channel
+ * @return            0 on success, -1 if the parameters are invalid
+ */
+static int
+prepare_channel(struct channel *restrict c, size_t size, double gamma, double contrast, double min, double max, double factor)
+{
+	if (!(gamma > 0) || isinf(gamma) || !isfinite(contrast) || !isfinite(min) || !isfinite(max))
+		return -1;
+
+	c->step     = size > 1 ? contrast / (double)(size - 1) : 0;
+	c->start    = (1 - contrast) / 2;
+	c->exponent = 1 / gamma;
+	c->scale    = (max - min) * factor;
+	c->offset   = min * factor;
+	c->size     = size;
+	return 0;
+}
+
+
+/**
+ * Check whether two channels will have identical gamma ramps
+ * 
+ * @param   a  One of the channels
+ * @param   b  The other channel
+ * @return     1 if the channels are identical, 0 otherwise
+ */
+static int
+same_channel(const struct channel *a, const struct channel *b)
+{
+	return a->step     == b->step     &&
+	       a->start    == b->start    &&
+	       a->exponent == b->exponent &&
+	       a->scale    == b->scale    &&
+	       a->offset   == b->offset   &&
+	       a->size     == b->size;
+}
+
+
+/**
+ * Fill gamma ramps, of any depth, from parameters
+ * 
+ * @param   ramps   The gamma ramps to fill, the sizes must be set and the
+ *                  ramps must be allocated
+ * @param   depth   The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @param   params  The parameters for the gamma ramps
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library
+ */
+int
+libgamma_internal_generate_ramps(union gamma_ramps_any *restrict ramps, signed depth,
+                                 const struct libgamma_gamma_ramp_parameters *restrict params)
+{
+	struct channel red, green, blue;
+	double factors[3];
+
+	if (isnan(params->temperature) || params->temperature < 0) {
+		errno = EINVAL;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	whitepoint(params->temperature, factors);
+
+	if (prepare_channel(&red, ramps->ANY.red_size, params->red_gamma, params->red_contrast,
+	                    params->red_min, params->red_max, factors[0]) ||
+	    prepare_channel(&green, ramps->ANY.green_size, params->green_gamma, params->green_contrast,
+	                    params->green_min, params->green_max, factors[1]) ||
+	    prepare_channel(&blue, ramps->ANY.blue_size, params->blue_gamma, params->blue_contrast,
+	                    params->blue_min, params->blue_max, factors[2])) {
+		errno = EINVAL;
+		return LIBGAMMA_ERRNO_SET;
+	}
+
+	/* Channels that are identical to the red
+	 * channel are copied rather than regenerated */
+	generate(ramps->ANY.red, &red, depth);
+	if (same_channel(&green, &red))
+		memcpy(ramps->ANY.green, ramps->ANY.red, red.size * libgamma_internal_stop_size(depth));
+	else
+		generate(ramps->ANY.green, &green, depth);
+	if (same_channel(&blue, &red))
+		memcpy(ramps->ANY.blue, ramps->ANY.red, red.size * libgamma_internal_stop_size(depth));
+	else
+		generate(ramps->ANY.blue, &blue, depth);
+
+	return 0;
+}
@@ -0,0 +1,22 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the time on a clock that cannot be set
+ * 
+ * @return  The time, in milliseconds, from an arbitrary point in
+ *          time, or 0 if the clock is not available
+ */
+unsigned long long int
+libgamma_internal_monotonic_time(void)
+{
+#ifdef CLOCK_MONOTONIC
+	struct timespec ts;
+	if (clock_gettime(CLOCK_MONOTONIC, &ts))
+		return 0;
+	return (unsigned long long int)ts.tv_sec * 1000ULL + (unsigned long long int)ts.tv_nsec / 1000000ULL;
+#else
+	return 0;
+#endif
+}
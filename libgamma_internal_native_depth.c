@@ -0,0 +1,44 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the depth that gamma ramps are stored
+ * in by the adjustment method, for a CRTC
+ * 
+ * @param   this        The CRTC state
+ * @param   depth_user  The depth to use if the adjustment method is flexible
+ *                      and the CRTC's depth cannot be queried, `-1` for
+ *                      `float`, `-2` for `double`
+ * @return              The native depth of the CRTC, `-1` for `float`,
+ *                      `-2` for `double`, 0 if the adjustment method
+ *                      is not available
+ */
+signed
+libgamma_internal_native_depth(struct libgamma_crtc_state *restrict this, signed depth_user)
+{
+	struct libgamma_crtc_information info;
+	signed depth_system;
+
+	/* Get the adjustment method's native depth */
+	switch (this->partition->site->method) {
+#define X(CONST, CNAME, MDEPTH, MRAMPS)\
+	case CONST:\
+		depth_system = (MDEPTH);\
+		break;
+	LIST_AVAILABLE_METHODS(X)
+#undef X
+	default:
+		return 0;
+	}
+
+	/* Flexible adjustment methods (only dummy) have a native depth
+	 * per CRTC, if it cannot be queried, the user's depth is used */
+	if (!depth_system) {
+		depth_system = depth_user;
+		if (!libgamma_get_crtc_information(&info, sizeof(info), this, LIBGAMMA_CRTC_INFO_GAMMA_DEPTH))
+			depth_system = info.gamma_depth;
+	}
+
+	return depth_system;
+}
@@ -0,0 +1,64 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Just an arbitrary version
+ */
+#define ANY bits64
+
+
+/**
+ * Prepare gamma ramps for fast application to a CRTC
+ * 
+ * @param   this        The CRTC state
+ * @param   prepared    Output parameter for the prepared gamma ramps
+ * @param   ramps       The gamma ramps to prepare
+ * @param   depth_user  The depth of the gamma ramps that are provided by the user,
+ *                      `-1` for `float`, `-2` for `double`
+ * @return              Zero on success, otherwise (negative) the value of an
+ *                      error identifier provided by this library
+ */
+int
+libgamma_internal_prepare_ramps(struct libgamma_crtc_state *restrict this, struct libgamma_prepared_ramps *restrict prepared,
+                                const union gamma_ramps_any *restrict ramps, signed depth_user)
+{
+	union gamma_ramps_any ramps_sys;
+	translate_fun *translate;
+	signed depth_system;
+	size_t n;
+	int r;
+
+	/* Get the adjustment method's native depth */
+	depth_system = libgamma_internal_native_depth(this, depth_user);
+	if (!depth_system)
+		return LIBGAMMA_NO_SUCH_ADJUSTMENT_METHOD;
+
+	/* Allocate ramps with proper data type */
+	if ((r = libgamma_internal_allocated_any_ramp(&ramps_sys, ramps, depth_system, &n)))
+		return r;
+
+	/* Store the ramps in the proper format, translation
+	 * is skipped if the depth is already correct, just
+	 * like `libgamma_crtc_set_gamma_ramps*` does */
+	if (depth_user == depth_system) {
+		n = libgamma_internal_stop_size(depth_system);
+		memcpy(ramps_sys.ANY.red,   ramps->ANY.red,   ramps->ANY.red_size   * n);
+		memcpy(ramps_sys.ANY.green, ramps->ANY.green, ramps->ANY.green_size * n);
+		memcpy(ramps_sys.ANY.blue,  ramps->ANY.blue,  ramps->ANY.blue_size  * n);
+	} else {
+		translate = libgamma_internal_translator(depth_system, depth_user);
+		translate(ramps->ANY.red_size,   ramps_sys.ANY.red,   ramps->ANY.red);
+		translate(ramps->ANY.green_size, ramps_sys.ANY.green, ramps->ANY.green);
+		translate(ramps->ANY.blue_size,  ramps_sys.ANY.blue,  ramps->ANY.blue);
+	}
+
+	prepared->depth      = depth_system;
+	prepared->red_size   = ramps_sys.ANY.red_size;
+	prepared->green_size = ramps_sys.ANY.green_size;
+	prepared->blue_size  = ramps_sys.ANY.blue_size;
+	prepared->red        = ramps_sys.ANY.red;
+	prepared->green      = ramps_sys.ANY.green;
+	prepared->blue       = ramps_sys.ANY.blue;
+	return 0;
+}
@@ -0,0 +1,38 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Add a request submitted with `libgamma_crtc_get_gamma_ramps16_async`
+ * or `libgamma_crtc_set_gamma_ramps16_async` to the end of its site's
+ * queue of requests, and signal the site's request file descriptor
+ * if the request has already completed
+ * 
+ * @param  request  The request
+ */
+void
+libgamma_internal_queue_request(struct libgamma_crtc_request *restrict request)
+{
+	struct libgamma_site_state *restrict site = request->crtc->partition->site;
+#ifdef __linux__
+	int saved_errno;
+#endif
+
+	/* Keep the requests in order, so that the callbacks are called in order */
+	request->next = NULL;
+	if (site->requests_last)
+		site->requests_last->next = request;
+	else
+		site->requests = request;
+	site->requests_last = request;
+
+	/* Requests that wait for the display server are signalled by the
+	 * connection to the display server, the rest are signalled here */
+#ifdef __linux__
+	if (!request->pending && site->request_fd >= 0) {
+		saved_errno = errno;
+		eventfd_write(site->request_fd, 1);
+		errno = saved_errno;
+	}
+#endif
+}
@@ -0,0 +1,29 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the CRTC's buffer for temporary gamma ramps,
+ * which is kept between calls so that it does not
+ * have to be reallocated every time gamma ramps
+ * are generated or converted
+ * 
+ * @param   this  The CRTC state
+ * @param   size  The number of bytes required
+ * @return        The buffer, `NULL` on allocation error
+ */
+void *
+libgamma_internal_ramps_buffer(struct libgamma_crtc_state *restrict this, size_t size)
+{
+	void *new;
+	if (size > this->ramps_buffer_size) {
+		new = malloc(size);
+		if (!new)
+			return NULL;
+		libgamma_internal_stats_add(this->partition->site->method, LIBGAMMA_INTERNAL_STATS_ALLOCATIONS, 1);
+		free(this->ramps_buffer);
+		this->ramps_buffer = new;
+		this->ramps_buffer_size = size;
+	}
+	return this->ramps_buffer;
+}
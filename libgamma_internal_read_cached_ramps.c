@@ -0,0 +1,52 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Just an arbitrary version
+ */
+#define ANY bits64
+
+
+/**
+ * Get the gamma ramps of a CRTC from the cache in
+ * its state, if `this->cache_reads` is set and the
+ * cache holds gamma ramps of the requested depth
+ * and sizes that have not expired
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to fill in
+ * @param   depth  The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @return         1 if the gamma ramps were read from the cache, 0 otherwise
+ */
+int
+libgamma_internal_read_cached_ramps(struct libgamma_crtc_state *restrict this, union gamma_ramps_any *restrict ramps, signed depth)
+{
+	const char *cache = this->read_cache;
+	unsigned long long int now;
+	size_t n;
+
+	if (!this->cache_reads ||
+	    this->read_cache_depth != depth ||
+	    this->read_cache_generation != this->partition->generation ||
+	    this->read_cache_red_size   != ramps->ANY.red_size ||
+	    this->read_cache_green_size != ramps->ANY.green_size ||
+	    this->read_cache_blue_size  != ramps->ANY.blue_size)
+		return 0;
+
+	if (this->read_cache_ttl) {
+		now = libgamma_internal_monotonic_time();
+		if (!now || now - this->read_cache_time >= this->read_cache_ttl) {
+			this->read_cache_depth = 0;
+			return 0;
+		}
+	}
+
+	n = libgamma_internal_stop_size(depth);
+	memcpy(ramps->ANY.red, cache, ramps->ANY.red_size * n);
+	cache += ramps->ANY.red_size * n;
+	memcpy(ramps->ANY.green, cache, ramps->ANY.green_size * n);
+	cache += ramps->ANY.green_size * n;
+	memcpy(ramps->ANY.blue, cache, ramps->ANY.blue_size * n);
+	return 1;
+}
@@ -0,0 +1,25 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Remember which gamma ramps were applied to a CRTC, so that
+ * `libgamma_internal_write_is_redundant` can recognise them
+ * 
+ * @param  this         The CRTC state
+ * @param  depth        The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @param  fingerprint  The fingerprint `libgamma_internal_write_is_redundant` output
+ * @param  result       The return value of the function that applied the gamma ramps,
+ *                      if non-zero, the state of the CRTC is forgotten
+ */
+void
+libgamma_internal_record_write(struct libgamma_crtc_state *restrict this, signed depth, uint64_t fingerprint, int result)
+{
+	if (!this->deduplicate_writes || result) {
+		this->applied_depth = 0;
+		return;
+	}
+	this->applied_depth = depth;
+	this->applied_fingerprint = fingerprint;
+	this->applied_generation = this->partition->generation;
+}
@@ -0,0 +1,305 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * The element type for each depth
+ */
+#define TYPE_8   uint8_t
+#define TYPE_16  uint16_t
+#define TYPE_32  uint32_t
+#define TYPE_64  uint64_t
+#define TYPE_f   float
+#define TYPE_d   double
+
+/**
+ * The index in the translator table for each depth
+ */
+#define INDEX_8   0
+#define INDEX_16  1
+#define INDEX_32  2
+#define INDEX_64  3
+#define INDEX_f   4
+#define INDEX_d   5
+
+
+/**
+ * Convert a [0, 1] `float` to a full range `uint64_t`
+ * and mark sure rounding errors does not cause the
+ * value be 0 instead of ~0 and vice versa
+ *
+ * @param   value  To `float` to convert
+ * @return         The value as an `uint64_t`
+ */
+static inline uint64_t
+float_to_64(float value)
+{
+	/* TODO Which is faster? */
+
+#if defined(HAVE_INT128) && __WORDSIZE == 64
+	/* `__int128` is a GNU C extension, which
+	 * (because it is not ISO C) emits a warning
+	 * under -pedantic */
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wpedantic"
+
+	/* In GCC we can use `__int128`, this is
+	 * a signed 128-bit integer. It fits all
+	 * uint64_t values but also native values,
+	 * which is a nice because it eleminates
+	 * some overflow condition tests. It is
+	 * also more readable. */
+
+	/* Convert to integer */
+	__int128 product = (__int128)(value * (float)UINT64_MAX);
+	/* Negative overflow */
+	if (product > UINT64_MAX)
+		return UINT64_MAX;
+	/* Positive overflow */
+	if (product < 0)
+		return 0;
+	/* Did not overflow */
+	return (uint64_t)product;
+
+# pragma GCC diagnostic pop
+#else
+
+	/* If we are not using GCC we cannot be
+	 * sure that we have `__int128` so we have
+	 * to use `uint64_t` and perform overflow
+	 * checkes based on the input value */
+
+	/* Convert to integer. */
+	uint64_t product = (uint64_t)(value * (float)UINT64_MAX);
+	/* Negative overflow,
+	 * if the input is less than 0.5 but
+	 * the output is greater then we got
+	 * -1 when we should have gotten 0 */
+	if (value < 0.1f && product > 0xF000000000000000ULL)
+		return 0;
+	/* Positive overflow,
+	 * if the input is greater than 0.5
+	 * but the output is less then we got
+	 * 0 when we should have gotten ~0 */
+	else if (value > 0.9f && product < 0x1000000000000000ULL)
+		return (uint64_t)~0;
+	/* Did not overflow */
+	return product;
+
+#endif
+}
+
+
+/**
+ * Convert a [0, 1] `double` to a full range `uint64_t`
+ * and mark sure rounding errors does not cause the
+ * value be 0 instead of ~0 and vice versa
+ *
+ * @param   value  To `double` to convert
+ * @return         The value as an `uint64_t`
+ */
+static inline uint64_t
+double_to_64(double value)
+{
+	/* TODO Which is faster? */
+
+#if defined(HAVE_INT128) && __WORDSIZE == 64
+	/* `__int128` is a GNU C extension, which
+	 * (because it is not ISO C) emits a warning
+	 * under -pedantic */
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wpedantic"
+
+	/* In GCC we can use `__int128`, this is
+	 * a signed 128-bit integer. It fits all
+	 * uint64_t values but also native values,
+	 * which is a nice because it eleminates
+	 * some overflow condition tests. It is
+	 * also more readable. */
+
+	/* Convert to integer */
+	__int128 product = (__int128)(value * (double)UINT64_MAX);
+	/* Negative overflow */
+	if (product > UINT64_MAX)
+		return UINT64_MAX;
+	/* Positive overflow */
+	if (product < 0)
+		return 0;
+	/* Did not overflow */
+	return (uint64_t)product;
+
+# pragma GCC diagnostic pop
+#else
+
+	/* If we are not using GCC we cannot be
+	 * sure that we have `__int128` so we have
+	 * to use `uint64_t` and perform overflow
+	 * checkes based on the input value. */
+
+	/* Convert to integer. */
+	uint64_t product = (uint64_t)(value * (double)UINT64_MAX);
+	/* Negative overflow,
+	 * if the input is less than 0.5 but
+	 * the output is greater then we got
+	 * -1 when we should have gotten 0 */
+	if (value < (double)0.1f && product > 0xF000000000000000ULL)
+		product = 0;
+	/* Positive overflow,
+	 * if the input is greater than 0.5
+	 * but the output is less then we got
+	 * 0 when we should have gotten ~0 */
+	else if (value > (double)0.9f && (product < 0x1000000000000000ULL))
+		product = (uint64_t)~0;
+	/* Did not overflow */
+	return product;
+
+#endif
+}
+
+
+/**
+ * Convert a full range `uint64_t` to a [0, 1] `float`
+ *
+ * @param   value  The `uint64_t` to convert
+ * @return         The value as a `float`
+ */
+static inline float
+float_from_64(uint64_t value)
+{
+	return (float)value / (float)UINT64_MAX;
+}
+
+
+/**
+ * Convert a full range `uint64_t` to a [0, 1] `double`
+ *
+ * @param   value  The `uint64_t` to convert
+ * @return         The value as a `double`
+ */
+static inline double
+double_from_64(uint64_t value)
+{
+	return (double)value / (double)UINT64_MAX;
+}
+
+
+/**
+ * The conversion of a single stop, `v`, for each pair of
+ * output depth and input depth
+ *
+ * Integer to integer conversions are done directly, and are
+ * identical to widening to 64 bits (multiplication by
+ * 0x0101…) and narrowing back (integer division by 0x0101…),
+ * but without the intermediate. Floating point conversions
+ * go through a `uint64_t` scalar so that the result is
+ * identical to that of `libgamma_internal_translate_to_64`
+ * followed by `libgamma_internal_translate_from_64`.
+ *
+ * @param  X:macro  Macro that expands, with the parameters
+ *                  (output depth suffix, input depth suffix, expression)
+ */
+#define LIST_TRANSLATIONS(X)\
+	X( 8,  8, v)\
+	X( 8, 16, v / UINT16_C(0x0101))\
+	X( 8, 32, v / UINT32_C(0x01010101))\
+	X( 8, 64, v / UINT64_C(0x0101010101010101))\
+	X( 8,  f,  float_to_64(v) / UINT64_C(0x0101010101010101))\
+	X( 8,  d, double_to_64(v) / UINT64_C(0x0101010101010101))\
+	X(16,  8, v * UINT16_C(0x0101))\
+	X(16, 16, v)\
+	X(16, 32, v / UINT32_C(0x00010001))\
+	X(16, 64, v / UINT64_C(0x0001000100010001))\
+	X(16,  f,  float_to_64(v) / UINT64_C(0x0001000100010001))\
+	X(16,  d, double_to_64(v) / UINT64_C(0x0001000100010001))\
+	X(32,  8, v * UINT32_C(0x01010101))\
+	X(32, 16, v * UINT32_C(0x00010001))\
+	X(32, 32, v)\
+	X(32, 64, v / UINT64_C(0x0000000100000001))\
+	X(32,  f,  float_to_64(v) / UINT64_C(0x0000000100000001))\
+	X(32,  d, double_to_64(v) / UINT64_C(0x0000000100000001))\
+	X(64,  8, v * UINT64_C(0x0101010101010101))\
+	X(64, 16, v * UINT64_C(0x0001000100010001))\
+	X(64, 32, v * UINT64_C(0x0000000100000001))\
+	X(64, 64, v)\
+	X(64,  f,  float_to_64(v))\
+	X(64,  d, double_to_64(v))\
+	X( f,  8,  float_from_64(v * UINT64_C(0x0101010101010101)))\
+	X( f, 16,  float_from_64(v * UINT64_C(0x0001000100010001)))\
+	X( f, 32,  float_from_64(v * UINT64_C(0x0000000100000001)))\
+	X( f, 64,  float_from_64(v))\
+	X( f,  f,  float_from_64(float_to_64(v)))\
+	X( f,  d,  float_from_64(double_to_64(v)))\
+	X( d,  8, double_from_64(v * UINT64_C(0x0101010101010101)))\
+	X( d, 16, double_from_64(v * UINT64_C(0x0001000100010001)))\
+	X( d, 32, double_from_64(v * UINT64_C(0x0000000100000001)))\
+	X( d, 64, double_from_64(v))\
+	X( d,  f, double_from_64(float_to_64(v)))\
+	X( d,  d, double_from_64(double_to_64(v)))
+
+
+/* Define the translators */
+#define X(OUT, IN, EXPRESSION)\
+	static void\
+	translate_##IN##_to_##OUT(size_t n, void *restrict out_, const void *restrict in_)\
+	{\
+		TYPE_##OUT *restrict out = out_;\
+		const TYPE_##IN *restrict in = in_;\
+		TYPE_##IN v;\
+		size_t i;\
+		for (i = 0; i < n; i++) {\
+			v = in[i];\
+			out[i] = (TYPE_##OUT)(EXPRESSION);\
+		}\
+	}
+LIST_TRANSLATIONS(X)
+#undef X
+
+
+/**
+ * Table of translators, indexed by output depth and input depth
+ */
+static translate_fun *const translators[6][6] = {
+#define X(OUT, IN, EXPRESSION)\
+	[INDEX_##OUT][INDEX_##IN] = &translate_##IN##_to_##OUT,
+	LIST_TRANSLATIONS(X)
+#undef X
+};
+
+
+/**
+ * Get the table index of a gamma ramp depth
+ *
+ * @param   depth  The depth of the gamma ramp, `-1` for `float`, `-2` for `double`
+ * @return         The index of the depth in `translators`
+ */
+static size_t
+depth_index(signed depth)
+{
+	switch (depth) {
+	case  8:  return INDEX_8;
+	case 16:  return INDEX_16;
+	case 32:  return INDEX_32;
+	case 64:  return INDEX_64;
+	case -1:  return INDEX_f;
+	case -2:  return INDEX_d;
+	default:
+		/* This is not possible */
+		abort();
+	}
+}
+
+
+/**
+ * Get the function that translates a gamma ramp
+ * directly from one depth to another, without
+ * using any SIMD instructions
+ *
+ * @param   depth_out  The depth of the output gamma ramp, `-1` for `float`, `-2` for `double`
+ * @param   depth_in   The depth of the input gamma ramp, `-1` for `float`, `-2` for `double`
+ * @return             Function that translates `n` stops from `in` to `out`
+ */
+translate_fun *
+libgamma_internal_scalar_translator(signed depth_out, signed depth_in)
+{
+	return translators[depth_index(depth_out)][depth_index(depth_in)];
+}
@@ -0,0 +1,293 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+#if defined(__GNUC__) && defined(__has_builtin)
+# if __has_builtin(__builtin_convertvector)
+#  if defined(__x86_64__) || defined(__i386__)
+#   define HAVE_SIMD_TRANSLATORS
+#  elif defined(__aarch64__)
+#   define HAVE_SIMD_TRANSLATORS
+#   ifdef __linux__
+#    include <sys/auxv.h>
+#    include <asm/hwcap.h>
+#   endif
+#  endif
+# endif
+#endif
+
+/* The floating point kernels are only bit-exact with the scalar
+ * translators when those use `__int128` for clamping */
+#if defined(HAVE_SIMD_TRANSLATORS) && defined(HAVE_INT128) && __WORDSIZE == 64
+# define HAVE_SIMD_FLOAT_TRANSLATORS
+#endif
+
+
+#ifdef HAVE_SIMD_TRANSLATORS
+
+/**
+ * The element type for each depth
+ */
+#define TYPE_8   uint8_t
+#define TYPE_16  uint16_t
+#define TYPE_32  uint32_t
+#define TYPE_64  uint64_t
+#define TYPE_f   float
+#define TYPE_d   double
+
+/**
+ * The vector type for each depth, these
+ * are defined inside each kernel
+ */
+#define VECTOR_8   vu8
+#define VECTOR_16  vu16
+#define VECTOR_32  vu32
+#define VECTOR_64  vu64
+#define VECTOR_f   vf
+#define VECTOR_d   vd
+
+/**
+ * The depth value for each depth
+ */
+#define DEPTH_8   8
+#define DEPTH_16  16
+#define DEPTH_32  32
+#define DEPTH_64  64
+#define DEPTH_f   -1
+#define DEPTH_d   -2
+
+/**
+ * The index in the translator tables for each depth
+ */
+#define INDEX_8   0
+#define INDEX_16  1
+#define INDEX_32  2
+#define INDEX_64  3
+#define INDEX_f   4
+#define INDEX_d   5
+
+
+/**
+ * The pairs of output depth and input
+ * depth that have SIMD translators
+ *
+ * @param  X:macro  Macro that expands, with the parameters
+ *                  (output depth suffix, input depth suffix)
+ */
+#ifdef HAVE_SIMD_FLOAT_TRANSLATORS
+# define LIST_SIMD_FLOAT_TRANSLATIONS(X)\
+	X( 8,  f)\
+	X(16,  f)
+#else
+# define LIST_SIMD_FLOAT_TRANSLATIONS(X)
+#endif
+#define LIST_SIMD_TRANSLATIONS(X)\
+	X(16,  8)\
+	X(32,  8)\
+	X(64,  8)\
+	X(32, 16)\
+	X(64, 16)\
+	X(64, 32)\
+	X( 8, 16)\
+	X( 8, 32)\
+	X( 8, 64)\
+	X(16, 32)\
+	X(16, 64)\
+	X(32, 64)\
+	LIST_SIMD_FLOAT_TRANSLATIONS(X)
+
+
+/**
+ * The name of a translator
+ */
+#define KERNEL_NAME(OUT, IN, SET)  KERNEL_NAME_(OUT, IN, SET)
+#define KERNEL_NAME_(OUT, IN, SET)  translate_##IN##_to_##OUT##_##SET
+
+/**
+ * The name of the table of translators in a kernel set
+ */
+#define KERNEL_TABLE(SET)  KERNEL_TABLE_(SET)
+#define KERNEL_TABLE_(SET)  translators_##SET
+
+/**
+ * Element-wise conversion of a vector to another vector type
+ */
+#define CONVERT(VECTOR, TYPE)  __builtin_convertvector(VECTOR, TYPE)
+
+/**
+ * Divide each element in an integer vector by (2 ↑ `BITS`) + 1,
+ * rounding down, given that the elements fits in 2 ⋅ `BITS` bits
+ */
+#define NARROW(VECTOR, BITS)  ((VECTOR) = ((VECTOR) - ((VECTOR) >> (BITS))) >> (BITS))
+
+/**
+ * Clamp each element in a floating point vector to [0, `MAX`],
+ * NaN is mapped to 0 (just like in the scalar translators);
+ * values at or above 2⁶³ ⋅ `MAX`, for which the scalar
+ * translators are undefined, are mapped to `MAX`
+ */
+#define CLAMP(VECTOR, TYPE, MASK_TYPE, MAX)\
+	do {\
+		MASK_TYPE mask__ = (MASK_TYPE)((VECTOR) > 0);\
+		(VECTOR) = (TYPE)((MASK_TYPE)(VECTOR) & mask__);\
+		mask__ = (MASK_TYPE)((VECTOR) < (double)(MAX));\
+		(VECTOR) = (TYPE)(((MASK_TYPE)(VECTOR) & mask__) | ((MASK_TYPE)((TYPE){0} + (double)(MAX)) & ~mask__));\
+	} while (0)
+
+
+# if defined(__x86_64__) || defined(__i386__)
+
+#  define KERNEL_SET avx2
+#  define LANES 32
+#  define TARGET "avx2"
+#  include "translate_simd.h"
+#  undef TARGET
+#  undef LANES
+#  undef KERNEL_SET
+
+#  define KERNEL_SET sse2
+#  define LANES 16
+#  define TARGET "sse2"
+#  include "translate_simd.h"
+#  undef TARGET
+#  undef LANES
+#  undef KERNEL_SET
+
+/**
+ * Check whether the CPU supports AVX2
+ *
+ * @return  1 if AVX2 is supported, 0 otherwise
+ */
+static int
+have_avx2(void)
+{
+	return __builtin_cpu_supports("avx2");
+}
+
+/**
+ * Check whether the CPU supports SSE2
+ *
+ * @return  1 if SSE2 is supported, 0 otherwise
+ */
+static int
+have_sse2(void)
+{
+	return __builtin_cpu_supports("sse2");
+}
+
+#  define LIST_KERNEL_SETS(X)\
+	X(avx2, have_avx2)\
+	X(sse2, have_sse2)
+
+# elif defined(__aarch64__)
+
+#  define KERNEL_SET neon
+#  define LANES 16
+#  include "translate_simd.h"
+#  undef LANES
+#  undef KERNEL_SET
+
+/**
+ * Check whether the CPU supports Advanced SIMD (NEON)
+ *
+ * @return  1 if Advanced SIMD is supported, 0 otherwise
+ */
+static int
+have_neon(void)
+{
+#  if defined(__linux__) && defined(HWCAP_ASIMD)
+	return !!(getauxval(AT_HWCAP) & HWCAP_ASIMD);
+#  else
+	return 1;
+#  endif
+}
+
+#  define LIST_KERNEL_SETS(X)\
+	X(neon, have_neon)
+
+# endif
+
+
+/**
+ * The kernel sets, in order of preference
+ */
+static const struct {
+	/**
+	 * Function that returns non-zero if the CPU supports the kernel set
+	 */
+	int (*supported)(void);
+
+	/**
+	 * The translators, indexed by output depth and input depth,
+	 * `NULL` where the kernel set has no translator
+	 */
+	translate_fun *const (*translators)[6];
+} kernel_sets[] = {
+#define X(SET, SUPPORTED)\
+	{SUPPORTED, KERNEL_TABLE(SET)},
+	LIST_KERNEL_SETS(X)
+#undef X
+};
+
+
+/**
+ * Get the table index of a gamma ramp depth
+ *
+ * @param   depth  The depth of the gamma ramp, `-1` for `float`, `-2` for `double`
+ * @return         The index of the depth in the translator tables
+ */
+static size_t
+depth_index(signed depth)
+{
+	switch (depth) {
+	case  8:  return INDEX_8;
+	case 16:  return INDEX_16;
+	case 32:  return INDEX_32;
+	case 64:  return INDEX_64;
+	case -1:  return INDEX_f;
+	case -2:  return INDEX_d;
+	default:
+		/* This is not possible */
+		abort();
+	}
+}
+
+#endif
+
+
+/**
+ * The number of SIMD kernel sets compiled into the library
+ */
+#ifdef HAVE_SIMD_TRANSLATORS
+const size_t libgamma_internal_simd_kernel_sets = sizeof(kernel_sets) / sizeof(*kernel_sets);
+#else
+const size_t libgamma_internal_simd_kernel_sets = 0;
+#endif
+
+
+/**
+ * Get the function that translates a gamma ramp directly
+ * from one depth to another using SIMD instructions
+ *
+ * @param   depth_out  The depth of the output gamma ramp, `-1` for `float`, `-2` for `double`
+ * @param   depth_in   The depth of the input gamma ramp, `-1` for `float`, `-2` for `double`
+ * @param   set        The index of the kernel set to use, less than
+ *                     `libgamma_internal_simd_kernel_sets`, lower
+ *                     values are preferred
+ * @return             Function that translates `n` stops from `in` to `out`,
+ *                     `NULL` if the kernel set is not supported by the CPU
+ *                     or does not have a translator for the pair of depths
+ */
+translate_fun *
+libgamma_internal_simd_translator(signed depth_out, signed depth_in, size_t set)
+{
+#ifdef HAVE_SIMD_TRANSLATORS
+	if (set >= libgamma_internal_simd_kernel_sets || !kernel_sets[set].supported())
+		return NULL;
+	return kernel_sets[set].translators[depth_index(depth_out)][depth_index(depth_in)];
+#else
+	(void) depth_out;
+	(void) depth_in;
+	(void) set;
+	return NULL;
+#endif
+}
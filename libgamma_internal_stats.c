@@ -0,0 +1,8 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * The state of the runtime statistics
+ */
+struct libgamma_internal_stats libgamma_internal_stats;
@@ -0,0 +1,22 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Add to a counter in the runtime statistics, if statistics are collected
+ * 
+ * @param  method   The adjustment method
+ * @param  counter  The counter
+ * @param  amount   The amount to add to the counter
+ */
+void
+libgamma_internal_stats_add(int method, enum libgamma_internal_stats_counter counter, unsigned long long int amount)
+{
+	struct libgamma_internal_stats_shard *shard;
+	if (!atomic_load_explicit(&libgamma_internal_stats.enabled, memory_order_relaxed))
+		return;
+	if (method < 0 || method >= LIBGAMMA_METHOD_COUNT)
+		return;
+	shard = libgamma_internal_stats_shard();
+	atomic_fetch_add_explicit(&shard->methods[method].counters[counter], amount, memory_order_relaxed);
+}
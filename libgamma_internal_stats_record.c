@@ -0,0 +1,47 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Record a call to an adjustment method in the runtime statistics
+ * 
+ * @param  method     The adjustment method
+ * @param  operation  The operation
+ * @param  start      The return value of `libgamma_internal_stats_start`
+ *                    before the call, nothing is recorded if it is 0
+ * @param  error      Non-zero if the call failed
+ */
+void
+libgamma_internal_stats_record(int method, enum libgamma_stats_operation operation, unsigned long long int start, int error)
+{
+	struct libgamma_internal_stats_shard *shard;
+	struct timespec ts;
+	unsigned long long int t, latency;
+	size_t bucket;
+	int saved_errno = errno;
+
+	if (!start || method < 0 || method >= LIBGAMMA_METHOD_COUNT)
+		return;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts)) {
+		errno = saved_errno;
+		return;
+	}
+	t = (unsigned long long int)ts.tv_sec * 1000000000ULL + (unsigned long long int)ts.tv_nsec;
+	latency = t > start ? t - start : 0;
+
+	/* The latency is bucketed by the position of its most significant bit */
+	for (bucket = 0; bucket < LIBGAMMA_STATS_LATENCY_BUCKETS - 1 && latency >> (bucket + 1); bucket++);
+
+	/* Only this thread uses the set of counters, unless there are
+	 * more threads than sets, so the atomic additions are uncontended */
+	shard = libgamma_internal_stats_shard();
+#define ADD(COUNTER, AMOUNT)\
+	atomic_fetch_add_explicit(&shard->methods[method].operations[operation].COUNTER, AMOUNT, memory_order_relaxed)
+	ADD(calls, 1);
+	if (error)
+		ADD(errors, 1);
+	ADD(total_time, latency);
+	ADD(latency_histogram[bucket], 1);
+#undef ADD
+}
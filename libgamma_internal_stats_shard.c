@@ -0,0 +1,29 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * The calling thread's set of statistics counters,
+ * `NULL` until it has been assigned one
+ */
+static _Thread_local struct libgamma_internal_stats_shard *shard = NULL;
+
+
+/**
+ * Get the set of statistics counters for the calling thread
+ * 
+ * @return  The thread's set of counters
+ */
+struct libgamma_internal_stats_shard *
+libgamma_internal_stats_shard(void)
+{
+	unsigned int i;
+	if (!shard) {
+		/* The sets are handed out round-robin, so they are only shared
+		 * if there are more threads than sets; the counters are atomic,
+		 * so sharing a set does not lose counts, it is only slower */
+		i = atomic_fetch_add_explicit(&libgamma_internal_stats.threads, 1, memory_order_relaxed);
+		shard = &libgamma_internal_stats.shards[i % LIBGAMMA_INTERNAL_STATS_SHARDS];
+	}
+	return shard;
+}
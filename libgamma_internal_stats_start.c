@@ -0,0 +1,25 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the time when an operation is started, for
+ * `libgamma_internal_stats_record`, if statistics
+ * are collected
+ * 
+ * @return  The time, in nanoseconds, on a clock that cannot
+ *          be set, 0 if statistics are not collected
+ */
+unsigned long long int
+libgamma_internal_stats_start(void)
+{
+	struct timespec ts;
+	unsigned long long int t;
+	if (!atomic_load_explicit(&libgamma_internal_stats.enabled, memory_order_relaxed))
+		return 0;
+	if (clock_gettime(CLOCK_MONOTONIC, &ts))
+		return 0;
+	t = (unsigned long long int)ts.tv_sec * 1000000000ULL + (unsigned long long int)ts.tv_nsec;
+	/* 0 means that statistics are not collected */
+	return t ? t : 1;
+}
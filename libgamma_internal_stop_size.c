@@ -0,0 +1,22 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the size of a stop in a gamma ramp
+ * 
+ * @param   depth  The depth of the gamma ramp, `-1` for `float`, `-2` for `double`
+ * @return         The size of a stop, in bytes
+ */
+size_t
+libgamma_internal_stop_size(signed depth)
+{
+	switch (depth) {
+	case  8:  return sizeof(uint8_t);
+	case 16:  return sizeof(uint16_t);
+	case 32:  return sizeof(uint32_t);
+	case 64:  return sizeof(uint64_t);
+	case -1:  return sizeof(float);
+	default:  return sizeof(double);
+	}
+}
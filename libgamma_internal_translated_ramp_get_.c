@@ -30,11 +30,12 @@ libgamma_internal_translated_ramp_get_(struct libgamma_crtc_state *restrict this
 	size_t n;
 	int r;
 	union gamma_ramps_any ramps_sys;
-	uint64_t *restrict ramps_full = NULL;
-  
+	translate_fun *translate = libgamma_internal_translator(depth_user, depth_system);
+
 	/* Allocate ramps with proper data type */
 	if ((r = libgamma_internal_allocated_any_ramp(&ramps_sys, ramps, depth_system, &n)))
 		return r;
+	libgamma_internal_stats_add(this->partition->site->method, LIBGAMMA_INTERNAL_STATS_ALLOCATIONS, 1);
 
 	/* Fill the ramps */
 	if ((r = fun(this, &ramps_sys))) {
@@ -42,26 +43,13 @@ libgamma_internal_translated_ramp_get_(struct libgamma_crtc_state *restrict this
 		return r;
 	}
 
-	/* Allocate intermediary ramps */
-	if (n) {
-		if (n > SIZE_MAX / sizeof(*ramps_full)) {
-			errno = ENOMEM;
-			free(ramps_sys.ANY.red);
-			return LIBGAMMA_ERRNO_SET;
-		}
-		ramps_full = malloc(n * sizeof(*ramps_full));
-		if (!ramps_full) {
-			free(ramps_sys.ANY.red);
-			return LIBGAMMA_ERRNO_SET;
-		}
-	}
+	/* Translate ramps to the user's format */
+	translate(ramps->ANY.red_size,   ramps->ANY.red,   ramps_sys.ANY.red);
+	translate(ramps->ANY.green_size, ramps->ANY.green, ramps_sys.ANY.green);
+	translate(ramps->ANY.blue_size,  ramps->ANY.blue,  ramps_sys.ANY.blue);
+	libgamma_internal_stats_add(this->partition->site->method, LIBGAMMA_INTERNAL_STATS_TRANSLATED_BYTES,
+	                            n * libgamma_internal_stop_size(depth_user));
 
-	/* Translate ramps to 64-bit integers */
-	libgamma_internal_translate_to_64(depth_system, n, ramps_full, &ramps_sys);
 	free(ramps_sys.ANY.red);
-
-	/* Translate ramps to the user's format */
-	libgamma_internal_translate_from_64(depth_user, n, ramps, ramps_full);
-	free(ramps_full);
 	return 0;
 }
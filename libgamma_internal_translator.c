@@ -0,0 +1,25 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the function that translates a gamma ramp
+ * directly from one depth to another
+ *
+ * SIMD translators are used if available and supported
+ * by the CPU, otherwise scalar translators are used
+ *
+ * @param   depth_out  The depth of the output gamma ramp, `-1` for `float`, `-2` for `double`
+ * @param   depth_in   The depth of the input gamma ramp, `-1` for `float`, `-2` for `double`
+ * @return             Function that translates `n` stops from `in` to `out`
+ */
+translate_fun *
+libgamma_internal_translator(signed depth_out, signed depth_in)
+{
+	translate_fun *translator;
+	size_t i;
+	for (i = 0; i < libgamma_internal_simd_kernel_sets; i++)
+		if ((translator = libgamma_internal_simd_translator(depth_out, depth_in, i)))
+			return translator;
+	return libgamma_internal_scalar_translator(depth_out, depth_in);
+}
@@ -0,0 +1,91 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Just an arbitrary version
+ */
+#define ANY bits64
+
+
+/**
+ * Mix a 64-bit word into a fingerprint
+ * 
+ * @param   h  The fingerprint so far
+ * @param   w  The word
+ * @return     The new fingerprint
+ */
+static uint64_t
+mix(uint64_t h, uint64_t w)
+{
+	h ^= w;
+	h *= UINT64_C(0x9E3779B97F4A7C15);
+	h ^= h >> 29;
+	return h;
+}
+
+
+/**
+ * Mix a gamma ramp into a fingerprint
+ * 
+ * @param   h  The fingerprint so far
+ * @param   p  The gamma ramp
+ * @param   n  The size of the gamma ramp, in bytes
+ * @return     The new fingerprint
+ */
+static uint64_t
+mix_ramp(uint64_t h, const void *p, size_t n)
+{
+	const unsigned char *b = p;
+	uint64_t w;
+	for (; n >= sizeof(w); n -= sizeof(w), b += sizeof(w)) {
+		memcpy(&w, b, sizeof(w));
+		h = mix(h, w);
+	}
+	if (n) {
+		w = 0;
+		memcpy(&w, b, n);
+		h = mix(h, w);
+	}
+	return h;
+}
+
+
+/**
+ * Check whether writing gamma ramps to a CRTC can be
+ * skipped because `this->deduplicate_writes` is set and
+ * the gamma ramps are identical to the gamma ramps that
+ * were last applied to the CRTC
+ * 
+ * @param   this         The CRTC state
+ * @param   ramps        The gamma ramps that are about to be applied
+ * @param   depth        The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @param   fingerprint  Output parameter for the fingerprint of `ramps`, to be passed
+ *                       to `libgamma_internal_record_write`
+ * @return               1 if the write can be skipped, 0 otherwise
+ */
+int
+libgamma_internal_write_is_redundant(struct libgamma_crtc_state *restrict this, const union gamma_ramps_any *restrict ramps,
+                                     signed depth, uint64_t *restrict fingerprint)
+{
+	size_t n;
+	uint64_t h;
+
+	*fingerprint = 0;
+	if (!this->deduplicate_writes)
+		return 0;
+
+	n = libgamma_internal_stop_size(depth);
+	h = mix(UINT64_C(0xCBF29CE484222325), (uint64_t)(int64_t)depth);
+	h = mix(h, (uint64_t)ramps->ANY.red_size);
+	h = mix(h, (uint64_t)ramps->ANY.green_size);
+	h = mix(h, (uint64_t)ramps->ANY.blue_size);
+	h = mix_ramp(h, ramps->ANY.red,   ramps->ANY.red_size   * n);
+	h = mix_ramp(h, ramps->ANY.green, ramps->ANY.green_size * n);
+	h = mix_ramp(h, ramps->ANY.blue,  ramps->ANY.blue_size  * n);
+	*fingerprint = h;
+
+	return this->applied_depth == depth &&
+	       this->applied_fingerprint == h &&
+	       this->applied_generation == this->partition->generation;
+}
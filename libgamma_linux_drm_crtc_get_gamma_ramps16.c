@@ -3,6 +3,43 @@
 #include "common.h"
 
 
+/**
+ * Get the current gamma ramps for a CRTC from its "GAMMA_LUT" property
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to fill with the current values
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+static int
+get_gamma_lut(struct libgamma_crtc_state *restrict this, struct libgamma_gamma_ramps16 *restrict ramps)
+{
+	drmModePropertyBlobRes *blob;
+	const struct drm_color_lut *lut;
+	size_t i, n = ramps->red_size;
+	int r;
+
+	if ((r = libgamma_linux_drm_internal_get_gamma_lut(this, n, &blob)))
+		return r;
+
+	/* Without a blob, the gamma ramps are bypassed, which is the identity */
+	if (!blob) {
+		for (i = 0; i < n; i++)
+			ramps->red[i] = ramps->green[i] = ramps->blue[i] = libgamma_linux_drm_internal_identity_stop(i, n);
+		return 0;
+	}
+
+	lut = blob->data;
+	for (i = 0; i < n; i++) {
+		ramps->red[i]   = lut[i].red;
+		ramps->green[i] = lut[i].green;
+		ramps->blue[i]  = lut[i].blue;
+	}
+	drmModeFreePropertyBlob(blob);
+	return 0;
+}
+
+
 /**
  * Get the current gamma ramps for a CRTC, 16-bit gamma-depth version
  * 
@@ -21,7 +58,9 @@ libgamma_linux_drm_crtc_get_gamma_ramps16(struct libgamma_crtc_state *restrict t
 	if (ramps->red_size != ramps->green_size || ramps->red_size != ramps->blue_size)
 		return LIBGAMMA_MIXED_GAMMA_RAMP_SIZE;
 #endif
-	/* Read current gamma ramps */
+	/* Read current gamma ramps, from the "GAMMA_LUT" property if atomic modesetting is used */
+	if (card->gamma_lut_props[this->crtc])
+		return get_gamma_lut(this, ramps);
 	r = drmModeCrtcGetGamma(card->fd, (uint32_t)(size_t)this->data, (uint32_t)ramps->red_size,
 				ramps->red, ramps->green, ramps->blue);
 	return r ? LIBGAMMA_GAMMA_RAMP_READ_FAILED : 0;
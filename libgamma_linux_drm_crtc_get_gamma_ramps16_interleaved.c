@@ -0,0 +1,63 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Get the current gamma ramps for a CRTC, interleaved 16-bit gamma-depth version
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to fill with the current values
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+int
+libgamma_linux_drm_crtc_get_gamma_ramps16_interleaved(struct libgamma_crtc_state *restrict this,
+                                                      struct libgamma_gamma_ramps16_interleaved *restrict ramps)
+{
+	struct libgamma_drm_card_data *restrict card = this->partition->data;
+	struct libgamma_gamma_ramps16 planar;
+	drmModePropertyBlobRes *blob;
+	size_t i, n = ramps->size;
+	int r;
+
+	/* With atomic modesetting, the gamma ramps are already in the layout we use */
+	if (card->gamma_lut_props[this->crtc]) {
+		if ((r = libgamma_linux_drm_internal_get_gamma_lut(this, n, &blob)))
+			return r;
+		if (blob) {
+			memcpy(ramps->stops, blob->data, n * sizeof(*ramps->stops));
+			drmModeFreePropertyBlob(blob);
+			for (i = 0; i < n; i++)
+				ramps->stops[i].reserved = 0;
+		} else {
+			/* Without a blob, the gamma ramps are bypassed, which is the identity */
+			for (i = 0; i < n; i++) {
+				ramps->stops[i].red = ramps->stops[i].green = ramps->stops[i].blue = libgamma_linux_drm_internal_identity_stop(i, n);
+				ramps->stops[i].reserved = 0;
+			}
+		}
+		return 0;
+	}
+
+	/* The legacy gamma ioctl stores each channel separately */
+	if (n > SIZE_MAX / 3 / sizeof(*planar.red)) {
+		errno = ENOMEM;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	planar.red = libgamma_internal_ramps_buffer(this, 3 * n * sizeof(*planar.red));
+	if (!planar.red)
+		return LIBGAMMA_ERRNO_SET;
+	planar.red_size = planar.green_size = planar.blue_size = n;
+	planar.green = &planar.  red[n];
+	planar.blue  = &planar.green[n];
+	if ((r = libgamma_linux_drm_crtc_get_gamma_ramps16(this, &planar)))
+		return r;
+	for (i = 0; i < n; i++) {
+		ramps->stops[i].red      = planar.  red[i];
+		ramps->stops[i].green    = planar.green[i];
+		ramps->stops[i].blue     = planar. blue[i];
+		ramps->stops[i].reserved = 0;
+	}
+	return 0;
+}
@@ -0,0 +1,36 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Get the refresh period of the mode a CRTC is configured with
+ * 
+ * @param   this    The CRTC state
+ * @param   period  Output parameter for the refresh period, in
+ *                  milliseconds rounded to the nearest, at least 1
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library
+ */
+int
+libgamma_linux_drm_crtc_get_refresh_period(struct libgamma_crtc_state *restrict this, unsigned long int *restrict period)
+{
+	struct libgamma_drm_card_data *restrict card = this->partition->data;
+	drmModeCrtc *crtc;
+	uint32_t vrefresh;
+
+	crtc = drmModeGetCrtc(card->fd, (uint32_t)(size_t)this->data);
+	if (!crtc)
+		return LIBGAMMA_ERRNO_SET;
+	vrefresh = crtc->mode_valid ? crtc->mode.vrefresh : 0;
+	drmModeFreeCrtc(crtc);
+
+	/* Without a mode, the CRTC is not displaying anything */
+	if (!vrefresh)
+		return LIBGAMMA_CONNECTOR_DISABLED;
+
+	*period = (1000UL + vrefresh / 2) / vrefresh;
+	if (!*period)
+		*period = 1;
+	return 0;
+}
@@ -6,6 +6,9 @@
 /**
  * Restore the gamma ramps for a CRTC to the system settings for that CRTC.
  * 
+ * For DRM, these are the gamma ramps the CRTC had before they
+ * were first changed using the partition state
+ * 
  * @param   this  The CRTC state.
  * @return        Zero on success, otherwise (negative) the value of an
  *                error identifier provided by this library.
@@ -13,7 +16,5 @@
 int
 libgamma_linux_drm_crtc_restore(struct libgamma_crtc_state *restrict this)
 {
-	(void) this;
-	errno = ENOTSUP;
-	return LIBGAMMA_ERRNO_SET;
+	return libgamma_linux_drm_internal_restore_gammas(this->partition->data, this->crtc, this->crtc + 1);
 }
@@ -16,6 +16,8 @@ libgamma_linux_drm_crtc_set_gamma_ramps16(struct libgamma_crtc_state *restrict t
                                           const struct libgamma_gamma_ramps16 *restrict ramps)
 {
 	struct libgamma_drm_card_data *restrict card = this->partition->data;
+	struct drm_color_lut *lut;
+	size_t i;
 	int r;
 
 #ifdef DEBUG
@@ -24,6 +26,25 @@ libgamma_linux_drm_crtc_set_gamma_ramps16(struct libgamma_crtc_state *restrict t
 		return LIBGAMMA_MIXED_GAMMA_RAMP_SIZE;
 #endif
 
+	/* With atomic modesetting, the gamma ramps are interleaved into the
+	 * layout of the "GAMMA_LUT" property, which is what the kernel uses */
+	if (card->gamma_lut_props[this->crtc]) {
+		lut = libgamma_linux_drm_internal_lut_buffer(card, ramps->red_size);
+		if (!lut)
+			return LIBGAMMA_ERRNO_SET;
+		for (i = 0; i < ramps->red_size; i++) {
+			lut[i].red      = ramps->red[i];
+			lut[i].green    = ramps->green[i];
+			lut[i].blue     = ramps->blue[i];
+			lut[i].reserved = 0;
+		}
+		return libgamma_linux_drm_internal_set_gamma_lut(this, lut, ramps->red_size);
+	}
+
+	/* Save the current gamma ramps, so that the CRTC can be restored */
+	if ((r = libgamma_linux_drm_internal_save_gamma(this)))
+		return r;
+
 	/* Apply gamma ramps */
 	r = drmModeCrtcSetGamma(card->fd, (uint32_t)(size_t)this->data,
 	                        (uint32_t)ramps->red_size, ramps->red, ramps->green, ramps->blue);
@@ -41,6 +62,7 @@ libgamma_linux_drm_crtc_set_gamma_ramps16(struct libgamma_crtc_state *restrict t
 			/* It is hard to find documentation for DRM (in fact all of this is
 			 * just based on the functions names and some testing,) perhaps we
 			 * could get this if we are updating to fast. */
+			libgamma_internal_stats_add(LIBGAMMA_METHOD_LINUX_DRM, LIBGAMMA_INTERNAL_STATS_IGNORED_ERRORS, 1);
 			break;
 		case EBADF:
 		case ENODEV:
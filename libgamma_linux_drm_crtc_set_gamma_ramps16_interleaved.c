@@ -0,0 +1,50 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/* The interleaved gamma ramps have the same layout as the "GAMMA_LUT" property */
+_Static_assert(sizeof(struct libgamma_gamma_stop16) == sizeof(struct drm_color_lut), "struct libgamma_gamma_stop16 does not match struct drm_color_lut");
+_Static_assert(offsetof(struct libgamma_gamma_stop16, red)   == offsetof(struct drm_color_lut, red),   "struct libgamma_gamma_stop16 does not match struct drm_color_lut");
+_Static_assert(offsetof(struct libgamma_gamma_stop16, green) == offsetof(struct drm_color_lut, green), "struct libgamma_gamma_stop16 does not match struct drm_color_lut");
+_Static_assert(offsetof(struct libgamma_gamma_stop16, blue)  == offsetof(struct drm_color_lut, blue),  "struct libgamma_gamma_stop16 does not match struct drm_color_lut");
+
+
+/**
+ * Set the gamma ramps for a CRTC, interleaved 16-bit gamma-depth version
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to apply
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+int
+libgamma_linux_drm_crtc_set_gamma_ramps16_interleaved(struct libgamma_crtc_state *restrict this,
+                                                      const struct libgamma_gamma_ramps16_interleaved *restrict ramps)
+{
+	struct libgamma_drm_card_data *restrict card = this->partition->data;
+	struct libgamma_gamma_ramps16 planar;
+	size_t i, n = ramps->size;
+
+	/* With atomic modesetting, the gamma ramps are already in the layout the kernel uses */
+	if (card->gamma_lut_props[this->crtc])
+		return libgamma_linux_drm_internal_set_gamma_lut(this, (const void *)ramps->stops, n);
+
+	/* The legacy gamma ioctl stores each channel separately */
+	if (n > SIZE_MAX / 3 / sizeof(*planar.red)) {
+		errno = ENOMEM;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	planar.red = libgamma_internal_ramps_buffer(this, 3 * n * sizeof(*planar.red));
+	if (!planar.red)
+		return LIBGAMMA_ERRNO_SET;
+	planar.red_size = planar.green_size = planar.blue_size = n;
+	planar.green = &planar.  red[n];
+	planar.blue  = &planar.green[n];
+	for (i = 0; i < n; i++) {
+		planar.  red[i] = ramps->stops[i].red;
+		planar.green[i] = ramps->stops[i].green;
+		planar. blue[i] = ramps->stops[i].blue;
+	}
+	return libgamma_linux_drm_crtc_set_gamma_ramps16(this, &planar);
+}
@@ -14,50 +14,56 @@
 static drmModeConnector *
 find_connector(struct libgamma_crtc_state *restrict this, int *restrict error)
 {
-	uint32_t crtc_id = (uint32_t)(size_t)this->data;
 	struct libgamma_drm_card_data *restrict card = this->partition->data;
-	size_t i, n = (size_t)card->res->count_connectors;
-	/* Open connectors and encoders if not already opened */
+	size_t i, j, n = (size_t)card->res->count_connectors, m = (size_t)card->res->count_crtcs;
+	size_t index;
+	int fail = 0;
+
+	/* Allocate connector and encoder arrays, and the mapping from CRTC:s
+	 * to connectors, if not already allocated; we use `calloc` so all
+	 * connectors and encoders that have not been opened are `NULL` */
 	if (!card->connectors) {
-		/* Allocate connector and encoder arrays; we use `calloc`
-		 * so all non-loaded elements are `NULL` after an error */
-		card->connectors = calloc(n, sizeof(drmModeConnector *));
-		if (!card->connectors)
-			goto fail;
-		card->encoders = calloc(n, sizeof(drmModeEncoder *));
-		if (!card->encoders)
-			goto fail;
-		/* Fill connector and encoder arrays */
-		for (i = 0; i < n; i++) {
-			/* Get connector */
-			card->connectors[i] = drmModeGetConnector(card->fd, card->res->connectors[i]);
-			if (!card->connectors[i])
-				goto fail;
-			/* Get encoder if the connector is enabled. If it is disabled it
-			 * will not have an encoder, which is indicated by the encoder
-			 * ID being 0. In such case, leave the encoder to be `NULL`. */
-			if (card->connectors[i]->encoder_id) {
-				card->encoders[i] = drmModeGetEncoder(card->fd, card->connectors[i]->encoder_id);
-				if (!card->encoders[i])
-					goto fail;
-			}
+		card->connectors = calloc(n ? n : 1, sizeof(drmModeConnector *));
+		card->encoders = calloc(n ? n : 1, sizeof(drmModeEncoder *));
+		card->crtc_to_connector = malloc((m ? m : 1) * sizeof(*card->crtc_to_connector));
+		if (!card->connectors || !card->encoders || !card->crtc_to_connector) {
+			*error = errno;
+			libgamma_linux_drm_internal_release_connectors_and_encoders(card);
+			return NULL;
 		}
+		for (j = 0; j < m; j++)
+			card->crtc_to_connector[j] = SIZE_MAX;
+		card->connectors_scanned = 0;
 	}
+
 	/* No error has occurred yet */
 	*error = 0;
-	/* Find connector */
-	for (i = 0; i < n; i++)
-		if (card->encoders[i] && card->connectors[i] && card->encoders[i]->crtc_id == crtc_id)
-			return card->connectors[i];
-	/* We did not find the connector */
-	*error = LIBGAMMA_CONNECTOR_UNKNOWN;
-	return NULL;
 
-fail:
-	/* Report the error that got us here, release
-	 * resouces and exit with `NULL` for failure */
-	*error = errno;
-	libgamma_linux_drm_internal_release_connectors_and_encoders(card);
+	/* Open connectors, in order, until we find the CRTC's connector, unless
+	 * we already know it; connectors that cannot be opened are skipped, and
+	 * retried next time, but connectors that were opened are kept */
+	for (i = card->connectors_scanned; card->crtc_to_connector[this->crtc] == SIZE_MAX && i < n; i++) {
+		if (libgamma_linux_drm_internal_open_connector(card, i)) {
+			fail = fail ? fail : errno;
+			continue;
+		}
+		if (!fail)
+			card->connectors_scanned = i + 1;
+		/* Add the connector to the mapping, if the CRTC has multiple
+		 * connectors, the first one is used */
+		if (card->encoders[i])
+			for (j = 0; j < m; j++)
+				if (card->res->crtcs[j] == card->encoders[i]->crtc_id && card->crtc_to_connector[j] == SIZE_MAX)
+					card->crtc_to_connector[j] = i;
+	}
+
+	/* Look up the connector */
+	index = card->crtc_to_connector[this->crtc];
+	if (index != SIZE_MAX)
+		return card->connectors[index];
+
+	/* We did not find the connector */
+	*error = fail ? fail : LIBGAMMA_CONNECTOR_UNKNOWN;
 	return NULL;
 }
 
@@ -75,6 +81,14 @@ get_gamma_ramp_size(struct libgamma_crtc_information *restrict out, const struct
 	struct libgamma_drm_card_data *restrict card = crtc->partition->data;
 	uint32_t crtc_id = card->res->crtcs[crtc->crtc];
 	drmModeCrtc *restrict crtc_info;
+	/* With atomic modesetting, the size of the "GAMMA_LUT"
+	 * property is used, it is often larger than the size
+	 * of the legacy gamma ramps, which the driver would
+	 * otherwise have to interpolate */
+	if (card->gamma_lut_props[crtc->crtc]) {
+		out->red_gamma_size = out->green_gamma_size = out->blue_gamma_size = card->gamma_lut_sizes[crtc->crtc];
+		return (out->gamma_size_error = 0);
+	}
 	/* Get CRTC information */
 	errno = 0;
 	crtc_info = drmModeGetCrtc(card->fd, crtc_id);
@@ -238,10 +252,19 @@ read_connector_data(struct libgamma_crtc_state *restrict crtc, struct libgamma_c
 				return (out->connector_name_error = errno);
 		}
 
-		/* Get the number of connectors with the same type on the same graphics card */
-		for (i = c = 0; i < n && card->connectors[i] != connector; i++)
+		/* Get the number of connectors with the same type on the same graphics card,
+		 * that come before this connector; these should already be open, unless
+		 * they could not be opened when the CRTC's connector was looked up */
+		for (i = c = 0; i < n && card->connectors[i] != connector; i++) {
+			if (libgamma_linux_drm_internal_open_connector(card, i)) {
+				out->connector_name_error = errno;
+				free(out->connector_name);
+				out->connector_name = NULL;
+				return out->connector_name_error;
+			}
 			if (card->connectors[i]->connector_type == type)
 				c++;
+		}
 
 		/* Construct and store connect name that is unique to the graphics card */
 		sprintf(out->connector_name, "%s-%" PRIu32, connector_name_base, (uint32_t)(c + 1));
@@ -266,48 +289,43 @@ get_edid(struct libgamma_crtc_state *restrict crtc, struct libgamma_crtc_informa
 	struct libgamma_drm_card_data *restrict card = crtc->partition->data;
 	int prop_n = connector->count_props;
 	int prop_i;
-	drmModePropertyRes *restrict prop;
+	uint32_t blob_id = 0;
 	drmModePropertyBlobRes *restrict blob;
 
-	/* Test all properies on the connector */
-	for (prop_i = 0; prop_i < prop_n; prop_i++) {
-		/* Get output property */
-		prop = drmModeGetProperty(card->fd, connector->props[prop_i]);
-		if (!prop)
-			continue;
-		/* Is this property the EDID? */
-		if (!strcmp(prop->name, "EDID")) {
-			/* Get the property value */
-			blob = drmModeGetPropertyBlob(card->fd, (uint32_t)connector->prop_values[prop_i]);
-			if (!blob) {
-				drmModeFreeProperty(prop);
-				return (out->edid_error = LIBGAMMA_PROPERTY_VALUE_QUERY_FAILED);
-			}
-			if (blob->data) {
-				/* Get and store the length of the EDID */
-				out->edid_length = blob->length;
-				/* Allocate memory for a copy of the EDID that is under our memory control */
-				out->edid = malloc(out->edid_length * sizeof(unsigned char));
-				if (!out->edid) {
-					out->edid_error = errno;
-				} else {
-					/* Copy the EDID so we can free resources that got us here */
-					memcpy(out->edid, blob->data, (size_t)out->edid_length * sizeof(unsigned char));
-				}
-				/* Free the propriety value and the propery */
-				drmModeFreePropertyBlob(blob);
-				drmModeFreeProperty(prop);
-				/* Were we successful? */
-				return !out->edid;
-			}
-			/* Free the propriety value */
-			drmModeFreePropertyBlob(blob);
-		}
-		/* Free the propriety */
-		drmModeFreeProperty(prop);
+	/* Look up the ID of the EDID property, unless we already know it */
+	if (!card->edid_prop && prop_n > 0)
+		libgamma_linux_drm_internal_resolve_properties(card, connector->props, (size_t)prop_n);
+
+	/* Find the EDID property on the connector */
+	if (card->edid_prop)
+		for (prop_i = 0; prop_i < prop_n; prop_i++)
+			if (connector->props[prop_i] == card->edid_prop)
+				blob_id = (uint32_t)connector->prop_values[prop_i];
+	if (!blob_id)
+		return (out->edid_error = LIBGAMMA_EDID_NOT_FOUND);
+
+	/* Get the property value */
+	blob = drmModeGetPropertyBlob(card->fd, blob_id);
+	if (!blob)
+		return (out->edid_error = LIBGAMMA_PROPERTY_VALUE_QUERY_FAILED);
+	if (!blob->data) {
+		drmModeFreePropertyBlob(blob);
+		return (out->edid_error = LIBGAMMA_EDID_NOT_FOUND);
+	}
+	/* Get and store the length of the EDID */
+	out->edid_length = blob->length;
+	/* Allocate memory for a copy of the EDID that is under our memory control */
+	out->edid = malloc(out->edid_length * sizeof(unsigned char));
+	if (!out->edid) {
+		out->edid_error = errno;
+	} else {
+		/* Copy the EDID so we can free resources that got us here */
+		memcpy(out->edid, blob->data, (size_t)out->edid_length * sizeof(unsigned char));
 	}
-	/* If we get here, we did not find a EDID */
-	return (out->edid_error = LIBGAMMA_EDID_NOT_FOUND);
+	/* Free the propriety value */
+	drmModeFreePropertyBlob(blob);
+	/* Were we successful? */
+	return !out->edid;
 }
 
 
@@ -0,0 +1,71 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Apply all pending gamma ramps, for all CRTC:s on a
+ * graphics card, in one atomic commit, and release
+ * the property blobs
+ * 
+ * @param   this  The graphics card data
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_linux_drm_internal_commit_gamma_luts(struct libgamma_drm_card_data *restrict this)
+{
+	drmModeAtomicReq *req;
+	size_t i, n = (size_t)this->res->count_crtcs;
+	int r, have_any = 0;
+
+	/* Build the request, with every pending gamma ramp */
+	req = drmModeAtomicAlloc();
+	if (!req) {
+		libgamma_linux_drm_internal_discard_gamma_luts(this);
+		return LIBGAMMA_ERRNO_SET;
+	}
+	for (i = 0; i < n; i++) {
+		if (!this->pending_gamma_luts[i])
+			continue;
+		r = drmModeAtomicAddProperty(req, this->res->crtcs[i], this->gamma_lut_props[i], this->pending_gamma_luts[i]);
+		if (r < 0) {
+			drmModeAtomicFree(req);
+			libgamma_linux_drm_internal_discard_gamma_luts(this);
+			errno = -r;
+			return LIBGAMMA_ERRNO_SET;
+		}
+		have_any = 1;
+	}
+
+	/* Apply all gamma ramps at once; the commit is blocking, so it
+	 * does not fail with `EBUSY` just because an earlier commit has
+	 * not completed yet, and since the CRTC:s are updated together,
+	 * they are updated on the same frame */
+	r = have_any ? drmModeAtomicCommit(this->fd, req, 0, NULL) : 0;
+	if (r < -1)
+		errno = -r;
+	drmModeAtomicFree(req);
+
+	/* The kernel holds its own references to the blobs that were
+	 * applied, so ours can be released irrespective of the result */
+	libgamma_linux_drm_internal_discard_gamma_luts(this);
+
+	/* Check for errors */
+	if (r) {
+		switch (errno) {
+		case EACCES:
+			/* Permission denied errors must be ignored, because we do not
+			 * have permission to do this while a display server is active */
+			libgamma_internal_stats_add(LIBGAMMA_METHOD_LINUX_DRM, LIBGAMMA_INTERNAL_STATS_IGNORED_ERRORS, 1);
+			break;
+		case EBADF:
+		case ENODEV:
+		case ENXIO:
+			return LIBGAMMA_GRAPHICS_CARD_REMOVED;
+		default:
+			return LIBGAMMA_ERRNO_SET;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,25 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Release all pending gamma ramps without applying them
+ * 
+ * @param  this  The graphics card data
+ */
+void
+libgamma_linux_drm_internal_discard_gamma_luts(struct libgamma_drm_card_data *restrict this)
+{
+	size_t i, n = (size_t)this->res->count_crtcs;
+	int saved_errno = errno;
+	if (!this->pending_gamma_luts)
+		return;
+	for (i = 0; i < n; i++) {
+		if (this->pending_gamma_luts[i]) {
+			drmModeDestroyPropertyBlob(this->fd, this->pending_gamma_luts[i]);
+			this->pending_gamma_luts[i] = 0;
+		}
+	}
+	errno = saved_errno;
+}
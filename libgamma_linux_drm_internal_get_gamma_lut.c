@@ -0,0 +1,56 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Get the value of the "GAMMA_LUT" property of a CRTC
+ * 
+ * @param   this  The CRTC state, the CRTC must have the "GAMMA_LUT" property
+ * @param   n     The number of stops the gamma ramps are expected to have,
+ *                must be the CRTC's "GAMMA_LUT_SIZE"
+ * @param   blob  Output parameter for the property blob with the gamma ramps,
+ *                which shall be released with `drmModeFreePropertyBlob`;
+ *                `NULL` if the CRTC does not have any gamma ramps, which
+ *                means that gamma correction is bypassed, which is the
+ *                same as identity gamma ramps
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_linux_drm_internal_get_gamma_lut(struct libgamma_crtc_state *restrict this, size_t n,
+                                          drmModePropertyBlobRes **restrict blob)
+{
+	struct libgamma_drm_card_data *restrict card = this->partition->data;
+	drmModeObjectProperties *props;
+	uint32_t i, blob_id = 0;
+
+	*blob = NULL;
+
+	/* The kernel only accepts gamma ramps of the CRTC's size, and identity
+	 * gamma ramps can only be generated if they have at least two stops */
+	if (n != card->gamma_lut_sizes[this->crtc])
+		return LIBGAMMA_WRONG_GAMMA_RAMP_SIZE;
+
+	/* Get the ID of the blob with the current gamma ramps */
+	props = drmModeObjectGetProperties(card->fd, (uint32_t)(size_t)this->data, DRM_MODE_OBJECT_CRTC);
+	if (!props)
+		return LIBGAMMA_GAMMA_RAMP_READ_FAILED;
+	for (i = 0; i < props->count_props; i++)
+		if (props->props[i] == card->gamma_lut_props[this->crtc])
+			blob_id = (uint32_t)props->prop_values[i];
+	drmModeFreeObjectProperties(props);
+	if (!blob_id)
+		return 0;
+
+	/* Get the current gamma ramps */
+	*blob = drmModeGetPropertyBlob(card->fd, blob_id);
+	if (!*blob)
+		return LIBGAMMA_GAMMA_RAMP_READ_FAILED;
+	if ((*blob)->length != n * sizeof(struct drm_color_lut)) {
+		drmModeFreePropertyBlob(*blob);
+		*blob = NULL;
+		return LIBGAMMA_GAMMA_RAMP_READ_FAILED;
+	}
+	return 0;
+}
@@ -0,0 +1,18 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Get the value of a stop in identity gamma ramps, which
+ * is what a CRTC without a "GAMMA_LUT" blob applies
+ * 
+ * @param   i  The index of the stop
+ * @param   n  The number of stops in the gamma ramps, at least 2
+ * @return     The value of the stop
+ */
+uint16_t
+libgamma_linux_drm_internal_identity_stop(size_t i, size_t n)
+{
+	return (uint16_t)(i * UINT16_MAX / (n - 1));
+}
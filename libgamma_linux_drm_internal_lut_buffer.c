@@ -0,0 +1,32 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Get the graphics card's buffer for gamma ramps in
+ * the layout of the "GAMMA_LUT" property
+ * 
+ * @param   this  The graphics card data
+ * @param   n     The number of stops required
+ * @return        The buffer, `NULL` on error
+ */
+struct drm_color_lut *
+libgamma_linux_drm_internal_lut_buffer(struct libgamma_drm_card_data *restrict this, size_t n)
+{
+	struct drm_color_lut *new;
+	if (n > this->lut_buffer_size) {
+		if (n > SIZE_MAX / sizeof(*new)) {
+			errno = ENOMEM;
+			return NULL;
+		}
+		new = malloc(n * sizeof(*new));
+		if (!new)
+			return NULL;
+		libgamma_internal_stats_add(LIBGAMMA_METHOD_LINUX_DRM, LIBGAMMA_INTERNAL_STATS_ALLOCATIONS, 1);
+		free(this->lut_buffer);
+		this->lut_buffer = new;
+		this->lut_buffer_size = n;
+	}
+	return this->lut_buffer;
+}
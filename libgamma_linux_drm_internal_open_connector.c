@@ -0,0 +1,43 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Open a connector, and its encoder, unless already opened
+ * 
+ * @param   this  The graphics card data, `connectors` and
+ *                `encoders` must be allocated
+ * @param   i     The index of the connector
+ * @return        Zero on success, -1 on error
+ */
+int
+libgamma_linux_drm_internal_open_connector(struct libgamma_drm_card_data *restrict this, size_t i)
+{
+	int saved_errno;
+
+	if (this->connectors[i])
+		return 0;
+
+	/* Get connector */
+	this->connectors[i] = drmModeGetConnector(this->fd, this->res->connectors[i]);
+	if (!this->connectors[i])
+		return -1;
+
+	/* Get encoder if the connector is enabled. If it is disabled it
+	 * will not have an encoder, which is indicated by the encoder
+	 * ID being 0. In such case, leave the encoder to be `NULL`. */
+	if (this->connectors[i]->encoder_id) {
+		this->encoders[i] = drmModeGetEncoder(this->fd, this->connectors[i]->encoder_id);
+		if (!this->encoders[i]) {
+			/* Do not leave the connector half-opened */
+			saved_errno = errno;
+			drmModeFreeConnector(this->connectors[i]);
+			this->connectors[i] = NULL;
+			errno = saved_errno;
+			return -1;
+		}
+	}
+
+	return 0;
+}
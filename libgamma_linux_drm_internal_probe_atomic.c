@@ -0,0 +1,57 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Enable atomic modesetting, if supported, and look up
+ * the "GAMMA_LUT" and "GAMMA_LUT_SIZE" properties of
+ * each CRTC; failure is not an error, it just means
+ * that the legacy gamma ioctls will be used
+ * 
+ * @param   this  The graphics card data, `gamma_lut_props`
+ *                and `gamma_lut_sizes` must be allocated
+ *                and zero-initialised
+ */
+void
+libgamma_linux_drm_internal_probe_atomic(struct libgamma_drm_card_data *restrict this)
+{
+	drmModeObjectProperties *props;
+	size_t i, n = (size_t)this->res->count_crtcs;
+	uint32_t j, lut_prop, lut_size;
+	int saved_errno = errno;
+
+	/* Atomic modesetting is opt-in, and the kernel refuses
+	 * it if the driver does not support it */
+	this->atomic = !drmSetClientCap(this->fd, DRM_CLIENT_CAP_ATOMIC, 1);
+	if (!this->atomic)
+		goto out;
+
+	for (i = 0; i < n; i++) {
+		props = drmModeObjectGetProperties(this->fd, this->res->crtcs[i], DRM_MODE_OBJECT_CRTC);
+		if (!props)
+			continue;
+		/* The property IDs are the same for all CRTC:s, so
+		 * they only have to be looked up for the first CRTC */
+		if (!this->gamma_lut_prop || !this->gamma_lut_size_prop)
+			libgamma_linux_drm_internal_resolve_properties(this, props->props, (size_t)props->count_props);
+		lut_prop = lut_size = 0;
+		for (j = 0; j < props->count_props; j++) {
+			if (!props->props[j])
+				continue;
+			if (props->props[j] == this->gamma_lut_prop)
+				lut_prop = props->props[j];
+			else if (props->props[j] == this->gamma_lut_size_prop)
+				lut_size = (uint32_t)props->prop_values[j];
+		}
+		drmModeFreeObjectProperties(props);
+		/* Without a usable size, the legacy ioctls are used for the CRTC */
+		if (lut_prop && lut_size >= 2) {
+			this->gamma_lut_props[i] = lut_prop;
+			this->gamma_lut_sizes[i] = lut_size;
+		}
+	}
+
+out:
+	errno = saved_errno;
+}
@@ -0,0 +1,94 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Forget the gamma ramps a CRTC had before they were first changed,
+ * and its pending gamma ramps, because they do not have its current
+ * gamma ramp size; the gamma ramps will be saved again before they
+ * are next changed
+ * 
+ * @param  this  The graphics card data
+ * @param  crtc  The index of the CRTC
+ */
+static void
+forget_gamma(struct libgamma_drm_card_data *restrict this, size_t crtc)
+{
+	struct libgamma_drm_saved_gamma *restrict saved = &this->saved_gammas[crtc];
+	if (this->pending_gamma_luts[crtc]) {
+		drmModeDestroyPropertyBlob(this->fd, this->pending_gamma_luts[crtc]);
+		this->pending_gamma_luts[crtc] = 0;
+	}
+	if (saved->lut)
+		drmModeDestroyPropertyBlob(this->fd, saved->lut);
+	free(saved->ramps);
+	memset(saved, 0, sizeof(*saved));
+}
+
+
+/**
+ * Reload the mode resources of a graphics card, after its
+ * configuration has changed, forget the connectors, and
+ * look up the "GAMMA_LUT" and "GAMMA_LUT_SIZE" properties
+ * again, as the size of the gamma ramps may depend on the mode
+ * 
+ * @param   this  The graphics card data
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library; `errno`
+ *                is set to `ESTALE` if the CRTC:s have changed, in
+ *                which case the partition must be reinitialised
+ */
+int
+libgamma_linux_drm_internal_refresh_card(struct libgamma_drm_card_data *restrict this)
+{
+	drmModeRes *res;
+	uint32_t *old_props;
+	size_t i, n;
+
+	/* Acquire the new mode resources */
+	res = drmModeGetResources(this->fd);
+	if (!res)
+		return LIBGAMMA_ACQUIRING_MODE_RESOURCES_FAILED;
+
+	/* The CRTC states refer to the CRTC:s by their index,
+	 * so they cannot survive a change of the CRTC list */
+	if (res->count_crtcs != this->res->count_crtcs ||
+	    (res->count_crtcs > 0 && memcmp(res->crtcs, this->res->crtcs, (size_t)res->count_crtcs * sizeof(*res->crtcs)))) {
+		drmModeFreeResources(res);
+		errno = ESTALE;
+		return LIBGAMMA_ERRNO_SET;
+	}
+
+	/* The old properties and sizes are remembered, so that
+	 * gamma ramps of the old sizes can be forgotten */
+	n = (size_t)res->count_crtcs;
+	old_props = n ? malloc(2 * n * sizeof(*old_props)) : NULL;
+	if (n && !old_props) {
+		drmModeFreeResources(res);
+		return LIBGAMMA_ERRNO_SET;
+	}
+
+	/* The connectors are indexed by the old mode resources,
+	 * so they must be released before they are replaced */
+	libgamma_linux_drm_internal_release_connectors_and_encoders(this);
+	drmModeFreeResources(this->res);
+	this->res = res;
+
+	/* Probe the gamma ramps again */
+	if (n) {
+		memcpy(&old_props[0], this->gamma_lut_props, n * sizeof(*old_props));
+		memcpy(&old_props[n], this->gamma_lut_sizes, n * sizeof(*old_props));
+		memset(this->gamma_lut_props, 0, n * sizeof(*this->gamma_lut_props));
+		memset(this->gamma_lut_sizes, 0, n * sizeof(*this->gamma_lut_sizes));
+	}
+	libgamma_linux_drm_internal_probe_atomic(this);
+	for (i = 0; i < n; i++)
+		if (this->gamma_lut_props[i] != old_props[i] || this->gamma_lut_sizes[i] != old_props[n + i])
+			forget_gamma(this, i);
+	free(old_props);
+
+	/* Make the CRTC states discard their cached information */
+	this->partition->generation += 1;
+	return 0;
+}
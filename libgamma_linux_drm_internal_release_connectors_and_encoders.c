@@ -30,4 +30,9 @@ libgamma_linux_drm_internal_release_connectors_and_encoders(struct libgamma_drm_
 	/* Release connector array */
 	free(this->connectors);
 	this->connectors = NULL;
+
+	/* Release the mapping from CRTC:s to connectors */
+	free(this->crtc_to_connector);
+	this->crtc_to_connector = NULL;
+	this->connectors_scanned = 0;
 }
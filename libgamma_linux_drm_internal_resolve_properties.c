@@ -0,0 +1,48 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Look up the IDs of the properties in `LIST_DRM_PROPERTIES`,
+ * among the properties of a DRM object, properties whose
+ * IDs are already known are not looked up again
+ * 
+ * @param  this   The graphics card data
+ * @param  props  The IDs of the object's properties
+ * @param  n      The number of elements in `props`
+ */
+void
+libgamma_linux_drm_internal_resolve_properties(struct libgamma_drm_card_data *restrict this,
+                                               const uint32_t *restrict props, size_t n)
+{
+	drmModePropertyRes *prop;
+	size_t i;
+	int saved_errno = errno;
+
+	for (i = 0; i < n; i++) {
+		/* Skip properties we already know */
+#define X(NAME, FIELD)\
+		if (props[i] == this->FIELD)\
+			continue;
+		LIST_DRM_PROPERTIES(X)
+#undef X
+
+		/* Get the name of the property */
+		prop = drmModeGetProperty(this->fd, props[i]);
+		if (!prop)
+			continue;
+#define X(NAME, FIELD)\
+		if (!strcmp(prop->name, NAME))\
+			this->FIELD = prop->prop_id;\
+		else
+		LIST_DRM_PROPERTIES(X)
+#undef X
+		{
+			/* Not a property we use */
+		}
+		drmModeFreeProperty(prop);
+	}
+
+	errno = saved_errno;
+}
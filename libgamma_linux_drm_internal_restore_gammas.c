@@ -0,0 +1,103 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Get the error to report for a failure to apply gamma ramps
+ * 
+ * @return  Zero if the error shall be ignored, otherwise (negative) the
+ *          value of an error identifier provided by this library
+ */
+static int
+translate_error(void)
+{
+	switch (errno) {
+	case EACCES:
+	case EAGAIN:
+	case EIO:
+	case EBUSY:
+	case EINPROGRESS:
+		/* See `libgamma_linux_drm_crtc_set_gamma_ramps16` */
+		libgamma_internal_stats_add(LIBGAMMA_METHOD_LINUX_DRM, LIBGAMMA_INTERNAL_STATS_IGNORED_ERRORS, 1);
+		return 0;
+	case EBADF:
+	case ENODEV:
+	case ENXIO:
+		return LIBGAMMA_GRAPHICS_CARD_REMOVED;
+	default:
+		return LIBGAMMA_ERRNO_SET;
+	}
+}
+
+
+/**
+ * Restore the saved gamma ramps for a range of CRTC:s on a graphics
+ * card, all CRTC:s with the "GAMMA_LUT" property are restored in one
+ * atomic commit; pending gamma ramps for the CRTC:s are discarded
+ * 
+ * @param   this   The graphics card data
+ * @param   start  The index of the first CRTC to restore
+ * @param   end    The index of the CRTC after the last CRTC to restore
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+int
+libgamma_linux_drm_internal_restore_gammas(struct libgamma_drm_card_data *restrict this, size_t start, size_t end)
+{
+	struct libgamma_drm_saved_gamma *restrict saved;
+	drmModeAtomicReq *req = NULL;
+	size_t i;
+	uint32_t n;
+	int r, ret = 0, saved_errno = 0;
+
+	for (i = start; i < end; i++) {
+		saved = &this->saved_gammas[i];
+		if (!saved->saved)
+			continue;
+
+		/* Pending gamma ramps are superseded by the restored gamma ramps */
+		if (this->pending_gamma_luts[i]) {
+			drmModeDestroyPropertyBlob(this->fd, this->pending_gamma_luts[i]);
+			this->pending_gamma_luts[i] = 0;
+		}
+
+		if (this->gamma_lut_props[i]) {
+			/* With atomic modesetting, the CRTC is added to the batch;
+			 * the saved blob is kept, so that it can be restored again */
+			if (!req) {
+				req = drmModeAtomicAlloc();
+				if (!req)
+					return LIBGAMMA_ERRNO_SET;
+			}
+			r = drmModeAtomicAddProperty(req, this->res->crtcs[i], this->gamma_lut_props[i], saved->lut);
+			if (r < 0) {
+				drmModeAtomicFree(req);
+				errno = -r;
+				return LIBGAMMA_ERRNO_SET;
+			}
+		} else {
+			/* Otherwise, the CRTC is restored with the legacy gamma ioctl,
+			 * and we continue with the other CRTC:s even if it fails */
+			n = saved->size;
+			r = drmModeCrtcSetGamma(this->fd, this->res->crtcs[i], n,
+			                        &saved->ramps[0 * n], &saved->ramps[1 * n], &saved->ramps[2 * n]);
+			if (r && !ret && (ret = translate_error()))
+				saved_errno = errno;
+		}
+	}
+
+	/* Restore all CRTC:s with atomic modesetting at once */
+	if (req) {
+		r = drmModeAtomicCommit(this->fd, req, 0, NULL);
+		if (r < -1)
+			errno = -r;
+		drmModeAtomicFree(req);
+		if (r && !ret && (ret = translate_error()))
+			saved_errno = errno;
+	}
+
+	if (ret)
+		errno = saved_errno;
+	return ret;
+}
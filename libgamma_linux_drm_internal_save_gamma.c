@@ -0,0 +1,65 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Save the gamma ramps of a CRTC, so that it can be restored,
+ * unless they have already been saved; this shall be called
+ * before the gamma ramps are changed
+ * 
+ * @param   this  The CRTC state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_linux_drm_internal_save_gamma(struct libgamma_crtc_state *restrict this)
+{
+	struct libgamma_drm_card_data *restrict card = this->partition->data;
+	struct libgamma_drm_saved_gamma *restrict saved = &card->saved_gammas[this->crtc];
+	drmModePropertyBlobRes *blob;
+	drmModeCrtc *crtc;
+	uint16_t *ramps;
+	uint32_t n;
+	int r;
+
+	if (saved->saved)
+		return 0;
+
+	if (card->gamma_lut_props[this->crtc]) {
+		/* With atomic modesetting, the gamma ramps are copied into a property blob
+		 * of our own, as the current one may be destroyed by its owner */
+		if ((r = libgamma_linux_drm_internal_get_gamma_lut(this, card->gamma_lut_sizes[this->crtc], &blob)))
+			return r;
+		if (blob) {
+			r = drmModeCreatePropertyBlob(card->fd, blob->data, blob->length, &saved->lut);
+			drmModeFreePropertyBlob(blob);
+			if (r) {
+				if (r < -1)
+					errno = -r;
+				return (errno == EBADF || errno == ENODEV || errno == ENXIO) ? LIBGAMMA_GRAPHICS_CARD_REMOVED : LIBGAMMA_ERRNO_SET;
+			}
+		}
+	} else {
+		/* Otherwise, the gamma ramps are read with the legacy gamma ioctl */
+		crtc = drmModeGetCrtc(card->fd, (uint32_t)(size_t)this->data);
+		if (!crtc)
+			return LIBGAMMA_GAMMA_RAMP_READ_FAILED;
+		n = crtc->gamma_size > 0 ? (uint32_t)crtc->gamma_size : 0;
+		drmModeFreeCrtc(crtc);
+		if (!n)
+			return LIBGAMMA_GAMMA_RAMP_READ_FAILED;
+		ramps = malloc(3 * (size_t)n * sizeof(*ramps));
+		if (!ramps)
+			return LIBGAMMA_ERRNO_SET;
+		if (drmModeCrtcGetGamma(card->fd, (uint32_t)(size_t)this->data, n, &ramps[0 * n], &ramps[1 * n], &ramps[2 * n])) {
+			free(ramps);
+			return LIBGAMMA_GAMMA_RAMP_READ_FAILED;
+		}
+		saved->ramps = ramps;
+		saved->size = n;
+	}
+
+	saved->saved = 1;
+	return 0;
+}
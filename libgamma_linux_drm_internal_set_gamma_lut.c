@@ -0,0 +1,49 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Set the "GAMMA_LUT" property of a CRTC
+ * 
+ * The gamma ramps are uploaded as a property blob and applied with
+ * an atomic commit, which is deferred if the user wants to update
+ * multiple CRTC:s on the graphics card at once
+ * 
+ * @param   this  The CRTC state, the CRTC must have the "GAMMA_LUT" property
+ * @param   lut   The gamma ramps
+ * @param   n     The number of stops in `lut`
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_linux_drm_internal_set_gamma_lut(struct libgamma_crtc_state *restrict this,
+                                          const struct drm_color_lut *restrict lut, size_t n)
+{
+	struct libgamma_drm_card_data *restrict card = this->partition->data;
+	uint32_t blob;
+	int r;
+
+	/* Save the current gamma ramps, so that the CRTC can be restored */
+	if ((r = libgamma_linux_drm_internal_save_gamma(this)))
+		return r;
+
+	/* Upload the gamma ramps */
+	if (n > SIZE_MAX / sizeof(*lut)) {
+		errno = ENOMEM;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	r = drmModeCreatePropertyBlob(card->fd, lut, n * sizeof(*lut), &blob);
+	if (r) {
+		if (r < -1)
+			errno = -r;
+		return (errno == EBADF || errno == ENODEV || errno == ENXIO) ? LIBGAMMA_GRAPHICS_CARD_REMOVED : LIBGAMMA_ERRNO_SET;
+	}
+
+	/* If the CRTC already has pending gamma ramps, they are replaced */
+	if (card->pending_gamma_luts[this->crtc])
+		drmModeDestroyPropertyBlob(card->fd, card->pending_gamma_luts[this->crtc]);
+	card->pending_gamma_luts[this->crtc] = blob;
+
+	return card->deferring ? 0 : libgamma_linux_drm_internal_commit_gamma_luts(card);
+}
@@ -25,10 +25,11 @@ libgamma_linux_drm_method_capabilities(struct libgamma_method_capabilities *rest
 	this->multiple_crtcs = 1;
 	/* Partitions are graphics cards in DRM */
 	this->partitions_are_graphics_cards = 1;
-	/* Linux does not have system restore capabilities */
-	this->site_restore = 0;
-	this->partition_restore = 0;
-	this->crtc_restore = 0;
+	/* Linux does not have system restore capabilities, but
+	 * the gamma ramps are saved before they are first changed */
+	this->site_restore = 1;
+	this->partition_restore = 1;
+	this->crtc_restore = 1;
 	/* Gamma ramp sizes are identical but not fixed */
 	this->identical_gamma_sizes = 1;
 	this->fixed_gamma_size = 0;
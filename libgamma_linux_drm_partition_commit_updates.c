@@ -0,0 +1,21 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Apply all gamma ramp updates that have been deferred with
+ * `libgamma_linux_drm_partition_defer_updates`, in one atomic
+ * commit, and stop deferring gamma ramp updates
+ * 
+ * @param   this  The partition state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_linux_drm_partition_commit_updates(struct libgamma_partition_state *restrict this)
+{
+	struct libgamma_drm_card_data *restrict card = this->data;
+	card->deferring = 0;
+	return libgamma_linux_drm_internal_commit_gamma_luts(card);
+}
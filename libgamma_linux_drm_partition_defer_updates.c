@@ -0,0 +1,23 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Start deferring gamma ramp updates for the CRTC:s in a
+ * partition, so that they are applied together, in one
+ * atomic commit, by `libgamma_linux_drm_partition_commit_updates`
+ * 
+ * @param   this  The partition state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_linux_drm_partition_defer_updates(struct libgamma_partition_state *restrict this)
+{
+	struct libgamma_drm_card_data *restrict card = this->data;
+	/* CRTC:s without the "GAMMA_LUT" property are still updated
+	 * immediately, with the legacy gamma ioctls */
+	card->deferring = 1;
+	return 0;
+}
@@ -12,7 +12,29 @@ void
 libgamma_linux_drm_partition_destroy(struct libgamma_partition_state *restrict this)
 {
 	struct libgamma_drm_card_data *restrict data = this->data;
+	struct libgamma_drm_site_data *restrict site = this->site->data;
+	struct libgamma_drm_card_data *card;
+	size_t i;
+	/* Remove the graphics card from the site */
+	if (site->cards == data) {
+		site->cards = data->next;
+	} else {
+		for (card = site->cards; card->next != data; card = card->next);
+		card->next = data->next;
+	}
 	libgamma_linux_drm_internal_release_connectors_and_encoders(data);
+	libgamma_linux_drm_internal_discard_gamma_luts(data);
+	/* Release the saved gamma ramps, the CRTC:s are not restored */
+	for (i = 0; i < this->crtcs_available; i++) {
+		if (data->saved_gammas[i].lut)
+			drmModeDestroyPropertyBlob(data->fd, data->saved_gammas[i].lut);
+		free(data->saved_gammas[i].ramps);
+	}
+	free(data->gamma_lut_props);
+	free(data->gamma_lut_sizes);
+	free(data->pending_gamma_luts);
+	free(data->saved_gammas);
+	free(data->lut_buffer);
 	if (data->res)
 		drmModeFreeResources(data->res);
 	if (data->fd >= 0)
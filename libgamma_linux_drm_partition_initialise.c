@@ -100,8 +100,7 @@ libgamma_linux_drm_partition_initialise(struct libgamma_partition_state *restric
 	int rc = 0;
 	struct libgamma_drm_card_data *restrict data;
 	char pathname[PATH_MAX];
-
-	(void) site;
+	size_t n;
 
 	/* Check for partition index overflow */
 	if (partition > INT_MAX)
@@ -116,6 +115,20 @@ libgamma_linux_drm_partition_initialise(struct libgamma_partition_state *restric
 	data->res = NULL;
 	data->encoders = NULL;
 	data->connectors = NULL;
+	data->crtc_to_connector = NULL;
+	data->connectors_scanned = 0;
+	data->atomic = 0;
+#define X(NAME, FIELD)\
+	data->FIELD = 0;
+	LIST_DRM_PROPERTIES(X)
+#undef X
+	data->gamma_lut_props = NULL;
+	data->gamma_lut_sizes = NULL;
+	data->pending_gamma_luts = NULL;
+	data->deferring = 0;
+	data->saved_gammas = NULL;
+	data->lut_buffer = NULL;
+	data->lut_buffer_size = 0;
   
 	/* Get the pathname for the graphics card */
 	snprintf(pathname, sizeof(pathname), DRM_DEV_NAME, DRM_DIR_NAME, (int)partition);
@@ -140,9 +153,34 @@ libgamma_linux_drm_partition_initialise(struct libgamma_partition_state *restric
 		goto fail_res;
 	}
 	this->crtcs_available = (size_t)data->res->count_crtcs;
+
+	/* Use the "GAMMA_LUT" property with atomic modesetting where supported
+	 * (at least one element is allocated, as `calloc` may return `NULL` for 0) */
+	n = this->crtcs_available ? this->crtcs_available : 1;
+	data->gamma_lut_props    = calloc(n, sizeof(*data->gamma_lut_props));
+	data->gamma_lut_sizes    = calloc(n, sizeof(*data->gamma_lut_sizes));
+	data->pending_gamma_luts = calloc(n, sizeof(*data->pending_gamma_luts));
+	/* The gamma ramps of each CRTC are saved before they are first changed */
+	data->saved_gammas       = calloc(n, sizeof(*data->saved_gammas));
+	if (!data->gamma_lut_props || !data->gamma_lut_sizes || !data->pending_gamma_luts || !data->saved_gammas) {
+		rc = LIBGAMMA_ERRNO_SET;
+		goto fail_luts;
+	}
+	libgamma_linux_drm_internal_probe_atomic(data);
+
+	/* Add the graphics card to the site, so that it is restored with the site */
+	data->partition = this;
+	data->next = ((struct libgamma_drm_site_data *)site->data)->cards;
+	((struct libgamma_drm_site_data *)site->data)->cards = data;
+
 	this->data = data;
 	return 0;
 
+fail_luts:
+	free(data->gamma_lut_props);
+	free(data->gamma_lut_sizes);
+	free(data->pending_gamma_luts);
+	free(data->saved_gammas);
 fail_res:
 	drmModeFreeResources(data->res);
 fail_fd:
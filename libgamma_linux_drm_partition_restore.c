@@ -6,6 +6,9 @@
 /**
  * Restore the gamma ramps all CRTC:s with a partition to the system settings.
  * 
+ * For DRM, these are the gamma ramps the CRTC:s had before they
+ * were first changed using the partition state
+ * 
  * @param   this  The partition state.
  * @return        Zero on success, otherwise (negative) the value of an
  *                error identifier provided by this library.
@@ -13,7 +16,5 @@
 int
 libgamma_linux_drm_partition_restore(struct libgamma_partition_state *restrict this)
 {
-	(void) this;
-	errno = ENOTSUP;
-	return LIBGAMMA_ERRNO_SET;
+	return libgamma_linux_drm_internal_restore_gammas(this->data, 0, this->crtcs_available);
 }
@@ -11,5 +11,8 @@
 void
 libgamma_linux_drm_site_destroy(struct libgamma_site_state *restrict this)
 {
-	(void) this;
+	struct libgamma_drm_site_data *restrict data = this->data;
+	if (data->event_fd >= 0)
+		close(data->event_fd);
+	free(data);
 }
@@ -0,0 +1,42 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Get a file descriptor that becomes readable when the configuration
+ * of a site changes
+ * 
+ * @param   this  The site state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_linux_drm_site_get_event_fd(struct libgamma_site_state *restrict this, int *restrict fdp)
+{
+	struct libgamma_drm_site_data *restrict data = this->data;
+	struct sockaddr_nl addr;
+	int fd, saved_errno;
+
+	/* Hotplugs are announced by the kernel as uevents, subscribe
+	 * to them the first time the file descriptor is requested */
+	if (data->event_fd < 0) {
+		fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+		if (fd < 0)
+			return LIBGAMMA_ERRNO_SET;
+		memset(&addr, 0, sizeof(addr));
+		addr.nl_family = AF_NETLINK;
+		addr.nl_groups = 1; /* The kernel's uevent multicast group */
+		if (bind(fd, (struct sockaddr *)&addr, sizeof(addr))) {
+			saved_errno = errno;
+			close(fd);
+			errno = saved_errno;
+			return LIBGAMMA_ERRNO_SET;
+		}
+		data->event_fd = fd;
+	}
+
+	*fdp = data->event_fd;
+	return 0;
+}
@@ -19,12 +19,20 @@
 int
 libgamma_linux_drm_site_initialise(struct libgamma_site_state *restrict this, char *restrict site)
 {
+	struct libgamma_drm_site_data *restrict data;
 	char pathname[PATH_MAX];
 	struct stat _attr;
   
 	if (site)
 		return LIBGAMMA_NO_SUCH_SITE;
 
+	/* No graphics card has been opened yet, and no uevents are received yet */
+	this->data = data = malloc(sizeof(*data));
+	if (!data)
+		return LIBGAMMA_ERRNO_SET;
+	data->cards = NULL;
+	data->event_fd = -1;
+
 	/* Count the number of available graphics cards by
 	   `stat`:ing their existence in an API filesystem */
 	this->partitions_available = 0;
@@ -35,8 +43,10 @@ libgamma_linux_drm_site_initialise(struct libgamma_site_state *restrict this, ch
 		if (stat(pathname, &_attr))
 			break;
 		/* Move on to next graphics card */
-		if (this->partitions_available++ > INT_MAX)
+		if (this->partitions_available++ > INT_MAX) {
+			free(data);
 			return LIBGAMMA_IMPOSSIBLE_AMOUNT;
+		}
 	}
 	return 0;
 }
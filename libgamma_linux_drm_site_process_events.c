@@ -0,0 +1,134 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_LINUX_DRM
+#include "common.h"
+
+
+/**
+ * Refresh the graphics card data for a partition, or for all
+ * partitions that have been initialised
+ * 
+ * @param   this     The site data
+ * @param   card_no  The index of the graphics card, -1 for all
+ * @param   rcp      Output parameter for the error, only set on
+ *                   error and only if no error has been stored yet
+ * @param   errnop   Output parameter for the value of `errno` for
+ *                   the error, set when `*rcp` is set
+ * @return           1 if any graphics card was refreshed, 0 otherwise
+ */
+static int
+refresh(struct libgamma_drm_site_data *restrict this, long int card_no, int *restrict rcp, int *restrict errnop)
+{
+	struct libgamma_drm_card_data *card;
+	int r, ret = 0;
+	for (card = this->cards; card; card = card->next) {
+		if (card_no >= 0 && card->partition->partition != (size_t)card_no)
+			continue;
+		r = libgamma_linux_drm_internal_refresh_card(card);
+		if (r < 0) {
+			if (!*rcp) {
+				*rcp = r;
+				*errnop = errno;
+			}
+		} else {
+			ret = 1;
+		}
+	}
+	return ret;
+}
+
+
+/**
+ * Process all pending configuration change events for a
+ * site, without blocking, and refresh the cached data for
+ * the partitions whose configuration has changed
+ * 
+ * @param   this  The site state
+ * @return        1 if the configuration of at least one partition has
+ *                changed, 0 otherwise, or (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_linux_drm_site_process_events(struct libgamma_site_state *restrict this)
+{
+	struct libgamma_drm_site_data *restrict data = this->data;
+	char buf[8 << 10];
+	struct sockaddr_nl addr;
+	struct iovec iov;
+	struct msghdr msg;
+	ssize_t r;
+	size_t off, len;
+	long int card_no;
+	int is_drm, is_add, changed = 0, rc = 0, saved_errno = 0;
+	const char *field;
+
+	/* No events are received until the file descriptor is requested */
+	if (data->event_fd < 0)
+		return 0;
+
+	for (;;) {
+		/* Receive a uevent, without blocking */
+		iov.iov_base = buf;
+		iov.iov_len = sizeof(buf) - 1;
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_name = &addr;
+		msg.msg_namelen = sizeof(addr);
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		r = recvmsg(data->event_fd, &msg, 0);
+		if (r < 0) {
+			if (errno == EINTR)
+				continue;
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				break;
+			if (errno == ENOBUFS) {
+				/* Events have been lost, so any graphics card may have changed */
+				changed |= refresh(data, -1, &rc, &saved_errno);
+				continue;
+			}
+			return LIBGAMMA_ERRNO_SET;
+		}
+		/* Only trust messages from the kernel */
+		if (addr.nl_pid)
+			continue;
+		buf[r] = '\0';
+
+		/* The message is a sequence of NUL-terminated fields, the
+		 * first being "ACTION@DEVPATH" and the rest "KEY=VALUE" */
+		is_drm = is_add = 0;
+		card_no = -1;
+		for (off = 0; off < (size_t)r; off += len + 1) {
+			field = &buf[off];
+			len = strlen(field);
+			if (!strcmp(field, "SUBSYSTEM=drm")) {
+				is_drm = 1;
+			} else if (!strcmp(field, "ACTION=add")) {
+				is_add = 1;
+			} else if (!strncmp(field, "DEVNAME=dri/card", sizeof("DEVNAME=dri/card") - 1)) {
+				field += sizeof("DEVNAME=dri/card") - 1;
+				if (isdigit(*field)) {
+					errno = 0;
+					card_no = strtol(field, NULL, 10);
+					if (errno || card_no > INT_MAX)
+						card_no = -1;
+				}
+			}
+		}
+		if (!is_drm || card_no < 0)
+			continue;
+
+		/* Make a new graphics card available as a partition */
+		if (is_add && (size_t)card_no >= this->partitions_available) {
+			this->partitions_available = (size_t)card_no + 1;
+			changed = 1;
+		}
+
+		changed |= refresh(data, card_no, &rc, &saved_errno);
+	}
+
+	/* Report the first error, after all events have been processed */
+	if (rc) {
+		errno = saved_errno;
+		return rc;
+	}
+	return changed;
+}
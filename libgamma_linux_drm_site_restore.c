@@ -6,6 +6,9 @@
 /**
  * Restore the gamma ramps all CRTC:s with a site to the system settings
  * 
+ * For DRM, these are the gamma ramps the CRTC:s had before they
+ * were first changed, on each graphics card that is opened
+ * 
  * @param   this  The site state
  * @return        Zero on success, otherwise (negative) the value of an
  *                error identifier provided by this library
@@ -13,7 +16,21 @@
 int
 libgamma_linux_drm_site_restore(struct libgamma_site_state *restrict this)
 {
-	(void) this;
-	errno = ENOTSUP;
-	return LIBGAMMA_ERRNO_SET;
+	struct libgamma_drm_site_data *restrict data = this->data;
+	struct libgamma_drm_card_data *card;
+	int r, ret = 0, saved_errno = 0;
+
+	/* Restore all graphics cards, even if one fails */
+	for (card = data->cards; card; card = card->next) {
+		r = libgamma_linux_drm_internal_restore_gammas(card, 0, (size_t)card->res->count_crtcs);
+		card->partition->generation += 1;
+		if (r && !ret) {
+			ret = r;
+			saved_errno = errno;
+		}
+	}
+
+	if (ret)
+		errno = saved_errno;
+	return ret;
 }
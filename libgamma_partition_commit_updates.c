@@ -0,0 +1,31 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Apply all gamma ramp updates that have been held back since
+ * `libgamma_partition_defer_updates` was called, and stop deferring
+ * gamma ramp updates
+ * 
+ * @param   this  The partition state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_partition_commit_updates(struct libgamma_partition_state *restrict this)
+{
+	switch (this->site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+	case LIBGAMMA_METHOD_LINUX_DRM: {
+		int r = libgamma_linux_drm_partition_commit_updates(this);
+		/* The held back gamma ramps were recorded as applied */
+		if (r)
+			this->generation += 1;
+		return r;
+	}
+#endif
+	default:
+		/* Other adjustment methods apply gamma ramps immediately */
+		return 0;
+	}
+}
@@ -0,0 +1,35 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Start deferring gamma ramp updates for the CRTC:s in a partition,
+ * so that they can be applied together with `libgamma_partition_commit_updates`
+ * 
+ * Adjustment methods that can apply gamma ramps to multiple
+ * CRTC:s atomically (Linux DRM with atomic modesetting, which
+ * applies them in one commit per graphics card, so that all
+ * CRTC:s are updated on the same frame) will hold back the
+ * gamma ramps set with `libgamma_crtc_set_gamma_ramps16` and
+ * its siblings until `libgamma_partition_commit_updates` is
+ * called; other adjustment methods apply them immediately,
+ * as usual. Reading the gamma ramps of a CRTC does not return
+ * gamma ramps that have been held back
+ * 
+ * @param   this  The partition state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_partition_defer_updates(struct libgamma_partition_state *restrict this)
+{
+	switch (this->site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+	case LIBGAMMA_METHOD_LINUX_DRM:
+		return libgamma_linux_drm_partition_defer_updates(this);
+#endif
+	default:
+		/* Other adjustment methods apply gamma ramps immediately */
+		return 0;
+	}
+}
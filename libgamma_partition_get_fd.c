@@ -0,0 +1,36 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the file descriptor of the connection to the display
+ * server or graphics card that a partition uses
+ * 
+ * @param   this  The partition state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_partition_get_fd(struct libgamma_partition_state *restrict this, int *restrict fdp)
+{
+	*fdp = -1;
+
+	switch (this->site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	case LIBGAMMA_METHOD_X_RANDR:
+		return libgamma_x_randr_partition_get_fd(this, fdp);
+#endif
+#ifdef HAVE_LIBGAMMA_METHOD_X_VIDMODE
+	case LIBGAMMA_METHOD_X_VIDMODE:
+		return libgamma_x_vidmode_partition_get_fd(this, fdp);
+#endif
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+	case LIBGAMMA_METHOD_LINUX_DRM:
+		return libgamma_linux_drm_partition_get_fd(this, fdp);
+#endif
+	default:
+		errno = ENOTSUP;
+		return LIBGAMMA_ERRNO_SET;
+	}
+}
@@ -15,16 +15,24 @@ int
 libgamma_partition_initialise(struct libgamma_partition_state *restrict this,
                               struct libgamma_site_state *restrict site, size_t partition)
 {
+	unsigned long long int start;
+	int r;
+
 	this->site = site;
 	this->partition = partition;
+	this->generation = 0;
 
+	start = libgamma_internal_stats_start();
 	switch (site->method) {
 #define X(CONST, CNAME, ...)\
 	case CONST:\
-		return libgamma_##CNAME##_partition_initialise(this, site, partition);
+		r = libgamma_##CNAME##_partition_initialise(this, site, partition);\
+		break;
 	LIST_AVAILABLE_METHODS(X)
 #undef X
 	default:
 		return LIBGAMMA_NO_SUCH_ADJUSTMENT_METHOD;
 	}
+	libgamma_internal_stats_record(site->method, LIBGAMMA_STATS_INITIALISE, start, r);
+	return r;
 }
@@ -12,6 +12,9 @@
 int
 libgamma_partition_restore(struct libgamma_partition_state *restrict this)
 {
+	/* Forget which gamma ramps were last applied to the CRTC:s */
+	this->generation += 1;
+
 	switch (this->site->method) {
 #define X(CONST, CNAME, ...)\
 	case CONST:\
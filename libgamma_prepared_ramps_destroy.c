@@ -0,0 +1,14 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Release resources that are held by prepared gamma ramps
+ * 
+ * @param  this  The prepared gamma ramps
+ */
+void
+libgamma_prepared_ramps_destroy(struct libgamma_prepared_ramps *restrict this)
+{
+	free(this->red);
+}
@@ -0,0 +1,11 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Release resources that are held by prepared gamma ramps,
+ * as well as release the pointer to the structure
+ * 
+ * @param  this  The prepared gamma ramps
+ */
+extern inline void libgamma_prepared_ramps_free(struct libgamma_prepared_ramps *restrict);
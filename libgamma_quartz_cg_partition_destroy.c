@@ -11,5 +11,7 @@
 void
 libgamma_quartz_cg_partition_destroy(struct libgamma_partition_state *restrict this)
 {
+	if (this->site->data == this)
+		this->site->data = NULL;
 	free(this->data);
 }
@@ -19,8 +19,6 @@ libgamma_quartz_cg_partition_initialise(struct libgamma_partition_state *restric
 	CGDirectDisplayID *crtcs, *crtcs_old;
 	uint32_t cap = 4, n;
 
-	(void) site;
-
 	this->data = NULL;
 
 	if (partition)
@@ -64,5 +62,6 @@ libgamma_quartz_cg_partition_initialise(struct libgamma_partition_state *restric
 	/* Store CRTC ID:s and CRTC count */
 	this->data = crtcs;
 	this->crtcs_available = (size_t)n;
+	site->data = this;
 	return 0;
 }
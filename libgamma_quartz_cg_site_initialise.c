@@ -19,6 +19,9 @@
 int
 libgamma_quartz_cg_site_initialise(struct libgamma_site_state *restrict this, char *restrict site)
 {
+	/* The site's only partition state, once initialised, so
+	 * that it can be told when the site has been restored */
+	this->data = NULL;
 	this->partitions_available = 1;
 	return site ? 0 : LIBGAMMA_NO_SUCH_SITE;
 }
@@ -13,7 +13,12 @@
 int
 libgamma_quartz_cg_site_restore(struct libgamma_site_state *restrict this)
 {
-	(void) this;
+	struct libgamma_partition_state *restrict partition = this->data;
+
 	CGDisplayRestoreColorSyncSettings();
+
+	/* Forget which gamma ramps were last applied to the CRTC:s */
+	if (partition)
+		partition->generation += 1;
 	return 0;
 }
@@ -20,5 +20,7 @@ libgamma_site_destroy(struct libgamma_site_state *restrict this)
 	default:
 		break;
 	}
+	if (this->request_fd >= 0)
+		close(this->request_fd);
 	free(this->site);
 }
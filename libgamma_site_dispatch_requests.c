@@ -0,0 +1,70 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Call the callback functions for all requests, submitted with
+ * `libgamma_crtc_get_gamma_ramps16_async` or
+ * `libgamma_crtc_set_gamma_ramps16_async` for CRTC:s in a site,
+ * that have completed, without blocking
+ * 
+ * @param   this  The site state
+ * @return        The number of callback functions called
+ */
+size_t
+libgamma_site_dispatch_requests(struct libgamma_site_state *restrict this)
+{
+	struct libgamma_crtc_request *request, *next, *kept, **kept_tail, *kept_last;
+	size_t n = 0, completed;
+	int r, saved_errno = errno;
+#ifdef __linux__
+	eventfd_t value;
+
+	/* Reset the eventfd, all requests are checked below */
+	if (this->request_fd >= 0)
+		eventfd_read(this->request_fd, &value);
+#endif
+
+	/* Take the queue, so that callback functions can submit new requests */
+	request = this->requests;
+	this->requests = NULL;
+	this->requests_last = NULL;
+
+	/* Completing a request can read the replies of other requests
+	 * off the connection to the display server, so a request that
+	 * was checked earlier in the pass may have completed without
+	 * the file descriptor becoming readable again; therefore the
+	 * requests that are kept are checked again as long as any
+	 * request completes */
+	do {
+		completed = 0;
+		kept = NULL;
+		kept_tail = &kept;
+		kept_last = NULL;
+		for (; request; request = next) {
+			next = request->next;
+			request->next = NULL;
+			r = libgamma_crtc_complete_request(request);
+			if (r == LIBGAMMA_ERRNO_SET && errno == EAGAIN) {
+				/* Not completed yet, keep it in the queue */
+				*kept_tail = request;
+				kept_tail = &request->next;
+				kept_last = request;
+				continue;
+			}
+			request->callback(request, r, request->user);
+			completed += 1;
+		}
+		n += completed;
+		request = kept;
+	} while (completed && kept);
+
+	/* Put back the requests that have not completed, before the new ones */
+	*kept_tail = this->requests;
+	this->requests = kept;
+	if (!this->requests_last)
+		this->requests_last = kept_last;
+
+	errno = saved_errno;
+	return n;
+}
@@ -0,0 +1,36 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get a file descriptor that becomes readable when the configuration
+ * of a site changes, for example because a monitor has been plugged
+ * in or unplugged; when it is readable, `libgamma_site_process_events`
+ * shall be called
+ * 
+ * @param   this  The site state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library; `errno` is
+ *                set to `ENOTSUP` if the adjustment method does not
+ *                support configuration change notifications
+ */
+int
+libgamma_site_get_event_fd(struct libgamma_site_state *restrict this, int *restrict fdp)
+{
+	*fdp = -1;
+
+	switch (this->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	case LIBGAMMA_METHOD_X_RANDR:
+		return libgamma_x_randr_site_get_event_fd(this, fdp);
+#endif
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+	case LIBGAMMA_METHOD_LINUX_DRM:
+		return libgamma_linux_drm_site_get_event_fd(this, fdp);
+#endif
+	default:
+		errno = ENOTSUP;
+		return LIBGAMMA_ERRNO_SET;
+	}
+}
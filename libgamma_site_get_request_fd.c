@@ -0,0 +1,55 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get a file descriptor that becomes readable when requests
+ * submitted with `libgamma_crtc_get_gamma_ramps16_async` or
+ * `libgamma_crtc_set_gamma_ramps16_async` for CRTC:s in
+ * a site may have completed
+ * 
+ * @param   this  The site state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_site_get_request_fd(struct libgamma_site_state *restrict this, int *restrict fdp)
+{
+#ifdef __linux__
+	struct libgamma_crtc_request *request;
+#endif
+
+	*fdp = -1;
+
+	switch (this->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	case LIBGAMMA_METHOD_X_RANDR:
+		/* All requests wait for replies from the display server */
+		return libgamma_x_randr_site_get_request_fd(this, fdp);
+#endif
+	default:
+		break;
+	}
+
+#ifdef __linux__
+	/* Other adjustment methods complete the requests when they are
+	 * submitted, so an eventfd is used to wake up the event loop */
+	if (this->request_fd < 0) {
+		this->request_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (this->request_fd < 0)
+			return LIBGAMMA_ERRNO_SET;
+		/* Requests that were queued before the eventfd existed were not signalled */
+		for (request = this->requests; request; request = request->next)
+			if (!request->pending)
+				break;
+		if (request)
+			eventfd_write(this->request_fd, 1);
+	}
+	*fdp = this->request_fd;
+	return 0;
+#else
+	errno = ENOTSUP;
+	return LIBGAMMA_ERRNO_SET;
+#endif
+}
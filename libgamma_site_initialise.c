@@ -19,16 +19,26 @@
 int
 libgamma_site_initialise(struct libgamma_site_state *restrict this, int method, char *restrict site)
 {
+	unsigned long long int start;
+	int r;
+
 	this->method = method;
 	this->site = site;
+	this->requests = NULL;
+	this->requests_last = NULL;
+	this->request_fd = -1;
 
+	start = libgamma_internal_stats_start();
 	switch (method) {
 #define X(CONST, CNAME, ...)\
 	case CONST:\
-		return libgamma_##CNAME##_site_initialise(this, site);
+		r = libgamma_##CNAME##_site_initialise(this, site);\
+		break;
 	LIST_AVAILABLE_METHODS(X)
 #undef X
 	default:
 		return LIBGAMMA_NO_SUCH_ADJUSTMENT_METHOD;
 	}
+	libgamma_internal_stats_record(method, LIBGAMMA_STATS_INITIALISE, start, r);
+	return r;
 }
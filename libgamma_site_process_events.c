@@ -0,0 +1,32 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Process all pending configuration change events for a
+ * site, without blocking, and refresh the cached data for
+ * the partitions whose configuration has changed
+ * 
+ * @param   this  The site state, `libgamma_site_get_event_fd`
+ *                must have been called on it
+ * @return        1 if the configuration of at least one partition has
+ *                changed, 0 otherwise, or (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_site_process_events(struct libgamma_site_state *restrict this)
+{
+	switch (this->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	case LIBGAMMA_METHOD_X_RANDR:
+		return libgamma_x_randr_site_process_events(this);
+#endif
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+	case LIBGAMMA_METHOD_LINUX_DRM:
+		return libgamma_linux_drm_site_process_events(this);
+#endif
+	default:
+		errno = ENOTSUP;
+		return LIBGAMMA_ERRNO_SET;
+	}
+}
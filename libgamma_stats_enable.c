@@ -0,0 +1,16 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Start or stop collecting runtime statistics
+ * 
+ * @param   enable  Non-zero to collect statistics, zero to stop
+ * @return          Non-zero if statistics were collected
+ *                  before the function was called
+ */
+int
+libgamma_stats_enable(int enable)
+{
+	return atomic_exchange_explicit(&libgamma_internal_stats.enabled, !!enable, memory_order_relaxed);
+}
@@ -0,0 +1,52 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the runtime statistics that have been collected,
+ * since the library was loaded or `libgamma_stats_reset`
+ * was last called, summed over all threads
+ * 
+ * @param  this  Output parameter for the statistics
+ * @param  size  Should be `sizeof(*this)`, used to let the
+ *               library know which version of the structure
+ *               is used (its size may grow in the future)
+ */
+void
+libgamma_stats_get(struct libgamma_stats *restrict this, size_t size)
+{
+	struct libgamma_stats stats;
+	struct libgamma_internal_stats_shard *shard;
+	size_t i, m, o, b;
+
+#define LOAD(COUNTER)\
+	atomic_load_explicit(&COUNTER, memory_order_relaxed)
+
+	memset(&stats, 0, sizeof(stats));
+	for (i = 0; i < LIBGAMMA_INTERNAL_STATS_SHARDS; i++) {
+		shard = &libgamma_internal_stats.shards[i];
+		for (m = 0; m < LIBGAMMA_METHOD_COUNT; m++) {
+			for (o = 0; o < LIBGAMMA_STATS_OPERATION_COUNT; o++) {
+				stats.methods[m].operations[o].calls      += LOAD(shard->methods[m].operations[o].calls);
+				stats.methods[m].operations[o].errors     += LOAD(shard->methods[m].operations[o].errors);
+				stats.methods[m].operations[o].total_time += LOAD(shard->methods[m].operations[o].total_time);
+				for (b = 0; b < LIBGAMMA_STATS_LATENCY_BUCKETS; b++)
+					stats.methods[m].operations[o].latency_histogram[b]
+						+= LOAD(shard->methods[m].operations[o].latency_histogram[b]);
+			}
+			stats.methods[m].translated_bytes += LOAD(shard->methods[m].counters[LIBGAMMA_INTERNAL_STATS_TRANSLATED_BYTES]);
+			stats.methods[m].allocations      += LOAD(shard->methods[m].counters[LIBGAMMA_INTERNAL_STATS_ALLOCATIONS]);
+			stats.methods[m].ignored_errors   += LOAD(shard->methods[m].counters[LIBGAMMA_INTERNAL_STATS_IGNORED_ERRORS]);
+		}
+	}
+
+#undef LOAD
+
+	/* Newer versions of the structure are zero-filled at the end */
+	if (size <= sizeof(stats)) {
+		memcpy(this, &stats, size);
+	} else {
+		memcpy(this, &stats, sizeof(stats));
+		memset(&((char *)this)[sizeof(stats)], 0, size - sizeof(stats));
+	}
+}
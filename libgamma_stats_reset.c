@@ -0,0 +1,33 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Set all runtime statistics to zero
+ */
+void
+libgamma_stats_reset(void)
+{
+	struct libgamma_internal_stats_shard *shard;
+	size_t i, m, o, b, c;
+
+#define CLEAR(COUNTER)\
+	atomic_store_explicit(&COUNTER, 0, memory_order_relaxed)
+
+	for (i = 0; i < LIBGAMMA_INTERNAL_STATS_SHARDS; i++) {
+		shard = &libgamma_internal_stats.shards[i];
+		for (m = 0; m < LIBGAMMA_METHOD_COUNT; m++) {
+			for (o = 0; o < LIBGAMMA_STATS_OPERATION_COUNT; o++) {
+				CLEAR(shard->methods[m].operations[o].calls);
+				CLEAR(shard->methods[m].operations[o].errors);
+				CLEAR(shard->methods[m].operations[o].total_time);
+				for (b = 0; b < LIBGAMMA_STATS_LATENCY_BUCKETS; b++)
+					CLEAR(shard->methods[m].operations[o].latency_histogram[b]);
+			}
+			for (c = 0; c < LIBGAMMA_INTERNAL_STATS_COUNTER_COUNT; c++)
+				CLEAR(shard->methods[m].counters[c]);
+		}
+	}
+
+#undef CLEAR
+}
@@ -0,0 +1,16 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Remove all staged gamma ramps from a transaction,
+ * but keep its memory so that it can be reused
+ * 
+ * @param  this  The transaction
+ */
+void
+libgamma_transaction_clear(struct libgamma_transaction *restrict this)
+{
+	this->count = 0;
+	this->arena_used = 0;
+}
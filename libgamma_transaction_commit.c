@@ -0,0 +1,94 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Check whether an entry is the first entry in a
+ * transaction for a CRTC in its partition
+ * 
+ * @param   this  The transaction
+ * @param   i     The index of the entry
+ * @return        1 if the entry is the first for its partition, 0 otherwise
+ */
+static int
+first_in_partition(const struct libgamma_transaction *restrict this, size_t i)
+{
+	size_t j;
+	for (j = 0; j < i; j++)
+		if (this->entries[j].crtc->partition == this->entries[i].crtc->partition)
+			return 0;
+	return 1;
+}
+
+
+/**
+ * Apply all gamma ramps staged in a transaction
+ * 
+ * @param   this  The transaction
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_transaction_commit(struct libgamma_transaction *restrict this)
+{
+	struct libgamma_transaction_entry *entry;
+	struct libgamma_gamma_ramps16 ramps;
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	unsigned long long int start;
+#endif
+	int r, rc = 0, saved_errno = 0;
+	size_t i;
+
+	switch (this->site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	case LIBGAMMA_METHOD_X_RANDR:
+		/* This bypasses the deduplication and read cache in `libgamma_crtc_set_gamma_ramps16` */
+		for (i = 0; i < this->count; i++) {
+			this->entries[i].crtc->applied_depth = 0;
+			this->entries[i].crtc->read_cache_depth = 0;
+		}
+		/* The transaction is recorded as one write */
+		start = libgamma_internal_stats_start();
+		r = libgamma_x_randr_transaction_commit(this);
+		libgamma_internal_stats_record(LIBGAMMA_METHOD_X_RANDR, LIBGAMMA_STATS_SET_GAMMA, start, r);
+		return r;
+#endif
+	default:
+		break;
+	}
+
+#define CHECK(CALL)\
+	do {\
+		r = (CALL);\
+		if (r && !rc) {\
+			rc = r;\
+			saved_errno = errno;\
+		}\
+	} while (0)
+
+	/* Hold back the gamma ramps, so that they are applied in one commit per
+	 * partition, where the adjustment method supports it (Linux DRM) */
+	for (i = 0; i < this->count; i++)
+		if (first_in_partition(this, i))
+			CHECK(libgamma_partition_defer_updates(this->entries[i].crtc->partition));
+
+	for (i = 0; i < this->count; i++) {
+		entry = &this->entries[i];
+		ramps.red_size   = entry->red_size;
+		ramps.green_size = entry->green_size;
+		ramps.blue_size  = entry->blue_size;
+		ramps.red   = &this->arena[entry->offset];
+		ramps.green = &ramps.  red[ramps.red_size];
+		ramps.blue  = &ramps.green[ramps.green_size];
+		CHECK(libgamma_crtc_set_gamma_ramps16(entry->crtc, &ramps));
+	}
+
+	for (i = 0; i < this->count; i++)
+		if (first_in_partition(this, i))
+			CHECK(libgamma_partition_commit_updates(this->entries[i].crtc->partition));
+
+#undef CHECK
+
+	errno = saved_errno;
+	return rc;
+}
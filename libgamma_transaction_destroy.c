@@ -0,0 +1,19 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Release resources that are held by a transaction
+ * 
+ * @param  this  The transaction
+ */
+void
+libgamma_transaction_destroy(struct libgamma_transaction *restrict this)
+{
+	free(this->entries);
+	free(this->arena);
+	this->entries = NULL;
+	this->arena = NULL;
+	this->count = this->entries_size = 0;
+	this->arena_used = this->arena_size = 0;
+}
@@ -0,0 +1,21 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Initialise a transaction
+ * 
+ * @param  this  The transaction to initialise
+ * @param  site  The site the CRTC:s in the transaction will belong to
+ */
+void
+libgamma_transaction_initialise(struct libgamma_transaction *restrict this, struct libgamma_site_state *restrict site)
+{
+	this->site = site;
+	this->count = 0;
+	this->entries = NULL;
+	this->entries_size = 0;
+	this->arena = NULL;
+	this->arena_used = 0;
+	this->arena_size = 0;
+}
@@ -0,0 +1,94 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Stage gamma ramps for a CRTC in a transaction, 16-bit gamma-depth version
+ * 
+ * @param   this   The transaction
+ * @param   crtc   The CRTC state, the CRTC must belong to the transaction's site
+ * @param   ramps  The gamma ramps to apply
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+int
+libgamma_transaction_set_gamma_ramps16(struct libgamma_transaction *restrict this, struct libgamma_crtc_state *restrict crtc,
+                                       const struct libgamma_gamma_ramps16 *restrict ramps)
+{
+	struct libgamma_transaction_entry *entry, *new_entries;
+	uint16_t *new_arena, *stops;
+	size_t i, n, new_size;
+
+	/* Get the total number of stops */
+	if (ramps->red_size > SIZE_MAX - ramps->green_size ||
+	    ramps->red_size + ramps->green_size > SIZE_MAX - ramps->blue_size) {
+		errno = ENOMEM;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	n = ramps->red_size + ramps->green_size + ramps->blue_size;
+
+	/* Find the CRTC's entry if it already has one */
+	for (i = 0; i < this->count; i++)
+		if (this->entries[i].crtc == crtc)
+			break;
+	entry = i < this->count ? &this->entries[i] : NULL;
+
+	/* Reuse the entry's stops if they fit, otherwise the entry
+	 * is moved to the end and the old stops are left unused
+	 * until the transaction is cleared */
+	if (entry && entry->red_size + entry->green_size + entry->blue_size != n) {
+		memmove(entry, &entry[1], (this->count - i - 1) * sizeof(*entry));
+		this->count -= 1;
+		entry = NULL;
+	}
+
+	if (!entry) {
+		/* Grow the arena, by doubling so that staging is amortised constant time */
+		if (n > this->arena_size - this->arena_used) {
+			new_size = this->arena_size ? this->arena_size : 256;
+			while (n > new_size - this->arena_used) {
+				if (new_size > SIZE_MAX / 2 / sizeof(*new_arena)) {
+					errno = ENOMEM;
+					return LIBGAMMA_ERRNO_SET;
+				}
+				new_size *= 2;
+			}
+			new_arena = realloc(this->arena, new_size * sizeof(*new_arena));
+			if (!new_arena)
+				return LIBGAMMA_ERRNO_SET;
+			this->arena = new_arena;
+			this->arena_size = new_size;
+		}
+
+		/* Grow the entry list */
+		if (this->count == this->entries_size) {
+			if (this->entries_size > SIZE_MAX / 2 / sizeof(*new_entries)) {
+				errno = ENOMEM;
+				return LIBGAMMA_ERRNO_SET;
+			}
+			new_size = this->entries_size ? 2 * this->entries_size : 4;
+			new_entries = realloc(this->entries, new_size * sizeof(*new_entries));
+			if (!new_entries)
+				return LIBGAMMA_ERRNO_SET;
+			this->entries = new_entries;
+			this->entries_size = new_size;
+		}
+
+		entry = &this->entries[this->count++];
+		entry->crtc = crtc;
+		entry->offset = this->arena_used;
+		this->arena_used += n;
+	}
+
+	/* Copy the gamma ramps into the arena */
+	entry->red_size   = ramps->red_size;
+	entry->green_size = ramps->green_size;
+	entry->blue_size  = ramps->blue_size;
+	stops = &this->arena[entry->offset];
+	memcpy(stops, ramps->red, ramps->red_size * sizeof(*stops));
+	stops += ramps->red_size;
+	memcpy(stops, ramps->green, ramps->green_size * sizeof(*stops));
+	stops += ramps->green_size;
+	memcpy(stops, ramps->blue, ramps->blue_size * sizeof(*stops));
+	return 0;
+}
@@ -0,0 +1,21 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Release resources that are held by a transition
+ * 
+ * The gamma ramps are left as they were last applied
+ * 
+ * @param  this  The transition
+ */
+void
+libgamma_transition_destroy(struct libgamma_transition *restrict this)
+{
+	libgamma_prepared_ramps_destroy(&this->frame);
+	this->frame.red = NULL;
+	if (this->timer_fd >= 0) {
+		close(this->timer_fd);
+		this->timer_fd = -1;
+	}
+}
@@ -0,0 +1,49 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get a file descriptor that becomes readable when the
+ * next frame of a transition is due
+ * 
+ * The file descriptor is owned by the transition and
+ * is closed by `libgamma_transition_destroy`; it is only
+ * available on Linux
+ * 
+ * @param   this  The transition
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_transition_get_fd(struct libgamma_transition *restrict this, int *restrict fdp)
+{
+#ifdef __linux__
+	struct itimerspec spec;
+
+	if (this->timer_fd < 0) {
+		this->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		if (this->timer_fd < 0) {
+			*fdp = -1;
+			return LIBGAMMA_ERRNO_SET;
+		}
+		/* Make it readable immediately, `libgamma_transition_step`
+		 * will rearm it for the frame after the one that is due */
+		memset(&spec, 0, sizeof(spec));
+		spec.it_value.tv_nsec = 1;
+		if (timerfd_settime(this->timer_fd, 0, &spec, NULL)) {
+			close(this->timer_fd);
+			this->timer_fd = -1;
+			*fdp = -1;
+			return LIBGAMMA_ERRNO_SET;
+		}
+	}
+	*fdp = this->timer_fd;
+	return 0;
+#else
+	(void) this;
+	*fdp = -1;
+	errno = ENOTSUP;
+	return LIBGAMMA_ERRNO_SET;
+#endif
+}
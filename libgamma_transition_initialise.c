@@ -0,0 +1,102 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Get the number of milliseconds between the frames of a transition
+ * 
+ * @param   crtc  The CRTC whose gamma ramps shall be changed
+ * @return        The refresh period of the CRTC, if the adjustment
+ *                method can report it, otherwise 16
+ */
+static unsigned long int
+frame_interval(struct libgamma_crtc_state *restrict crtc)
+{
+	unsigned long int period = 16;
+	int saved_errno = errno;
+
+	switch (crtc->partition->site->method) {
+#ifdef HAVE_LIBGAMMA_METHOD_LINUX_DRM
+	case LIBGAMMA_METHOD_LINUX_DRM:
+		if (libgamma_linux_drm_crtc_get_refresh_period(crtc, &period))
+			period = 16;
+		break;
+#endif
+#ifdef HAVE_LIBGAMMA_METHOD_X_RANDR
+	case LIBGAMMA_METHOD_X_RANDR:
+		if (libgamma_x_randr_crtc_get_refresh_period(crtc, &period))
+			period = 16;
+		break;
+#endif
+	default:
+		break;
+	}
+
+	/* Failing to get the refresh period is not an error */
+	errno = saved_errno;
+	return period;
+}
+
+
+/**
+ * Initialise a transition, and begin it
+ * 
+ * No gamma ramps are applied until `libgamma_transition_step`
+ * is called, which should be done immediately
+ * 
+ * @param   this      The transition to initialise
+ * @param   crtc      The CRTC whose gamma ramps shall be changed
+ * @param   from      The gamma ramps at the beginning of the transition
+ * @param   to        The gamma ramps at the end of the transition, must have
+ *                    the same depth and sizes as `from`
+ * @param   duration  The duration of the transition, in milliseconds
+ * @return            Zero on success, otherwise (negative) the value of an
+ *                    error identifier provided by this library
+ */
+int
+libgamma_transition_initialise(struct libgamma_transition *restrict this, struct libgamma_crtc_state *restrict crtc,
+                               const struct libgamma_prepared_ramps *from, const struct libgamma_prepared_ramps *to,
+                               unsigned long int duration)
+{
+	size_t n, stops;
+	char *buffer;
+
+	this->frame.red = NULL;
+	this->timer_fd = -1;
+
+	if (from->depth != to->depth ||
+	    from->red_size != to->red_size ||
+	    from->green_size != to->green_size ||
+	    from->blue_size != to->blue_size) {
+		errno = EINVAL;
+		return LIBGAMMA_ERRNO_SET;
+	}
+
+	this->start_time = libgamma_internal_monotonic_time();
+	if (!this->start_time) {
+		errno = ENOTSUP;
+		return LIBGAMMA_ERRNO_SET;
+	}
+
+	/* The sizes are already known to fit in memory, as `from` exists */
+	n = libgamma_internal_stop_size(from->depth);
+	stops = from->red_size + from->green_size + from->blue_size;
+	buffer = malloc(stops * n);
+	if (!buffer)
+		return LIBGAMMA_ERRNO_SET;
+
+	this->frame.depth      = from->depth;
+	this->frame.red_size   = from->red_size;
+	this->frame.green_size = from->green_size;
+	this->frame.blue_size  = from->blue_size;
+	this->frame.red        = buffer;
+	this->frame.green      = &buffer[from->red_size * n];
+	this->frame.blue       = &buffer[(from->red_size + from->green_size) * n];
+
+	this->crtc = crtc;
+	this->from = from;
+	this->to = to;
+	this->duration = duration;
+	this->frame_interval = frame_interval(crtc);
+	return 0;
+}
@@ -0,0 +1,171 @@
+/* See LICENSE file for copyright and license details. */
+#include "common.h"
+
+
+/**
+ * Interpolate between two integer gamma ramps
+ * 
+ * @param  TYPE  The element type of the gamma ramps
+ * @param  OUT   The output gamma ramp
+ * @param  A     The gamma ramp at the beginning of the transition
+ * @param  B     The gamma ramp at the end of the transition
+ * @param  N     The number of stops in the gamma ramps
+ * @param  P     The progress of the transition, in [0, 2³²)
+ */
+#define INTERPOLATE_INTEGER(TYPE, OUT, A, B, N, P)\
+	do {\
+		TYPE *restrict out__ = (OUT);\
+		const TYPE *restrict a__ = (A);\
+		const TYPE *restrict b__ = (B);\
+		size_t i__;\
+		for (i__ = 0; i__ < (N); i__++) {\
+			if (b__[i__] >= a__[i__])\
+				out__[i__] = (TYPE)(a__[i__] + scale((uint64_t)(b__[i__] - a__[i__]), P));\
+			else\
+				out__[i__] = (TYPE)(a__[i__] - scale((uint64_t)(a__[i__] - b__[i__]), P));\
+		}\
+	} while (0)
+
+/**
+ * Interpolate between two floating point gamma ramps
+ * 
+ * @param  TYPE  The element type of the gamma ramps
+ * @param  OUT   The output gamma ramp
+ * @param  A     The gamma ramp at the beginning of the transition
+ * @param  B     The gamma ramp at the end of the transition
+ * @param  N     The number of stops in the gamma ramps
+ * @param  P     The progress of the transition, in [0, 2³²)
+ */
+#define INTERPOLATE_FLOAT(TYPE, OUT, A, B, N, P)\
+	do {\
+		TYPE *restrict out__ = (OUT);\
+		const TYPE *restrict a__ = (A);\
+		const TYPE *restrict b__ = (B);\
+		double p__ = (double)(P) / 4294967296.;\
+		size_t i__;\
+		for (i__ = 0; i__ < (N); i__++)\
+			out__[i__] = (TYPE)(a__[i__] + (b__[i__] - a__[i__]) * p__);\
+	} while (0)
+
+
+/**
+ * Multiply an integer by a fraction
+ * 
+ * @param   x  The integer
+ * @param   p  The numerator of the fraction, the denominator is 2³²;
+ *             must be less than 2³²
+ * @return     `x` multiplied by `p / 2³²`, rounded down
+ */
+static uint64_t
+scale(uint64_t x, uint64_t p)
+{
+	return (x >> 32) * p + (((x & UINT64_C(0xFFFFFFFF)) * p) >> 32);
+}
+
+
+/**
+ * Interpolate between two gamma ramps
+ * 
+ * @param  depth  The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @param  out    Output parameter for the interpolated gamma ramp
+ * @param  a      The gamma ramp at the beginning of the transition
+ * @param  b      The gamma ramp at the end of the transition
+ * @param  n      The number of stops in the gamma ramps
+ * @param  p      The progress of the transition, in [0, 2³²)
+ */
+static void
+interpolate(signed depth, void *out, const void *a, const void *b, size_t n, uint64_t p)
+{
+	switch (depth) {
+	case  8:  INTERPOLATE_INTEGER(uint8_t,  out, a, b, n, p); break;
+	case 16:  INTERPOLATE_INTEGER(uint16_t, out, a, b, n, p); break;
+	case 32:  INTERPOLATE_INTEGER(uint32_t, out, a, b, n, p); break;
+	case 64:  INTERPOLATE_INTEGER(uint64_t, out, a, b, n, p); break;
+	case -1:  INTERPOLATE_FLOAT(float,      out, a, b, n, p); break;
+	default:  INTERPOLATE_FLOAT(double,     out, a, b, n, p); break;
+	}
+}
+
+
+/**
+ * Apply the frame of a transition that is due
+ * 
+ * Frames are interpolated from the time that has passed since
+ * the transition began, so frames that are due while this
+ * function is not called are skipped rather than delayed
+ * 
+ * @param   this   The transition
+ * @param   delay  Output parameter for the number of milliseconds to
+ *                 wait before calling this function again
+ * @return         1 if the transition has not finished, 0 if the final gamma
+ *                 ramps were applied, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+int
+libgamma_transition_step(struct libgamma_transition *restrict this, unsigned long int *restrict delay)
+{
+	unsigned long long int now, elapsed;
+	uint64_t p;
+	int r;
+#ifdef __linux__
+	struct itimerspec spec;
+	uint64_t expirations;
+#endif
+
+	*delay = 0;
+
+#ifdef __linux__
+	if (this->timer_fd >= 0)
+		if (read(this->timer_fd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN)
+			return LIBGAMMA_ERRNO_SET;
+#endif
+
+	now = libgamma_internal_monotonic_time();
+	if (!now) {
+		errno = ENOTSUP;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	elapsed = now - this->start_time;
+
+	if (elapsed >= this->duration) {
+		r = libgamma_crtc_apply_prepared(this->crtc, this->to);
+#ifdef __linux__
+		/* Do not let the timer wake the caller again when the transition is over */
+		if (!r && this->timer_fd >= 0) {
+			memset(&spec, 0, sizeof(spec));
+			if (timerfd_settime(this->timer_fd, 0, &spec, NULL))
+				return LIBGAMMA_ERRNO_SET;
+		}
+#endif
+		return r;
+	}
+
+	/* `elapsed / duration` is less than 1, but the quotient is
+	 * rounded down so that rounding cannot make it reach 2³² */
+	p = (uint64_t)((double)elapsed / (double)this->duration * 4294967296.);
+	if (p > UINT64_C(0xFFFFFFFF))
+		p = UINT64_C(0xFFFFFFFF);
+	interpolate(this->frame.depth, this->frame.red,   this->from->red,   this->to->red,   this->frame.red_size,   p);
+	interpolate(this->frame.depth, this->frame.green, this->from->green, this->to->green, this->frame.green_size, p);
+	interpolate(this->frame.depth, this->frame.blue,  this->from->blue,  this->to->blue,  this->frame.blue_size,  p);
+	r = libgamma_crtc_apply_prepared(this->crtc, &this->frame);
+	if (r)
+		return r;
+
+	*delay = this->frame_interval;
+	if (*delay > this->duration - elapsed)
+		*delay = (unsigned long int)(this->duration - elapsed);
+	if (!*delay)
+		*delay = 1;
+
+#ifdef __linux__
+	if (this->timer_fd >= 0) {
+		memset(&spec, 0, sizeof(spec));
+		spec.it_value.tv_sec = (time_t)(*delay / 1000UL);
+		spec.it_value.tv_nsec = (long int)(*delay % 1000UL) * 1000000L;
+		if (timerfd_settime(this->timer_fd, 0, &spec, NULL))
+			return LIBGAMMA_ERRNO_SET;
+	}
+#endif
+	return 1;
+}
@@ -0,0 +1,65 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Complete a submitted request, without blocking
+ * 
+ * @param   request  The request
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library; `errno`
+ *                   is set to `EAGAIN` if the reply has not arrived yet
+ */
+int
+libgamma_x_randr_complete_request(struct libgamma_crtc_request *restrict request)
+{
+	xcb_connection_t *restrict connection = ((struct libgamma_x_randr_site_data *)request->crtc->partition->site->data)->connection;
+	struct libgamma_gamma_ramps16 *restrict ramps = request->ramps;
+	xcb_randr_get_crtc_gamma_reply_t *restrict reply;
+	xcb_generic_error_t *error = NULL;
+	void *reply_;
+	int rc;
+
+	/* Check whether the reply has arrived, reading from the connection if possible,
+	 * for set requests, it is the reply to the request that follows it that we wait for */
+	if (!xcb_poll_for_reply(connection, (unsigned int)request->data[ramps ? 0 : 1], &reply_, &error)) {
+		if (xcb_connection_has_error(connection)) {
+			request->pending = 0;
+			return LIBGAMMA_NOT_CONNECTED;
+		}
+		errno = EAGAIN;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	request->pending = 0;
+
+	if (!ramps) {
+		/* The reply to the following request is of no interest */
+		free(reply_);
+		free(error);
+		/* The set request has been processed, so this does not block */
+		error = NULL;
+		xcb_poll_for_reply(connection, (unsigned int)request->data[0], &reply_, &error);
+		if (error) {
+			rc = libgamma_x_randr_internal_translate_error(error->error_code, LIBGAMMA_GAMMA_RAMP_WRITE_FAILED, 0);
+			free(error);
+			return rc;
+		}
+		return 0;
+	}
+
+	/* Check for errors */
+	if (error) {
+		rc = libgamma_x_randr_internal_translate_error(error->error_code, LIBGAMMA_GAMMA_RAMP_READ_FAILED, 0);
+		free(error);
+		return rc;
+	}
+
+	/* Copy over the gamma ramps to our memory */
+	reply = reply_;
+	memcpy(ramps->red,   xcb_randr_get_crtc_gamma_red(reply),   ramps->red_size   * sizeof(*ramps->red));
+	memcpy(ramps->green, xcb_randr_get_crtc_gamma_green(reply), ramps->green_size * sizeof(*ramps->green));
+	memcpy(ramps->blue,  xcb_randr_get_crtc_gamma_blue(reply),  ramps->blue_size  * sizeof(*ramps->blue));
+	free(reply);
+	return 0;
+}
@@ -14,7 +14,7 @@
 int
 libgamma_x_randr_crtc_get_gamma_ramps16(struct libgamma_crtc_state *restrict this, struct libgamma_gamma_ramps16 *restrict ramps)
 {
-	xcb_connection_t *restrict connection = this->partition->site->data;
+	xcb_connection_t *restrict connection = ((struct libgamma_x_randr_site_data *)this->partition->site->data)->connection;
 	xcb_randr_get_crtc_gamma_cookie_t cookie;
 	xcb_randr_get_crtc_gamma_reply_t *restrict reply;
 	xcb_generic_error_t *error;
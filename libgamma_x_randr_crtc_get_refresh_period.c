@@ -0,0 +1,77 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Get the refresh period of the mode a CRTC is configured with
+ * 
+ * @param   this    The CRTC state
+ * @param   period  Output parameter for the refresh period, in
+ *                  milliseconds rounded to the nearest, at least 1
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library
+ */
+int
+libgamma_x_randr_crtc_get_refresh_period(struct libgamma_crtc_state *restrict this, unsigned long int *restrict period)
+{
+	xcb_connection_t *restrict connection = ((struct libgamma_x_randr_site_data *)this->partition->site->data)->connection;
+	struct libgamma_x_randr_partition_data *restrict screen_data = this->partition->data;
+	xcb_randr_get_crtc_info_cookie_t crtc_cookie;
+	xcb_randr_get_crtc_info_reply_t *restrict crtc_reply;
+	xcb_randr_get_screen_resources_current_cookie_t res_cookie;
+	xcb_randr_get_screen_resources_current_reply_t *restrict res_reply;
+	xcb_randr_mode_info_t *restrict modes;
+	xcb_generic_error_t *error;
+	unsigned long long int frame;
+	xcb_randr_mode_t mode;
+	int i, n, rc;
+
+	/* The CRTC only tells which mode it uses, the timings of
+	 * the mode are listed in the resources of the screen, so
+	 * request both at once to only wait for one round trip */
+	crtc_cookie = xcb_randr_get_crtc_info(connection, *(xcb_randr_crtc_t *)this->data, screen_data->config_timestamp);
+	res_cookie = xcb_randr_get_screen_resources_current(connection, screen_data->root);
+
+	crtc_reply = xcb_randr_get_crtc_info_reply(connection, crtc_cookie, &error);
+	if (error) {
+		rc = libgamma_x_randr_internal_translate_error(error->error_code, LIBGAMMA_ACQUIRING_MODE_RESOURCES_FAILED, 0);
+		free(error);
+		xcb_discard_reply(connection, res_cookie.sequence);
+		return rc;
+	}
+	mode = crtc_reply->mode;
+	free(crtc_reply);
+
+	res_reply = xcb_randr_get_screen_resources_current_reply(connection, res_cookie, &error);
+	if (error) {
+		rc = libgamma_x_randr_internal_translate_error(error->error_code, LIBGAMMA_ACQUIRING_MODE_RESOURCES_FAILED, 0);
+		free(error);
+		return rc;
+	}
+
+	/* Without a mode, the CRTC is not displaying anything */
+	rc = LIBGAMMA_CONNECTOR_DISABLED;
+	modes = xcb_randr_get_screen_resources_current_modes(res_reply);
+	n = xcb_randr_get_screen_resources_current_modes_length(res_reply);
+	for (i = 0; mode != XCB_NONE && i < n; i++) {
+		if (modes[i].id != mode)
+			continue;
+		/* A double scanned mode draws each line twice, and an
+		 * interlaced mode draws half of the lines per field */
+		frame = (unsigned long long int)modes[i].htotal * (unsigned long long int)modes[i].vtotal;
+		if (modes[i].mode_flags & XCB_RANDR_MODE_FLAG_DOUBLE_SCAN)
+			frame *= 2;
+		if (modes[i].mode_flags & XCB_RANDR_MODE_FLAG_INTERLACE)
+			frame /= 2;
+		if (!frame || !modes[i].dot_clock)
+			break;
+		*period = (unsigned long int)((frame * 1000ULL + modes[i].dot_clock / 2) / modes[i].dot_clock);
+		if (!*period)
+			*period = 1;
+		rc = 0;
+		break;
+	}
+	free(res_reply);
+	return rc;
+}
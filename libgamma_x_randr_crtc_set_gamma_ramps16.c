@@ -14,7 +14,7 @@
 int
 libgamma_x_randr_crtc_set_gamma_ramps16(struct libgamma_crtc_state *restrict this, const struct libgamma_gamma_ramps16 *ramps)
 {
-	xcb_connection_t *restrict connection = this->partition->site->data;
+	xcb_connection_t *restrict connection = ((struct libgamma_x_randr_site_data *)this->partition->site->data)->connection;
 	xcb_void_cookie_t cookie;
 	xcb_generic_error_t *restrict error;
 #ifdef DEBUG
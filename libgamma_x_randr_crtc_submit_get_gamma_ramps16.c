@@ -0,0 +1,37 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Submit a request to get the current gamma ramps for a CRTC,
+ * 16-bit gamma-depth version, without waiting for a reply
+ * 
+ * @param   request  The request, with `crtc` and `ramps` set
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library
+ */
+int
+libgamma_x_randr_crtc_submit_get_gamma_ramps16(struct libgamma_crtc_request *restrict request)
+{
+	struct libgamma_crtc_state *restrict this = request->crtc;
+	xcb_connection_t *restrict connection = ((struct libgamma_x_randr_site_data *)this->partition->site->data)->connection;
+	xcb_randr_get_crtc_gamma_cookie_t cookie;
+
+#ifdef DEBUG
+	/* Gamma ramp sizes are identical but not fixed */
+	if (request->ramps->red_size != request->ramps->green_size || request->ramps->red_size != request->ramps->blue_size)
+		return LIBGAMMA_MIXED_GAMMA_RAMP_SIZE;
+#endif
+
+	/* Send the request, but do not wait for the reply */
+	cookie = xcb_randr_get_crtc_gamma(connection, *(xcb_randr_crtc_t *)this->data);
+	if (xcb_flush(connection) <= 0) {
+		xcb_discard_reply(connection, cookie.sequence);
+		return LIBGAMMA_NOT_CONNECTED;
+	}
+
+	request->data[0] = cookie.sequence;
+	request->pending = 1;
+	return 0;
+}
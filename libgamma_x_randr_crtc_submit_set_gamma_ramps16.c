@@ -0,0 +1,48 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Submit a request to set the gamma ramps for a CRTC,
+ * 16-bit gamma-depth version, without waiting for
+ * the display server to acknowledge it
+ * 
+ * @param   request  The request, with `crtc` set
+ * @param   ramps    The gamma ramps to apply
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library
+ */
+int
+libgamma_x_randr_crtc_submit_set_gamma_ramps16(struct libgamma_crtc_request *restrict request,
+                                               const struct libgamma_gamma_ramps16 *restrict ramps)
+{
+	struct libgamma_crtc_state *restrict this = request->crtc;
+	xcb_connection_t *restrict connection = ((struct libgamma_x_randr_site_data *)this->partition->site->data)->connection;
+	xcb_void_cookie_t cookie;
+	xcb_randr_get_crtc_gamma_size_cookie_t sync_cookie;
+
+#ifdef DEBUG
+	/* Gamma ramp sizes are identical but not fixed */
+	if (ramps->red_size != ramps->green_size || ramps->red_size != ramps->blue_size)
+		return LIBGAMMA_MIXED_GAMMA_RAMP_SIZE;
+#endif
+
+	/* Apply gamma ramps, xcb copies the ramps into its output buffer */
+	cookie = xcb_randr_set_crtc_gamma_checked(connection, *(xcb_randr_crtc_t *)this->data,
+	                                          (uint16_t)ramps->red_size, ramps->red, ramps->green, ramps->blue);
+	/* The request has no reply, so follow it with a cheap request that
+	 * has one; once that reply has arrived, any error for the first
+	 * request has arrived as well, and can be checked without blocking */
+	sync_cookie = xcb_randr_get_crtc_gamma_size(connection, *(xcb_randr_crtc_t *)this->data);
+	if (xcb_flush(connection) <= 0) {
+		xcb_discard_reply(connection, cookie.sequence);
+		xcb_discard_reply(connection, sync_cookie.sequence);
+		return LIBGAMMA_NOT_CONNECTED;
+	}
+
+	request->data[0] = cookie.sequence;
+	request->data[1] = sync_cookie.sequence;
+	request->pending = 1;
+	return 0;
+}
@@ -0,0 +1,19 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Abandon a submitted request that has not been completed
+ * 
+ * @param  request  The request
+ */
+void
+libgamma_x_randr_discard_request(struct libgamma_crtc_request *restrict request)
+{
+	xcb_connection_t *restrict connection = ((struct libgamma_x_randr_site_data *)request->crtc->partition->site->data)->connection;
+	xcb_discard_reply(connection, (unsigned int)request->data[0]);
+	if (!request->ramps)
+		xcb_discard_reply(connection, (unsigned int)request->data[1]);
+	request->pending = 0;
+}
@@ -6,26 +6,26 @@
 /**
  * Get the gamma ramp size of a CRTC
  * 
- * @param   this  Instance of a data structure to fill with the information about the CRTC
- * @param   crtc  The state of the CRTC whose information should be read
- * @return        Non-zero on error
+ * @param   this    Instance of a data structure to fill with the information about the CRTC
+ * @param   crtc    The state of the CRTC whose information should be read
+ * @param   cookie  The cookie for the already sent gamma ramp size query
+ * @return          Non-zero on error
  */
 static int
-get_gamma_ramp_size(struct libgamma_crtc_information *restrict out, struct libgamma_crtc_state *restrict crtc)
+get_gamma_ramp_size(struct libgamma_crtc_information *restrict out, struct libgamma_crtc_state *restrict crtc,
+                    xcb_randr_get_crtc_gamma_size_cookie_t cookie)
 {
-	xcb_connection_t *restrict connection = crtc->partition->site->data;
-	xcb_randr_crtc_t *restrict crtc_id = crtc->data;
-	xcb_randr_get_crtc_gamma_size_cookie_t cookie;
+	xcb_connection_t *restrict connection = ((struct libgamma_x_randr_site_data *)crtc->partition->site->data)->connection;
 	xcb_randr_get_crtc_gamma_size_reply_t *restrict reply;
 	xcb_generic_error_t *error;
 
-	/* Query gamma ramp size */
+	/* Collect gamma ramp size */
 	out->gamma_size_error = 0;
-	cookie = xcb_randr_get_crtc_gamma_size(connection, *crtc_id);
 	reply = xcb_randr_get_crtc_gamma_size_reply(connection, cookie, &error);
 	if (error) {
 		out->gamma_size_error = libgamma_x_randr_internal_translate_error(error->error_code,
 		                                                                  LIBGAMMA_GAMMA_RAMPS_SIZE_QUERY_FAILED, 1);
+		free(error);
 		return out->gamma_size_error;
 	}
 	/* Sanity check gamma ramp size */
@@ -179,110 +179,53 @@ get_output_name(struct libgamma_crtc_information *restrict out, xcb_randr_get_ou
  * 
  * @param   out     Instance of a data structure to fill with the information about the CRTC
  * @param   crtc    The state of the CRTC whose information should be read
- * @param   output  The CRTC's output
+ * @param   cookie  The cookie for the already sent query for the output's "EDID" property
  * @return          Non-zero on error
  */
 static int
-get_edid(struct libgamma_crtc_information *restrict out, struct libgamma_crtc_state *restrict crtc, xcb_randr_output_t output)
+get_edid(struct libgamma_crtc_information *restrict out, struct libgamma_crtc_state *restrict crtc,
+         xcb_randr_get_output_property_cookie_t cookie)
 {
-	xcb_connection_t *restrict connection = crtc->partition->site->data;
-	xcb_randr_list_output_properties_cookie_t prop_cookie;
-	xcb_randr_list_output_properties_reply_t *restrict prop_reply;
-	xcb_atom_t *atoms;
-	xcb_atom_t *atoms_end;
+	xcb_connection_t *restrict connection = ((struct libgamma_x_randr_site_data *)crtc->partition->site->data)->connection;
 	xcb_generic_error_t *error;
-	xcb_get_atom_name_cookie_t atom_name_cookie;
-	xcb_get_atom_name_reply_t *restrict atom_name_reply;
-	char *restrict atom_name;
-	int atom_name_len;
-	xcb_randr_get_output_property_cookie_t atom_cookie;
-	xcb_randr_get_output_property_reply_t *restrict atom_reply;
-	unsigned char *restrict atom_data;
+	xcb_randr_get_output_property_reply_t *restrict reply;
+	unsigned char *restrict data;
 	int length;
 
-	/* Acquire a list of all properties of the output */
-	prop_cookie = xcb_randr_list_output_properties(connection, output);
-	prop_reply = xcb_randr_list_output_properties_reply(connection, prop_cookie, &error);
+	/* Collect the property's value */
+	reply = xcb_randr_get_output_property_reply(connection, cookie, &error);
 	if (error) {
-		return out->edid_error = libgamma_x_randr_internal_translate_error(error->error_code,
-		                                                                   LIBGAMMA_LIST_PROPERTIES_FAILED, 1);
-	}
-  
-	/* Extract the properties form the data structure that holds them, */
-	atoms = xcb_randr_list_output_properties_atoms(prop_reply);
-	/* and get the last one so that we can iterate over them nicely */
-	atoms_end = atoms + xcb_randr_list_output_properties_atoms_length(prop_reply);
-
-	if (!atoms) {
-		free(prop_reply);
-		return out->edid_error = LIBGAMMA_REPLY_VALUE_EXTRACTION_FAILED;
+		free(error);
+		return out->edid_error = LIBGAMMA_PROPERTY_VALUE_QUERY_FAILED;
 	}
 
-	/* For each property */
-	for (; atoms != atoms_end; atoms++) {
-		/* Acquire the atom name */
-		atom_name_cookie = xcb_get_atom_name(connection, *atoms);
-		atom_name_reply = xcb_get_atom_name_reply(connection, atom_name_cookie, &error);
-		if (error)
-			continue;
-
-		/* Extract the atom name from the data structure that holds it */
-		atom_name = xcb_get_atom_name_name(atom_name_reply);
-		/* As well as the length of the name; it is not NUL-termianted */
-		atom_name_len = xcb_get_atom_name_name_length(atom_name_reply);
-
-		if (/* Check for errors */
-		    !atom_name || /* atom_name_len < 1 || */
-		    /* Check that the length is the expected length for the EDID property */
-		    atom_name_len != 4 ||
-		    /* Check that the property is the EDID property */
-		    atom_name[0] != 'E' || atom_name[1] != 'D' || atom_name[2] != 'I' || atom_name[3] != 'D') {
-			free(atom_name_reply);
-			continue;
-		}
-
-		/* Acquire the property's value, we know that it is either 128 or 256 byte long */
-		atom_cookie = xcb_randr_get_output_property(connection, output, *atoms, XCB_GET_PROPERTY_TYPE_ANY, 0, 256, 0, 0);
-		atom_reply = xcb_randr_get_output_property_reply(connection, atom_cookie, &error);
-		/* (*) EDID version 1.0 through 1.4 define it as 128 bytes long,
-		 * but version 2.0 define it as 256 bytes long. However,
-		 * version 2.0 is rare(?) and has been deprecated and replaced
-		 * by version 1.3 (I guess that is with a new version epoch,
-		 * but I do not know.) */
-		if (error) {
-			free(atom_name_reply);
-			free(prop_reply);
-			return out->edid_error = LIBGAMMA_PROPERTY_VALUE_QUERY_FAILED;
-		}
-
-		/* Extract the property's value */
-		atom_data = xcb_randr_get_output_property_data(atom_reply);
-		/* and its actual length */
-		length = xcb_randr_get_output_property_data_length(atom_reply);
-		if (!atom_data || length < 1) {
-			free(atom_reply);
-			free(atom_name_reply);
-			free(prop_reply);
-			return out->edid_error = LIBGAMMA_REPLY_VALUE_EXTRACTION_FAILED;
-		}
+	/* If the output does not have the property, the type is `XCB_ATOM_NONE` */
+	if (reply->type == XCB_ATOM_NONE) {
+		free(reply);
+		return out->edid_error = LIBGAMMA_EDID_NOT_FOUND;
+	}
 
-		/* Store the EDID */
-		out->edid_length = (size_t)length;
-		out->edid = malloc((size_t)length * sizeof(unsigned char));
-		if (!out->edid)
-			out->edid_error = errno;
-		else
-			memcpy(out->edid, atom_data, (size_t)length * sizeof(unsigned char));
+	/* Extract the property's value */
+	data = xcb_randr_get_output_property_data(reply);
+	/* and its actual length */
+	length = xcb_randr_get_output_property_data_length(reply);
+	if (!data || length < 1) {
+		free(reply);
+		return out->edid_error = LIBGAMMA_REPLY_VALUE_EXTRACTION_FAILED;
+	}
 
-		/* Release resouces */
-		free(atom_reply);
-		free(atom_name_reply);
-		free(prop_reply);
+	/* Store the EDID */
+	out->edid_length = (size_t)length;
+	out->edid = malloc((size_t)length * sizeof(unsigned char));
+	if (!out->edid)
+		out->edid_error = errno;
+	else
+		memcpy(out->edid, data, (size_t)length * sizeof(unsigned char));
 
-		return out->edid_error;
-	}
+	/* Release resouces */
+	free(reply);
 
-	return out->edid_error = LIBGAMMA_EDID_NOT_FOUND;
+	return out->edid_error;
 }
 
 
@@ -304,15 +247,24 @@ libgamma_x_randr_get_crtc_information(struct libgamma_crtc_information *restrict
 	xcb_randr_get_output_info_reply_t *restrict output_info = NULL;
 	xcb_randr_output_t output;
 	int free_edid, free_name;
-	xcb_connection_t *restrict connection;
+	struct libgamma_x_randr_site_data *restrict site_data = crtc->partition->site->data;
+	xcb_connection_t *restrict connection = site_data->connection;
 	struct libgamma_x_randr_partition_data *restrict screen_data;
 	size_t output_index;
 	xcb_randr_get_output_info_cookie_t cookie;
+	xcb_randr_get_crtc_gamma_size_cookie_t gamma_size_cookie = {0};
+	xcb_randr_get_output_property_cookie_t edid_cookie = {0};
+	int have_edid_cookie = 0;
 	xcb_generic_error_t *error;
 
 	/* Wipe all error indicators */
 	memset(this, 0, sizeof(*this));
 
+	/* Query the gamma ramp size right away, so that its reply
+	 * arrives while we are waiting for the output information */
+	if (fields & LIBGAMMA_CRTC_INFO_GAMMA_SIZE)
+		gamma_size_cookie = xcb_randr_get_crtc_gamma_size(connection, *(xcb_randr_crtc_t *)crtc->data);
+
 	/* We need to free the EDID after us if it is not explicitly requested */
 	free_edid = !(fields & LIBGAMMA_CRTC_INFO_EDID);
 
@@ -324,7 +276,6 @@ libgamma_x_randr_get_crtc_information(struct libgamma_crtc_information *restrict
 		goto cont;
 
 	/* Get connector and connector information */
-	connection = crtc->partition->site->data;
 	screen_data = crtc->partition->data;
 	output_index = screen_data->crtc_to_output[crtc->crtc];
 	/* `SIZE_MAX` is used for CRTC:s that misses mapping to its output (should not happen),
@@ -341,8 +292,21 @@ libgamma_x_randr_get_crtc_information(struct libgamma_crtc_information *restrict
 	output = screen_data->outputs[output_index];
 	/* Query output information */
 	cookie = xcb_randr_get_output_info(connection, output, screen_data->config_timestamp);
+	/* and the EDID, without waiting to see whether a monitor is connected;
+	 * we know that it is either 128 or 256 byte long (*), if the "EDID"
+	 * atom does not exist, no output has an EDID */
+	if ((fields & LIBGAMMA_CRTC_INFO_MACRO_EDID) && site_data->edid_atom != XCB_ATOM_NONE) {
+		edid_cookie = xcb_randr_get_output_property(connection, output, site_data->edid_atom, XCB_GET_PROPERTY_TYPE_ANY, 0, 256, 0, 0);
+		have_edid_cookie = 1;
+	}
+	/* (*) EDID version 1.0 through 1.4 define it as 128 bytes long,
+	 * but version 2.0 define it as 256 bytes long. However,
+	 * version 2.0 is rare(?) and has been deprecated and replaced
+	 * by version 1.3 (I guess that is with a new version epoch,
+	 * but I do not know.) */
 	output_info = xcb_randr_get_output_info_reply(connection, cookie, &error);
 	if (error) {
+		free(error);
 		e |= this->edid_error = this->gamma_error = this->width_mm_edid_error
 		   = this->height_mm_edid_error = this->connector_type_error
 		   = this->connector_name_error = this->subpixel_order_error
@@ -372,7 +336,12 @@ libgamma_x_randr_get_crtc_information(struct libgamma_crtc_information *restrict
 		goto cont;
 	}
 	/* Get EDID */
-	e |= get_edid(this, crtc, output);
+	if (have_edid_cookie) {
+		have_edid_cookie = 0;
+		e |= get_edid(this, crtc, edid_cookie);
+	} else {
+		e |= this->edid_error = LIBGAMMA_EDID_NOT_FOUND;
+	}
 	if (!this->edid) {
 		this->gamma_error = this->width_mm_edid_error = this->height_mm_edid_error = this->edid_error;
 		goto cont;
@@ -382,8 +351,11 @@ libgamma_x_randr_get_crtc_information(struct libgamma_crtc_information *restrict
 		e |= libgamma_internal_parse_edid(this, fields);
 
 cont:
+	/* Discard the EDID if we did not need it after all */
+	if (have_edid_cookie)
+		xcb_discard_reply(connection, edid_cookie.sequence);
 	/* Get gamma ramp size */
-	e |= (fields & LIBGAMMA_CRTC_INFO_GAMMA_SIZE) ? get_gamma_ramp_size(this, crtc) : 0;
+	e |= (fields & LIBGAMMA_CRTC_INFO_GAMMA_SIZE) ? get_gamma_ramp_size(this, crtc, gamma_size_cookie) : 0;
 	/* Store gamma ramp depth. */
 	this->gamma_depth = 16;
 	/* X RandR does not support quering gamma ramp support. */
@@ -0,0 +1,121 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Read the outputs of a screen and map the CRTC:s to them,
+ * replacing the outputs stored in the partition data
+ * 
+ * The output information is queried for all outputs before
+ * any reply is waited for, so only one round trip is made
+ * 
+ * @param   this        The partition data
+ * @param   connection  The connection to the display server
+ * @param   reply       The current resources of the screen
+ * @return              Zero on success, otherwise (negative) the value of an
+ *                      error identifier provided by this library; on failure
+ *                      the partition data is left unmodified
+ */
+int
+libgamma_x_randr_internal_read_outputs(struct libgamma_x_randr_partition_data *restrict this, xcb_connection_t *restrict connection,
+                                       xcb_randr_get_screen_resources_current_reply_t *restrict reply)
+{
+	int fail_rc = LIBGAMMA_ERRNO_SET;
+	xcb_generic_error_t *error = NULL;
+	xcb_randr_crtc_t *restrict crtcs;
+	xcb_randr_output_t *restrict outputs;
+	xcb_randr_output_t *restrict new_outputs = NULL;
+	size_t *restrict crtc_to_output = NULL;
+	xcb_randr_get_output_info_cookie_t *out_cookies = NULL;
+	xcb_randr_get_output_info_reply_t *out_reply;
+	size_t i, k;
+	uint16_t j;
+
+	/* Get the CRTC and output lists */
+	crtcs = xcb_randr_get_screen_resources_current_crtcs(reply);
+	outputs = xcb_randr_get_screen_resources_current_outputs(reply);
+	if (!crtcs || !outputs)
+		return LIBGAMMA_REPLY_VALUE_EXTRACTION_FAILED;
+
+	/* Copy the outputs, just so we do not have to keep the reply in memory */
+	if (reply->num_outputs) {
+		if (reply->num_outputs > SIZE_MAX / sizeof(*new_outputs)) {
+			errno = ENOMEM;
+			goto fail;
+		}
+		new_outputs = malloc((size_t)reply->num_outputs * sizeof(*new_outputs));
+		if (!new_outputs)
+			goto fail;
+		memcpy(new_outputs, outputs, (size_t)reply->num_outputs * sizeof(*new_outputs));
+	}
+
+	/* Create mapping table from CRTC indices to output indicies. (injection) */
+	if (reply->num_crtcs) {
+		if (reply->num_crtcs > SIZE_MAX / sizeof(*crtc_to_output)) {
+			errno = ENOMEM;
+			goto fail;
+		}
+		crtc_to_output = malloc((size_t)reply->num_crtcs * sizeof(*crtc_to_output));
+		if (!crtc_to_output)
+			goto fail;
+	}
+	/* All CRTC:s should be mapped, but incase they are not, all unmapped CRTC:s should have
+	 * an invalid target, namely `SIZE_MAX`, which is 1 more than the theoretical limit */
+	for (i = 0; i < (size_t)reply->num_crtcs; i++)
+		crtc_to_output[i] = SIZE_MAX;
+	/* Query output (target) information for all outputs before waiting
+	 * for any reply, so that we only have to wait for one round trip */
+	if (reply->num_outputs) {
+		if (reply->num_outputs > SIZE_MAX / sizeof(*out_cookies)) {
+			errno = ENOMEM;
+			goto fail;
+		}
+		out_cookies = malloc((size_t)reply->num_outputs * sizeof(*out_cookies));
+		if (!out_cookies)
+			goto fail;
+	}
+	for (i = 0; i < (size_t)reply->num_outputs; i++)
+		out_cookies[i] = xcb_randr_get_output_info(connection, outputs[i], reply->config_timestamp);
+	/* Fill the table */
+	for (i = 0; i < (size_t)reply->num_outputs; i++) {
+		out_reply = xcb_randr_get_output_info_reply(connection, out_cookies[i], &error);
+		if (error) {
+			fail_rc = libgamma_x_randr_internal_translate_error(error->error_code,
+			                                                    LIBGAMMA_OUTPUT_INFORMATION_QUERY_FAILED, 0);
+			free(error);
+			/* Discard the replies we will not collect */
+			for (k = i + 1; k < (size_t)reply->num_outputs; k++)
+				xcb_discard_reply(connection, out_cookies[k].sequence);
+			goto fail;
+		}
+
+		/* Find CRTC (source) */
+		for (j = 0; j < reply->num_crtcs; j++) {
+			if (crtcs[j] == out_reply->crtc) {
+				crtc_to_output[j] = i;
+				break;
+			}
+		}
+
+		/* Release output information */
+		free(out_reply);
+	}
+	free(out_cookies);
+
+	/* Replace the old outputs */
+	free(this->outputs);
+	free(this->crtc_to_output);
+	this->outputs = new_outputs;
+	this->outputs_count = (size_t)reply->num_outputs;
+	this->crtc_to_output = crtc_to_output;
+	/* Store the configuration timestamp */
+	this->config_timestamp = reply->config_timestamp;
+	return 0;
+
+fail:
+	free(new_outputs);
+	free(crtc_to_output);
+	free(out_cookies);
+	return fail_rc;
+}
@@ -0,0 +1,78 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Reload the resources of a screen, after its
+ * configuration has changed
+ * 
+ * @param   this        The partition data
+ * @param   connection  The connection to the display server
+ * @return              Zero on success, otherwise (negative) the value of an
+ *                      error identifier provided by this library; `errno`
+ *                      is set to `ESTALE` if the CRTC:s have changed, in
+ *                      which case the partition must be reinitialised
+ */
+int
+libgamma_x_randr_internal_refresh_partition(struct libgamma_x_randr_partition_data *restrict this, xcb_connection_t *restrict connection)
+{
+	struct libgamma_x_randr_site_data *restrict site_data = this->partition->site->data;
+	xcb_generic_error_t *error = NULL;
+	xcb_intern_atom_cookie_t atom_cookie;
+	xcb_intern_atom_reply_t *restrict atom_reply;
+	xcb_randr_get_screen_resources_current_cookie_t cookie;
+	xcb_randr_get_screen_resources_current_reply_t *restrict reply;
+	xcb_randr_crtc_t *restrict crtcs;
+	int rc, have_atom_cookie = 0;
+
+	/* The "EDID" atom did not exist when the site was opened if no
+	 * output had an EDID, but a monitor with one may have been
+	 * connected since, so look it up again with the resources */
+	if (site_data->edid_atom == XCB_ATOM_NONE) {
+		atom_cookie = xcb_intern_atom(connection, 1, (uint16_t)(sizeof("EDID") - 1), "EDID");
+		have_atom_cookie = 1;
+	}
+
+	/* Get the current resources of the screen */
+	cookie = xcb_randr_get_screen_resources_current(connection, this->root);
+	if (have_atom_cookie) {
+		/* If the atom cannot be looked up, EDID:s are not reported, as before */
+		atom_reply = xcb_intern_atom_reply(connection, atom_cookie, &error);
+		if (atom_reply)
+			site_data->edid_atom = atom_reply->atom;
+		free(atom_reply);
+		free(error);
+		error = NULL;
+	}
+	reply = xcb_randr_get_screen_resources_current_reply(connection, cookie, &error);
+	if (error) {
+		rc = libgamma_x_randr_internal_translate_error(error->error_code, LIBGAMMA_LIST_CRTCS_FAILED, 0);
+		free(error);
+		return rc;
+	}
+
+	/* The CRTC states point into the CRTC list, so
+	 * they cannot survive a change of the CRTC list */
+	crtcs = xcb_randr_get_screen_resources_current_crtcs(reply);
+	if (!crtcs) {
+		free(reply);
+		return LIBGAMMA_REPLY_VALUE_EXTRACTION_FAILED;
+	}
+	if ((size_t)reply->num_crtcs != this->partition->crtcs_available ||
+	    (reply->num_crtcs && memcmp(crtcs, this->crtcs, (size_t)reply->num_crtcs * sizeof(*crtcs)))) {
+		free(reply);
+		errno = ESTALE;
+		return LIBGAMMA_ERRNO_SET;
+	}
+
+	/* Get the outputs and map the CRTC:s to them */
+	rc = libgamma_x_randr_internal_read_outputs(this, connection, reply);
+	free(reply);
+	if (rc)
+		return rc;
+
+	/* Make the CRTC states discard their cached information */
+	this->partition->generation += 1;
+	return 0;
+}
@@ -12,6 +12,15 @@ void
 libgamma_x_randr_partition_destroy(struct libgamma_partition_state *restrict this)
 {
 	struct libgamma_x_randr_partition_data *restrict data = this->data;
+	struct libgamma_x_randr_site_data *restrict site = this->site->data;
+	struct libgamma_x_randr_partition_data *partition;
+	/* Remove the partition from the site */
+	if (site->partitions == data) {
+		site->partitions = data->next;
+	} else {
+		for (partition = site->partitions; partition->next != data; partition = partition->next);
+		partition->next = data->next;
+	}
 	free(data->crtcs);
 	free(data->outputs);
 	free(data->crtc_to_output);
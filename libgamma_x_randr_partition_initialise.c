@@ -45,7 +45,8 @@ libgamma_x_randr_partition_initialise(struct libgamma_partition_state *restrict
                                       struct libgamma_site_state *restrict site, size_t partition)
 {
 	int fail_rc = LIBGAMMA_ERRNO_SET;
-	xcb_connection_t *restrict connection = site->data;
+	struct libgamma_x_randr_site_data *restrict site_data = site->data;
+	xcb_connection_t *restrict connection = site_data->connection;
 	xcb_screen_t *restrict screen = NULL;
 	xcb_generic_error_t *error = NULL;
 	const xcb_setup_t *restrict setup;
@@ -55,10 +56,7 @@ libgamma_x_randr_partition_initialise(struct libgamma_partition_state *restrict
 	xcb_randr_crtc_t *restrict crtcs;
 	xcb_randr_output_t *restrict outputs;
 	struct libgamma_x_randr_partition_data *restrict data;
-	xcb_randr_get_output_info_cookie_t out_cookie;
-	xcb_randr_get_output_info_reply_t *out_reply;
 	size_t i;
-	uint16_t j;
 
 	/* Get screen list */
 	setup = xcb_get_setup(connection);
@@ -108,53 +106,18 @@ libgamma_x_randr_partition_initialise(struct libgamma_partition_state *restrict
 	if (!data->crtcs && reply->num_crtcs > 0)
 		goto fail;
 
-	/* Copy the outputs as well */
-	data->outputs = duparray(outputs, (size_t)reply->num_outputs, sizeof(*outputs));
-	if (!data->outputs && reply->num_outputs > 0)
+	/* Get the outputs and map the CRTC:s to them */
+	fail_rc = libgamma_x_randr_internal_read_outputs(data, connection, reply);
+	if (fail_rc)
 		goto fail;
 
-	/* Get the number of available outputs */
-	data->outputs_count = (size_t)reply->num_outputs;
+	/* Add the partition to the site, so that configuration changes can be processed */
+	data->root = screen->root;
+	data->changed = 0;
+	data->partition = this;
+	data->next = site_data->partitions;
+	site_data->partitions = data;
 
-	/* Create mapping table from CRTC indices to output indicies. (injection) */
-	if (reply->num_crtcs) {
-		if (reply->num_crtcs > SIZE_MAX / sizeof(*data->crtc_to_output)) {
-			errno = ENOMEM;
-			goto fail;
-		}
-		data->crtc_to_output = malloc((size_t)reply->num_crtcs * sizeof(*data->crtc_to_output));
-		if (!data->crtc_to_output)
-			goto fail;
-	}
-	/* All CRTC:s should be mapped, but incase they are not, all unmapped CRTC:s should have
-	 * an invalid target, namely `SIZE_MAX`, which is 1 more than the theoretical limit */
-	for (i = 0; i < (size_t)reply->num_crtcs; i++)
-		data->crtc_to_output[i] = SIZE_MAX;
-	/* Fill the table */
-	for (i = 0; i < (size_t)reply->num_outputs; i++) {
-		/* Query output (target) information */
-		out_cookie = xcb_randr_get_output_info(connection, outputs[i], reply->config_timestamp);
-		out_reply = xcb_randr_get_output_info_reply(connection, out_cookie, &error);
-		if (error) {
-			fail_rc = libgamma_x_randr_internal_translate_error(error->error_code,
-			                                                    LIBGAMMA_OUTPUT_INFORMATION_QUERY_FAILED, 0);
-			goto fail;
-		}
-
-		/* Find CRTC (source) */
-		for (j = 0; j < reply->num_crtcs; j++) {
-			if (crtcs[j] == out_reply->crtc) {
-				data->crtc_to_output[j] = i;
-				break;
-			}
-		}
-
-		/* Release output information */
-		free(out_reply);
-	}
-
-	/* Store the configuration timestamp */
-	data->config_timestamp = reply->config_timestamp;
 	/* Store the adjustment method dependent data */
 	this->data = data;
 	/* Release resources and return successfully */
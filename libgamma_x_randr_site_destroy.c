@@ -11,5 +11,7 @@
 void
 libgamma_x_randr_site_destroy(struct libgamma_site_state *restrict this)
 {
-	xcb_disconnect((xcb_connection_t *)this->data);
+	struct libgamma_x_randr_site_data *restrict data = this->data;
+	xcb_disconnect(data->connection);
+	free(data);
 }
@@ -0,0 +1,46 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Get a file descriptor that becomes readable when the configuration
+ * of a site changes
+ * 
+ * @param   this  The site state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_x_randr_site_get_event_fd(struct libgamma_site_state *restrict this, int *restrict fdp)
+{
+	struct libgamma_x_randr_site_data *restrict data = this->data;
+	const xcb_query_extension_reply_t *restrict extension;
+	const xcb_setup_t *restrict setup;
+	xcb_screen_iterator_t iter;
+
+	/* Request configuration change notifications for all screens the
+	 * first time the file descriptor is requested, the events are sent
+	 * over the connection to the display server */
+	if (!data->selected_input) {
+		extension = xcb_get_extension_data(data->connection, &xcb_randr_id);
+		if (!extension || !extension->present)
+			return LIBGAMMA_PROTOCOL_VERSION_QUERY_FAILED;
+		setup = xcb_get_setup(data->connection);
+		if (!setup)
+			return LIBGAMMA_LIST_PARTITIONS_FAILED;
+		for (iter = xcb_setup_roots_iterator(setup); iter.rem > 0; xcb_screen_next(&iter))
+			xcb_randr_select_input(data->connection, iter.data->root,
+			                       XCB_RANDR_NOTIFY_MASK_SCREEN_CHANGE |
+			                       XCB_RANDR_NOTIFY_MASK_CRTC_CHANGE |
+			                       XCB_RANDR_NOTIFY_MASK_OUTPUT_CHANGE);
+		if (xcb_flush(data->connection) <= 0)
+			return LIBGAMMA_NOT_CONNECTED;
+		data->first_event = extension->first_event;
+		data->selected_input = 1;
+	}
+
+	*fdp = xcb_get_file_descriptor(data->connection);
+	return 0;
+}
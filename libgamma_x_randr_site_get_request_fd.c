@@ -0,0 +1,21 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Get a file descriptor that becomes readable when
+ * asynchronous requests for CRTC:s in a site may
+ * have completed
+ * 
+ * @param   this  The site state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_x_randr_site_get_request_fd(struct libgamma_site_state *restrict this, int *restrict fdp)
+{
+	*fdp = xcb_get_file_descriptor(((struct libgamma_x_randr_site_data *)this->data)->connection);
+	return 0;
+}
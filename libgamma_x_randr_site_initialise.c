@@ -21,32 +21,58 @@ libgamma_x_randr_site_initialise(struct libgamma_site_state *restrict this, char
 {
 	xcb_generic_error_t *error = NULL;
 	xcb_connection_t *restrict connection;
+	struct libgamma_x_randr_site_data *restrict data;
 	xcb_randr_query_version_cookie_t cookie;
 	xcb_randr_query_version_reply_t *restrict reply;
+	xcb_intern_atom_cookie_t atom_cookie;
+	xcb_intern_atom_reply_t *restrict atom_reply;
 	const xcb_setup_t *restrict setup;
 	xcb_screen_iterator_t iter;
+	int rc;
+
+	/* Allocate the site data */
+	this->data = data = malloc(sizeof(*data));
+	if (!data)
+		return LIBGAMMA_ERRNO_SET;
+	data->partitions = NULL;
+	data->selected_input = 0;
+	data->first_event = 0;
 
 	/* Connect to the display server */
-	this->data = connection = xcb_connect(site, NULL);
-	if (!connection || xcb_connection_has_error(connection))
+	data->connection = connection = xcb_connect(site, NULL);
+	if (!connection || xcb_connection_has_error(connection)) {
+		/* The connection must be closed even if it failed */
+		xcb_disconnect(connection);
+		free(data);
 		return LIBGAMMA_OPEN_SITE_FAILED;
+	}
 
-	/* Query the version of the X RandR extension protocol */
+	/* Query the version of the X RandR extension protocol, and look up the
+	 * atoms we need, all at once, so that we only wait for one round trip */
 	cookie = xcb_randr_query_version(connection, RANDR_VERSION_MAJOR, RANDR_VERSION_MINOR);
+	atom_cookie = xcb_intern_atom(connection, 1, (uint16_t)(sizeof("EDID") - 1), "EDID");
 	reply = xcb_randr_query_version_reply(connection, cookie, &error);
 
 	/* Check for version query failure */
 	if (error || !reply) {
 		/* Release resources */
-		free(reply);
+		xcb_discard_reply(connection, atom_cookie.sequence);
 		/* If `xcb_connect` failed, both `error` and `reply` will be `NULL`.
 		 * TODO: Can both be `NULL` for any other reason? */
-		if (!error && !reply)
+		if (!error && !reply) {
+			xcb_disconnect(connection);
+			free(data);
 			return LIBGAMMA_OPEN_SITE_FAILED;
+		}
+		free(reply);
 		xcb_disconnect(connection);
+		free(data);
 		/* Translate and report error. */
-		if (error != NULL)
-			return libgamma_x_randr_internal_translate_error(error->error_code, LIBGAMMA_PROTOCOL_VERSION_QUERY_FAILED, 0);
+		if (error != NULL) {
+			rc = libgamma_x_randr_internal_translate_error(error->error_code, LIBGAMMA_PROTOCOL_VERSION_QUERY_FAILED, 0);
+			free(error);
+			return rc;
+		}
 		return LIBGAMMA_PROTOCOL_VERSION_QUERY_FAILED;
 	}
 
@@ -59,7 +85,9 @@ libgamma_x_randr_site_initialise(struct libgamma_site_state *restrict this, char
 #endif
 		/* Release resources */
 		free(reply);
+		xcb_discard_reply(connection, atom_cookie.sequence);
 		xcb_disconnect(connection);
+		free(data);
 		/* Report error */
 		return LIBGAMMA_PROTOCOL_VERSION_NOT_SUPPORTED;
 	}
@@ -67,10 +95,23 @@ libgamma_x_randr_site_initialise(struct libgamma_site_state *restrict this, char
 	/* We do not longer need to know the version of the protocol */
 	free(reply);
 
+	/* Get the "EDID" atom, if it does not exist, no output has an EDID */
+	atom_reply = xcb_intern_atom_reply(connection, atom_cookie, &error);
+	if (error) {
+		rc = libgamma_x_randr_internal_translate_error(error->error_code, LIBGAMMA_OPEN_SITE_FAILED, 0);
+		free(error);
+		xcb_disconnect(connection);
+		free(data);
+		return rc;
+	}
+	data->edid_atom = atom_reply ? atom_reply->atom : XCB_ATOM_NONE;
+	free(atom_reply);
+
 	/* Get available screens */
 	setup = xcb_get_setup(connection);
 	if (!setup) {
 		xcb_disconnect(connection);
+		free(data);
 		return LIBGAMMA_LIST_PARTITIONS_FAILED;
 	}
 	iter = xcb_setup_roots_iterator(setup);
@@ -78,5 +119,10 @@ libgamma_x_randr_site_initialise(struct libgamma_site_state *restrict this, char
 	this->partitions_available = (size_t)iter.rem;
 
 	/* Sanity check the number of available screens. */
-	return iter.rem >= 0 ? 0 : LIBGAMMA_NEGATIVE_PARTITION_COUNT;
+	if (iter.rem < 0) {
+		xcb_disconnect(connection);
+		free(data);
+		return LIBGAMMA_NEGATIVE_PARTITION_COUNT;
+	}
+	return 0;
 }
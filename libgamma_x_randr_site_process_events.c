@@ -0,0 +1,76 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Process all pending configuration change events for a
+ * site, without blocking, and refresh the cached data for
+ * the partitions whose configuration has changed
+ * 
+ * @param   this  The site state
+ * @return        1 if the configuration of at least one partition has
+ *                changed, 0 otherwise, or (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_x_randr_site_process_events(struct libgamma_site_state *restrict this)
+{
+	struct libgamma_x_randr_site_data *restrict data = this->data;
+	struct libgamma_x_randr_partition_data *partition;
+	xcb_generic_event_t *event;
+	xcb_window_t root;
+	int changed = 0, rc = 0, r, saved_errno = 0;
+
+	/* Mark the screens that have been changed, the events are only
+	 * read here, so a burst of events only causes one refresh */
+	while ((event = xcb_poll_for_event(data->connection))) {
+		switch ((uint8_t)((event->response_type & 0x7F) - data->first_event)) {
+		case XCB_RANDR_SCREEN_CHANGE_NOTIFY:
+			root = ((xcb_randr_screen_change_notify_event_t *)event)->root;
+			break;
+		case XCB_RANDR_NOTIFY:
+			if (((xcb_randr_notify_event_t *)event)->subCode == XCB_RANDR_NOTIFY_CRTC_CHANGE)
+				root = ((xcb_randr_notify_event_t *)event)->u.cc.window;
+			else if (((xcb_randr_notify_event_t *)event)->subCode == XCB_RANDR_NOTIFY_OUTPUT_CHANGE)
+				root = ((xcb_randr_notify_event_t *)event)->u.oc.window;
+			else
+				goto next;
+			break;
+		default:
+			/* Not a RandR event, or an error for a request whose
+			 * reply was not checked, neither of which is ours */
+			goto next;
+		}
+		for (partition = data->partitions; partition; partition = partition->next)
+			if (partition->root == root)
+				partition->changed = 1;
+	next:
+		free(event);
+	}
+	if (xcb_connection_has_error(data->connection))
+		return LIBGAMMA_NOT_CONNECTED;
+
+	/* Refresh the changed screens */
+	for (partition = data->partitions; partition; partition = partition->next) {
+		if (!partition->changed)
+			continue;
+		partition->changed = 0;
+		r = libgamma_x_randr_internal_refresh_partition(partition, data->connection);
+		if (r < 0) {
+			if (!rc) {
+				rc = r;
+				saved_errno = errno;
+			}
+		} else {
+			changed = 1;
+		}
+	}
+
+	/* Report the first error, after all partitions have been refreshed */
+	if (rc) {
+		errno = saved_errno;
+		return rc;
+	}
+	return changed;
+}
@@ -0,0 +1,64 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_RANDR
+#include "common.h"
+
+
+/**
+ * Apply all gamma ramps staged in a transaction
+ * 
+ * @param   this  The transaction
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_x_randr_transaction_commit(struct libgamma_transaction *restrict this)
+{
+	xcb_connection_t *restrict connection = ((struct libgamma_x_randr_site_data *)this->site->data)->connection;
+	struct libgamma_transaction_entry *entry;
+	xcb_void_cookie_t *cookies;
+	xcb_generic_error_t *error;
+	const uint16_t *red, *green, *blue;
+	int rc = 0;
+	size_t i;
+
+	if (!this->count)
+		return 0;
+	if (this->count > SIZE_MAX / sizeof(*cookies)) {
+		errno = ENOMEM;
+		return LIBGAMMA_ERRNO_SET;
+	}
+	cookies = malloc(this->count * sizeof(*cookies));
+	if (!cookies)
+		return LIBGAMMA_ERRNO_SET;
+
+	/* Send all requests before checking any of them */
+	for (i = 0; i < this->count; i++) {
+		entry = &this->entries[i];
+#ifdef DEBUG
+		/* Gamma ramp sizes are identical but not fixed */
+		if (entry->red_size != entry->green_size || entry->red_size != entry->blue_size) {
+			free(cookies);
+			return LIBGAMMA_MIXED_GAMMA_RAMP_SIZE;
+		}
+#endif
+		red   = &this->arena[entry->offset];
+		green = &red[entry->red_size];
+		blue  = &green[entry->green_size];
+		cookies[i] = xcb_randr_set_crtc_gamma_checked(connection, *(xcb_randr_crtc_t *)entry->crtc->data,
+		                                              (uint16_t)entry->red_size, red, green, blue);
+	}
+
+	/* The first check waits for the display server to process all of
+	 * the requests, after which the rest can be checked without waiting */
+	for (i = 0; i < this->count; i++) {
+		error = xcb_request_check(connection, cookies[i]);
+		if (error) {
+			if (!rc)
+				rc = libgamma_x_randr_internal_translate_error(error->error_code, LIBGAMMA_GAMMA_RAMP_WRITE_FAILED, 0);
+			free(error);
+		}
+	}
+
+	free(cookies);
+	return rc;
+}
@@ -0,0 +1,20 @@
+/* See LICENSE file for copyright and license details. */
+#define IN_LIBGAMMA_X_VIDMODE
+#include "common.h"
+
+
+/**
+ * Get the file descriptor of the connection to the display
+ * server or graphics card that a partition uses
+ * 
+ * @param   this  The partition state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+int
+libgamma_x_vidmode_partition_get_fd(struct libgamma_partition_state *restrict this, int *restrict fdp)
+{
+	*fdp = ConnectionNumber((Display *)this->site->data);
+	return 0;
+}
@@ -437,6 +437,18 @@ int libgamma_dummy_crtc_get_gamma_rampsd(struct libgamma_crtc_state *restrict, s
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
 int libgamma_dummy_crtc_set_gamma_rampsd(struct libgamma_crtc_state *restrict, const struct libgamma_gamma_rampsd *restrict);
 
+/**
+ * Check whether the gamma ramp functions for a CRTC will translate
+ * the gamma ramps and call the public function for the CRTC's
+ * gamma ramp depth, rather than access the gamma ramps directly
+ * 
+ * @param   this   The CRTC state
+ * @param   depth  The depth of the gamma ramps, `-1` for `float`, `-2` for `double`
+ * @return         1 if the gamma ramps will be translated, 0 otherwise
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_dummy_internal_crtc_translates(const struct libgamma_crtc_state *restrict, signed);
+
 
 
 #ifdef IN_LIBGAMMA_DUMMY
@@ -480,7 +492,7 @@ if (!data->info.gamma_support)
 #ifdef LIBGAMMA_DUMMY_GET_RAMPS
 # define TRANSLATE(TDEPTH, SUFFIX)\
 do {\
-	if (data->info.gamma_depth == DEPTH) {\
+	if (data->info.gamma_depth == (TDEPTH)) {\
 		ramps_.FIELD = *ramps;\
 		return libgamma_internal_translated_ramp_get(this, &ramps_, DEPTH, TDEPTH, libgamma_crtc_get_gamma_ramps##SUFFIX);\
 	}\
@@ -488,7 +500,7 @@ do {\
 #else
 # define TRANSLATE(TDEPTH, SUFFIX)\
 do {\
-	if (data->info.gamma_depth == DEPTH) {\
+	if (data->info.gamma_depth == (TDEPTH)) {\
 		ramps_.FIELD = *ramps;\
 		return libgamma_internal_translated_ramp_set(this, &ramps_, DEPTH, TDEPTH, libgamma_crtc_set_gamma_ramps##SUFFIX); \
 	}\
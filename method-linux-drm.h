@@ -1,9 +1,52 @@
 /* See LICENSE file for copyright and license details. */
 
 #ifdef IN_LIBGAMMA_LINUX_DRM 
+# include <sys/socket.h>
+# include <linux/netlink.h>
 # include <xf86drm.h>
 # include <xf86drmMode.h>
 
+
+/* Property name, field in `struct libgamma_drm_card_data` for the property ID */
+# define LIST_DRM_PROPERTIES(_)\
+	_("EDID", edid_prop)\
+	_("GAMMA_LUT", gamma_lut_prop)\
+	_("GAMMA_LUT_SIZE", gamma_lut_size_prop)\
+	_("DEGAMMA_LUT", degamma_lut_prop)\
+	_("CTM", ctm_prop)
+
+/**
+ * The gamma ramps a CRTC had before they were first
+ * changed, for the Direct Rendering Manager adjustment method
+ */
+struct libgamma_drm_saved_gamma {
+	/**
+	 * Whether the gamma ramps have been saved
+	 */
+	int saved;
+
+	/**
+	 * If the CRTC has the "GAMMA_LUT" property: a property
+	 * blob with a copy of the gamma ramps, 0 if the gamma
+	 * ramps were bypassed
+	 */
+	uint32_t lut;
+
+	/**
+	 * If the CRTC does not have the "GAMMA_LUT" property:
+	 * the number of stops in each channel
+	 */
+	uint32_t size;
+
+	/**
+	 * If the CRTC does not have the "GAMMA_LUT" property:
+	 * the gamma ramps, the red channel followed by the
+	 * green channel followed by the blue channel;
+	 * otherwise `NULL`
+	 */
+	uint16_t *ramps;
+};
+
 /**
  * Graphics card data for the Direct Rendering Manager adjustment method
  */
@@ -19,14 +62,142 @@ struct libgamma_drm_card_data {
 	drmModeRes *res;
 
 	/**
-	 * Resources for open connectors
+	 * Resources for open connectors (in the same order as in
+	 * `res->connectors`), connectors are opened when they are
+	 * needed, and are `NULL` until then
 	 */
 	drmModeConnector **connectors;
 
 	/**
-	 * Resources for open encoders
+	 * Resources for open encoders, one per connector (in the
+	 * same order as `connectors`), `NULL` if the connector is
+	 * not open or does not have an encoder
 	 */
 	drmModeEncoder **encoders;
+
+	/**
+	 * Mapping from CRTC indices to the indices of their
+	 * connectors, `SIZE_MAX` if not known yet
+	 */
+	size_t *crtc_to_connector;
+
+	/**
+	 * The number of connectors, from the beginning of
+	 * `connectors`, that have been opened and added
+	 * to `crtc_to_connector`
+	 */
+	size_t connectors_scanned;
+
+	/**
+	 * Whether atomic modesetting is enabled for the connection
+	 */
+	int atomic;
+
+	/**
+	 * The ID of the "EDID" connector property, 0 if not looked up yet;
+	 * property IDs are the same for all objects on a graphics card
+	 */
+	uint32_t edid_prop;
+
+	/**
+	 * The ID of the "GAMMA_LUT" CRTC property, 0 if not looked up yet
+	 */
+	uint32_t gamma_lut_prop;
+
+	/**
+	 * The ID of the "GAMMA_LUT_SIZE" CRTC property, 0 if not looked up yet
+	 */
+	uint32_t gamma_lut_size_prop;
+
+	/**
+	 * The ID of the "DEGAMMA_LUT" CRTC property, 0 if not looked up yet
+	 */
+	uint32_t degamma_lut_prop;
+
+	/**
+	 * The ID of the "CTM" CRTC property, 0 if not looked up yet
+	 */
+	uint32_t ctm_prop;
+
+	/**
+	 * For each CRTC (in the same order as in `res->crtcs`), the ID
+	 * of its "GAMMA_LUT" property, or 0 if the CRTC does not have
+	 * one or atomic modesetting is not enabled, in which case the
+	 * legacy gamma ioctls are used for the CRTC
+	 */
+	uint32_t *gamma_lut_props;
+
+	/**
+	 * For each CRTC (in the same order as in `res->crtcs`),
+	 * the value of its "GAMMA_LUT_SIZE" property, only
+	 * meaningful if `gamma_lut_props` has the CRTC's
+	 * "GAMMA_LUT" property
+	 */
+	uint32_t *gamma_lut_sizes;
+
+	/**
+	 * For each CRTC (in the same order as in `res->crtcs`),
+	 * the property blob with the gamma ramps that shall be
+	 * applied at the next atomic commit, 0 if none
+	 */
+	uint32_t *pending_gamma_luts;
+
+	/**
+	 * Whether gamma ramp updates are deferred until
+	 * `libgamma_linux_drm_partition_commit_updates`
+	 * is called
+	 */
+	int deferring;
+
+	/**
+	 * For each CRTC (in the same order as in `res->crtcs`),
+	 * the gamma ramps it had before they were first changed,
+	 * these are used to restore the CRTC
+	 */
+	struct libgamma_drm_saved_gamma *saved_gammas;
+
+	/**
+	 * Buffer for gamma ramps interleaved into the layout
+	 * of the "GAMMA_LUT" property, kept between calls so
+	 * that it does not have to be reallocated every time
+	 * gamma ramps are applied; it is separate from the
+	 * CRTC state's `ramps_buffer` as the gamma ramps to
+	 * apply may be stored in that buffer
+	 */
+	struct drm_color_lut *lut_buffer;
+
+	/**
+	 * The number of elements allocated for `lut_buffer`
+	 */
+	size_t lut_buffer_size;
+
+	/**
+	 * The partition state for the graphics card
+	 */
+	struct libgamma_partition_state *partition;
+
+	/**
+	 * The next graphics card opened in the same site
+	 */
+	struct libgamma_drm_card_data *next;
+};
+
+/**
+ * Site data for the Direct Rendering Manager adjustment method
+ */
+struct libgamma_drm_site_data {
+	/**
+	 * The first graphics card opened in the site,
+	 * the rest are linked from it
+	 */
+	struct libgamma_drm_card_data *cards;
+
+	/**
+	 * Netlink socket that receives uevents from the kernel,
+	 * -1 if `libgamma_linux_drm_site_get_event_fd` has not
+	 * been called
+	 */
+	int event_fd;
 };
 #endif
 
@@ -74,6 +245,31 @@ void libgamma_linux_drm_site_destroy(struct libgamma_site_state *restrict);
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
 int libgamma_linux_drm_site_restore(struct libgamma_site_state *restrict);
 
+/**
+ * Get a file descriptor that becomes readable when the configuration
+ * of a site changes
+ * 
+ * @param   this  The site state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_site_get_event_fd(struct libgamma_site_state *restrict, int *restrict);
+
+/**
+ * Process all pending configuration change events for a
+ * site, without blocking, and refresh the cached data for
+ * the partitions whose configuration has changed
+ * 
+ * @param   this  The site state
+ * @return        1 if the configuration of at least one partition has
+ *                changed, 0 otherwise, or (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_site_process_events(struct libgamma_site_state *restrict);
+
 
 /**
  * Initialise an allocated partition state
@@ -105,6 +301,43 @@ void libgamma_linux_drm_partition_destroy(struct libgamma_partition_state *restr
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
 int libgamma_linux_drm_partition_restore(struct libgamma_partition_state *restrict);
 
+/**
+ * Get the file descriptor of the connection to the display
+ * server or graphics card that a partition uses
+ * 
+ * @param   this  The partition state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_partition_get_fd(struct libgamma_partition_state *restrict, int *restrict);
+
+
+/**
+ * Start deferring gamma ramp updates for the CRTC:s in a
+ * partition, so that they are applied together, in one
+ * atomic commit, by `libgamma_linux_drm_partition_commit_updates`
+ * 
+ * @param   this  The partition state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_partition_defer_updates(struct libgamma_partition_state *restrict);
+
+/**
+ * Apply all gamma ramp updates that have been deferred with
+ * `libgamma_linux_drm_partition_defer_updates`, in one atomic
+ * commit, and stop deferring gamma ramp updates
+ * 
+ * @param   this  The partition state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_partition_commit_updates(struct libgamma_partition_state *restrict);
+
 
 /**
  * Initialise an allocated CRTC state
@@ -171,9 +404,71 @@ int libgamma_linux_drm_crtc_get_gamma_ramps16(struct libgamma_crtc_state *restri
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
 int libgamma_linux_drm_crtc_set_gamma_ramps16(struct libgamma_crtc_state *restrict, const struct libgamma_gamma_ramps16 *restrict);
 
+/**
+ * Get the current gamma ramps for a CRTC, interleaved 16-bit gamma-depth version
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to fill with the current values
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_crtc_get_gamma_ramps16_interleaved(struct libgamma_crtc_state *restrict,
+                                                          struct libgamma_gamma_ramps16_interleaved *restrict);
+
+/**
+ * Set the gamma ramps for a CRTC, interleaved 16-bit gamma-depth version
+ * 
+ * @param   this   The CRTC state
+ * @param   ramps  The gamma ramps to apply
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_crtc_set_gamma_ramps16_interleaved(struct libgamma_crtc_state *restrict,
+                                                          const struct libgamma_gamma_ramps16_interleaved *restrict);
+
+/**
+ * Get the refresh period of the mode a CRTC is configured with
+ * 
+ * @param   this    The CRTC state
+ * @param   period  Output parameter for the refresh period, in
+ *                  milliseconds rounded to the nearest, at least 1
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_crtc_get_refresh_period(struct libgamma_crtc_state *restrict, unsigned long int *restrict);
+
 
 
 #ifdef IN_LIBGAMMA_LINUX_DRM 
+/**
+ * Open a connector, and its encoder, unless already opened
+ * 
+ * @param   this  The graphics card data, `connectors` and
+ *                `encoders` must be allocated
+ * @param   i     The index of the connector
+ * @return        Zero on success, -1 on error
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_internal_open_connector(struct libgamma_drm_card_data *restrict, size_t);
+
+/**
+ * Reload the mode resources of a graphics card, after its
+ * configuration has changed, forget the connectors, and
+ * look up the "GAMMA_LUT" and "GAMMA_LUT_SIZE" properties
+ * again, as the size of the gamma ramps may depend on the mode
+ * 
+ * @param   this  The graphics card data
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library; `errno`
+ *                is set to `ESTALE` if the CRTC:s have changed, in
+ *                which case the partition must be reinitialised
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_internal_refresh_card(struct libgamma_drm_card_data *restrict);
+
 /**
  * Release all connectors and encoders
  * 
@@ -181,4 +476,126 @@ int libgamma_linux_drm_crtc_set_gamma_ramps16(struct libgamma_crtc_state *restri
  */
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
 void libgamma_linux_drm_internal_release_connectors_and_encoders(struct libgamma_drm_card_data *restrict);
+
+/**
+ * Enable atomic modesetting, if supported, and look up
+ * the "GAMMA_LUT" and "GAMMA_LUT_SIZE" properties of
+ * each CRTC; failure is not an error, it just means
+ * that the legacy gamma ioctls will be used
+ * 
+ * @param   this  The graphics card data, `gamma_lut_props`
+ *                and `gamma_lut_sizes` must be allocated
+ *                and zero-initialised
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_linux_drm_internal_probe_atomic(struct libgamma_drm_card_data *restrict);
+
+/**
+ * Look up the IDs of the properties in `LIST_DRM_PROPERTIES`,
+ * among the properties of a DRM object, properties whose
+ * IDs are already known are not looked up again
+ * 
+ * @param  this   The graphics card data
+ * @param  props  The IDs of the object's properties
+ * @param  n      The number of elements in `props`
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__(1))))
+void libgamma_linux_drm_internal_resolve_properties(struct libgamma_drm_card_data *restrict, const uint32_t *restrict, size_t);
+
+/**
+ * Apply all pending gamma ramps, for all CRTC:s on a
+ * graphics card, in one atomic commit, and release
+ * the property blobs
+ * 
+ * @param   this  The graphics card data
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_internal_commit_gamma_luts(struct libgamma_drm_card_data *restrict);
+
+/**
+ * Release all pending gamma ramps without applying them
+ * 
+ * @param  this  The graphics card data
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_linux_drm_internal_discard_gamma_luts(struct libgamma_drm_card_data *restrict);
+
+/**
+ * Get the value of the "GAMMA_LUT" property of a CRTC
+ * 
+ * @param   this  The CRTC state, the CRTC must have the "GAMMA_LUT" property
+ * @param   n     The number of stops the gamma ramps are expected to have,
+ *                must be the CRTC's "GAMMA_LUT_SIZE"
+ * @param   blob  Output parameter for the property blob with the gamma ramps,
+ *                which shall be released with `drmModeFreePropertyBlob`;
+ *                `NULL` if the CRTC does not have any gamma ramps, which
+ *                means that gamma correction is bypassed
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_internal_get_gamma_lut(struct libgamma_crtc_state *restrict, size_t, drmModePropertyBlobRes **restrict);
+
+/**
+ * Get the graphics card's buffer for gamma ramps in
+ * the layout of the "GAMMA_LUT" property
+ * 
+ * @param   this  The graphics card data
+ * @param   n     The number of stops required
+ * @return        The buffer, `NULL` on error
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+struct drm_color_lut *libgamma_linux_drm_internal_lut_buffer(struct libgamma_drm_card_data *restrict, size_t);
+
+/**
+ * Get the value of a stop in identity gamma ramps, which
+ * is what a CRTC without a "GAMMA_LUT" blob applies
+ * 
+ * @param   i  The index of the stop
+ * @param   n  The number of stops in the gamma ramps, at least 2
+ * @return     The value of the stop
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__const__, __warn_unused_result__)))
+uint16_t libgamma_linux_drm_internal_identity_stop(size_t, size_t);
+
+/**
+ * Set the "GAMMA_LUT" property of a CRTC, the change is
+ * committed immediately unless updates are being deferred
+ * 
+ * @param   this  The CRTC state, the CRTC must have the "GAMMA_LUT" property
+ * @param   lut   The gamma ramps
+ * @param   n     The number of stops in `lut`
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_internal_set_gamma_lut(struct libgamma_crtc_state *restrict, const struct drm_color_lut *restrict, size_t);
+
+/**
+ * Save the gamma ramps of a CRTC, so that it can be restored,
+ * unless they have already been saved; this shall be called
+ * before the gamma ramps are changed
+ * 
+ * @param   this  The CRTC state
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_internal_save_gamma(struct libgamma_crtc_state *restrict);
+
+/**
+ * Restore the saved gamma ramps for a range of CRTC:s on a graphics
+ * card, all CRTC:s with the "GAMMA_LUT" property are restored in one
+ * atomic commit; pending gamma ramps for the CRTC:s are discarded
+ * 
+ * @param   this   The graphics card data
+ * @param   start  The index of the first CRTC to restore
+ * @param   end    The index of the CRTC after the last CRTC to restore
+ * @return         Zero on success, otherwise (negative) the value of an
+ *                 error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_linux_drm_internal_restore_gammas(struct libgamma_drm_card_data *restrict, size_t, size_t);
 #endif
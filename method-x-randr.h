@@ -3,6 +3,7 @@
 
 #ifdef IN_LIBGAMMA_X_RANDR
 # include <xcb/xcb.h>
+# include <xcb/xcbext.h>
 # include <xcb/randr.h>
 
 
@@ -17,6 +18,43 @@
 # define RANDR_VERSION_MINOR  3
 
 
+struct libgamma_x_randr_partition_data;
+
+/**
+ * Data structure for site data
+ */
+struct libgamma_x_randr_site_data {
+	/**
+	 * The connection to the display server
+	 */
+	xcb_connection_t *connection;
+
+	/**
+	 * The "EDID" atom, `XCB_ATOM_NONE` if it did not
+	 * exist on the display server when the site was
+	 * opened or the configuration last changed
+	 */
+	xcb_atom_t edid_atom;
+
+	/**
+	 * The first partition that has been initialised,
+	 * the rest are linked from it
+	 */
+	struct libgamma_x_randr_partition_data *partitions;
+
+	/**
+	 * Whether notifications about configuration
+	 * changes have been requested
+	 */
+	int selected_input;
+
+	/**
+	 * The event code of the first RandR event, only
+	 * set if `selected_input` is non-zero
+	 */
+	uint8_t first_event;
+};
+
 /**
  * Data structure for partition data
  */
@@ -48,6 +86,27 @@ struct libgamma_x_randr_partition_data {
 	 * Screen configuration timestamp
 	 */
 	xcb_timestamp_t config_timestamp;
+
+	/**
+	 * The root window of the screen
+	 */
+	xcb_window_t root;
+
+	/**
+	 * Whether a configuration change notification
+	 * has been received but not yet processed
+	 */
+	int changed;
+
+	/**
+	 * The partition state for the screen
+	 */
+	struct libgamma_partition_state *partition;
+
+	/**
+	 * The next partition initialised in the same site
+	 */
+	struct libgamma_x_randr_partition_data *next;
 };
 #endif
 
@@ -95,6 +154,44 @@ void libgamma_x_randr_site_destroy(struct libgamma_site_state *restrict);
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
 int libgamma_x_randr_site_restore(struct libgamma_site_state *restrict);
 
+/**
+ * Get a file descriptor that becomes readable when the configuration
+ * of a site changes
+ * 
+ * @param   this  The site state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_site_get_event_fd(struct libgamma_site_state *restrict, int *restrict);
+
+/**
+ * Process all pending configuration change events for a
+ * site, without blocking, and refresh the cached data for
+ * the partitions whose configuration has changed
+ * 
+ * @param   this  The site state
+ * @return        1 if the configuration of at least one partition has
+ *                changed, 0 otherwise, or (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_site_process_events(struct libgamma_site_state *restrict);
+
+/**
+ * Get a file descriptor that becomes readable when
+ * asynchronous requests for CRTC:s in a site may
+ * have completed
+ * 
+ * @param   this  The site state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_site_get_request_fd(struct libgamma_site_state *restrict, int *restrict);
+
 
 /**
  * Initialise an allocated partition state
@@ -126,6 +223,18 @@ void libgamma_x_randr_partition_destroy(struct libgamma_partition_state *restric
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
 int libgamma_x_randr_partition_restore(struct libgamma_partition_state *restrict);
 
+/**
+ * Get the file descriptor of the connection to the display
+ * server or graphics card that a partition uses
+ * 
+ * @param   this  The partition state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_partition_get_fd(struct libgamma_partition_state *restrict, int *restrict);
+
 
 /**
  * Initialise an allocated CRTC state
@@ -192,6 +301,71 @@ int libgamma_x_randr_crtc_get_gamma_ramps16(struct libgamma_crtc_state *restrict
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
 int libgamma_x_randr_crtc_set_gamma_ramps16(struct libgamma_crtc_state *restrict, const struct libgamma_gamma_ramps16 *restrict);
 
+/**
+ * Submit a request to get the current gamma ramps for a CRTC,
+ * 16-bit gamma-depth version, without waiting for a reply
+ * 
+ * @param   request  The request, with `crtc` and `ramps` set
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_crtc_submit_get_gamma_ramps16(struct libgamma_crtc_request *restrict);
+
+/**
+ * Submit a request to set the gamma ramps for a CRTC,
+ * 16-bit gamma-depth version, without waiting for
+ * the display server to acknowledge it
+ * 
+ * @param   request  The request, with `crtc` set
+ * @param   ramps    The gamma ramps to apply
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_crtc_submit_set_gamma_ramps16(struct libgamma_crtc_request *restrict, const struct libgamma_gamma_ramps16 *restrict);
+
+/**
+ * Complete a submitted request, without blocking
+ * 
+ * @param   request  The request
+ * @return           Zero on success, otherwise (negative) the value of an
+ *                   error identifier provided by this library; `errno`
+ *                   is set to `EAGAIN` if the reply has not arrived yet
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_complete_request(struct libgamma_crtc_request *restrict);
+
+/**
+ * Abandon a submitted request that has not been completed
+ * 
+ * @param  request  The request
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__)))
+void libgamma_x_randr_discard_request(struct libgamma_crtc_request *restrict);
+
+/**
+ * Apply all gamma ramps staged in a transaction
+ * 
+ * @param   this  The transaction
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_transaction_commit(struct libgamma_transaction *restrict);
+
+/**
+ * Get the refresh period of the mode a CRTC is configured with
+ * 
+ * @param   this    The CRTC state
+ * @param   period  Output parameter for the refresh period, in
+ *                  milliseconds rounded to the nearest, at least 1
+ * @return          Zero on success, otherwise (negative) the value of an
+ *                  error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_crtc_get_refresh_period(struct libgamma_crtc_state *restrict, unsigned long int *restrict);
+
 
 
 #ifdef IN_LIBGAMMA_X_RANDR
@@ -206,6 +380,38 @@ int libgamma_x_randr_crtc_set_gamma_ramps16(struct libgamma_crtc_state *restrict
 LIBGAMMA_GCC_ONLY__(__attribute__((__warn_unused_result__)))
 int libgamma_x_randr_internal_translate_error(int, int, int);
 
+/**
+ * Read the outputs of a screen and map the CRTC:s to them,
+ * replacing the outputs stored in the partition data
+ * 
+ * The output information is queried for all outputs before
+ * any reply is waited for, so only one round trip is made
+ * 
+ * @param   this        The partition data
+ * @param   connection  The connection to the display server
+ * @param   reply       The current resources of the screen
+ * @return              Zero on success, otherwise (negative) the value of an
+ *                      error identifier provided by this library; on failure
+ *                      the partition data is left unmodified
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_internal_read_outputs(struct libgamma_x_randr_partition_data *restrict, xcb_connection_t *restrict,
+                                           xcb_randr_get_screen_resources_current_reply_t *restrict);
+
+/**
+ * Reload the resources of a screen, after its
+ * configuration has changed
+ * 
+ * @param   this        The partition data
+ * @param   connection  The connection to the display server
+ * @return              Zero on success, otherwise (negative) the value of an
+ *                      error identifier provided by this library; `errno`
+ *                      is set to `ESTALE` if the CRTC:s have changed, in
+ *                      which case the partition must be reinitialised
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_randr_internal_refresh_partition(struct libgamma_x_randr_partition_data *restrict, xcb_connection_t *restrict);
+
 
 
 /* xcb violates the rule to never return struct:s */
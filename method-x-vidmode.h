@@ -79,6 +79,18 @@ void libgamma_x_vidmode_partition_destroy(struct libgamma_partition_state *restr
 LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
 int libgamma_x_vidmode_partition_restore(struct libgamma_partition_state *restrict);
 
+/**
+ * Get the file descriptor of the connection to the display
+ * server or graphics card that a partition uses
+ * 
+ * @param   this  The partition state
+ * @param   fdp   Output parameter for the file descriptor
+ * @return        Zero on success, otherwise (negative) the value of an
+ *                error identifier provided by this library
+ */
+LIBGAMMA_GCC_ONLY__(__attribute__((__nonnull__, __warn_unused_result__)))
+int libgamma_x_vidmode_partition_get_fd(struct libgamma_partition_state *restrict, int *restrict);
+
 
 /**
  * Initialise an allocated CRTC state
@@ -10,13 +10,33 @@ OBJ_LINUX_DRM =\
 	libgamma_linux_drm_site_initialise.o\
 	libgamma_linux_drm_site_destroy.o\
 	libgamma_linux_drm_site_restore.o\
+	libgamma_linux_drm_site_get_event_fd.o\
+	libgamma_linux_drm_site_process_events.o\
 	libgamma_linux_drm_partition_initialise.o\
 	libgamma_linux_drm_partition_destroy.o\
 	libgamma_linux_drm_partition_restore.o\
+	libgamma_linux_drm_partition_get_fd.o\
+	libgamma_linux_drm_partition_defer_updates.o\
+	libgamma_linux_drm_partition_commit_updates.o\
 	libgamma_linux_drm_crtc_initialise.o\
 	libgamma_linux_drm_crtc_destroy.o\
 	libgamma_linux_drm_crtc_restore.o\
 	libgamma_linux_drm_get_crtc_information.o\
 	libgamma_linux_drm_crtc_get_gamma_ramps16.o\
 	libgamma_linux_drm_crtc_set_gamma_ramps16.o\
-	libgamma_linux_drm_internal_release_connectors_and_encoders.o
+	libgamma_linux_drm_crtc_get_gamma_ramps16_interleaved.o\
+	libgamma_linux_drm_crtc_set_gamma_ramps16_interleaved.o\
+	libgamma_linux_drm_crtc_get_refresh_period.o\
+	libgamma_linux_drm_internal_open_connector.o\
+	libgamma_linux_drm_internal_release_connectors_and_encoders.o\
+	libgamma_linux_drm_internal_probe_atomic.o\
+	libgamma_linux_drm_internal_resolve_properties.o\
+	libgamma_linux_drm_internal_commit_gamma_luts.o\
+	libgamma_linux_drm_internal_discard_gamma_luts.o\
+	libgamma_linux_drm_internal_get_gamma_lut.o\
+	libgamma_linux_drm_internal_lut_buffer.o\
+	libgamma_linux_drm_internal_identity_stop.o\
+	libgamma_linux_drm_internal_set_gamma_lut.o\
+	libgamma_linux_drm_internal_save_gamma.o\
+	libgamma_linux_drm_internal_restore_gammas.o\
+	libgamma_linux_drm_internal_refresh_card.o
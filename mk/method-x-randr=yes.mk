@@ -10,13 +10,25 @@ OBJ_X_RANDR =\
 	libgamma_x_randr_site_initialise.o\
 	libgamma_x_randr_site_destroy.o\
 	libgamma_x_randr_site_restore.o\
+	libgamma_x_randr_site_get_event_fd.o\
+	libgamma_x_randr_site_process_events.o\
+	libgamma_x_randr_site_get_request_fd.o\
 	libgamma_x_randr_partition_initialise.o\
 	libgamma_x_randr_partition_destroy.o\
 	libgamma_x_randr_partition_restore.o\
+	libgamma_x_randr_partition_get_fd.o\
 	libgamma_x_randr_crtc_initialise.o\
 	libgamma_x_randr_crtc_destroy.o\
 	libgamma_x_randr_crtc_restore.o\
 	libgamma_x_randr_get_crtc_information.o\
 	libgamma_x_randr_crtc_get_gamma_ramps16.o\
 	libgamma_x_randr_crtc_set_gamma_ramps16.o\
-	libgamma_x_randr_internal_translate_error.o
+	libgamma_x_randr_crtc_submit_get_gamma_ramps16.o\
+	libgamma_x_randr_crtc_submit_set_gamma_ramps16.o\
+	libgamma_x_randr_complete_request.o\
+	libgamma_x_randr_discard_request.o\
+	libgamma_x_randr_transaction_commit.o\
+	libgamma_x_randr_crtc_get_refresh_period.o\
+	libgamma_x_randr_internal_translate_error.o\
+	libgamma_x_randr_internal_read_outputs.o\
+	libgamma_x_randr_internal_refresh_partition.o
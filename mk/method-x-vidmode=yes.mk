@@ -13,6 +13,7 @@ OBJ_X_VIDMODE =\
 	libgamma_x_vidmode_partition_initialise.o\
 	libgamma_x_vidmode_partition_destroy.o\
 	libgamma_x_vidmode_partition_restore.o\
+	libgamma_x_vidmode_partition_get_fd.o\
 	libgamma_x_vidmode_crtc_initialise.o\
 	libgamma_x_vidmode_crtc_destroy.o\
 	libgamma_x_vidmode_crtc_restore.o\
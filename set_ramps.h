@@ -7,19 +7,38 @@
 
 
 union gamma_ramps_any ramps_;
+uint64_t fingerprint_;
+unsigned long long int start_;
+int r_, native_ = 1, timed_ = 1;
+ramps_.TYPE = *ramps;
+if (libgamma_internal_write_is_redundant(this, &ramps_, DEPTH, &fingerprint_))
+	return 0;
+start_ = libgamma_internal_stats_start();
 switch (this->partition->site->method) {
 #define X(CONST, CNAME, MDEPTH, MRAMPS)\
 case CONST:\
 	if (!(MDEPTH)) {\
-		return APPEND_RAMPS(libgamma_dummy_crtc_set_gamma_)(this, (const void *)ramps); /* only dummy is flexible */\
+		timed_ = !libgamma_dummy_internal_crtc_translates(this, DEPTH);\
+		r_ = APPEND_RAMPS(libgamma_dummy_crtc_set_gamma_)(this, (const void *)ramps); /* only dummy is flexible */\
 	} else if ((DEPTH) == (MDEPTH)) {\
-		return libgamma_##CNAME##_crtc_set_gamma_##MRAMPS(this, (const void *)ramps);\
+		r_ = libgamma_##CNAME##_crtc_set_gamma_##MRAMPS(this, (const void *)ramps);\
 	} else {\
-		ramps_.TYPE = *ramps;\
-		return libgamma_internal_translated_ramp_set(this, &ramps_, DEPTH, MDEPTH, libgamma_crtc_set_gamma_##MRAMPS);\
-	}
+		/* The gamma ramps are cached in the adjustment method's depth */\
+		r_ = libgamma_internal_translated_ramp_set(this, &ramps_, DEPTH, MDEPTH, libgamma_crtc_set_gamma_##MRAMPS);\
+		native_ = timed_ = 0;\
+	}\
+	break;
 LIST_AVAILABLE_METHODS(X)
 #undef X
 default:
 	return LIBGAMMA_NO_SUCH_ADJUSTMENT_METHOD;
 }
+/* Translated gamma ramps are recorded when they are applied in the adjustment method's depth */
+if (timed_)
+	libgamma_internal_stats_record(this->partition->site->method, LIBGAMMA_STATS_SET_GAMMA, start_, r_);
+libgamma_internal_record_write(this, DEPTH, fingerprint_, r_);
+if (r_)
+	this->read_cache_depth = 0;
+else if (native_)
+	libgamma_internal_cache_ramps(this, &ramps_, DEPTH);
+return r_;
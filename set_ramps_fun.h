@@ -6,31 +6,25 @@
  */
 
 
-struct libgamma_crtc_information info;
 struct APPEND_RAMPS(libgamma_gamma_) ramps;
 size_t i, n;
 int e;
 
-/* Get the size of the gamma ramps */
-if (libgamma_get_crtc_information(&info, sizeof(info), this, LIBGAMMA_CRTC_INFO_GAMMA_SIZE)) {
-	e = info.gamma_size_error;
-	if (e < 0)
-		return e;
-	errno = e;
-	return LIBGAMMA_ERRNO_SET;
- }
+/* Get the size of the gamma ramps, unless it is cached */
+if ((e = libgamma_internal_cache_gamma_sizes(this)))
+	return e;
 
 /* Copy the size of the gamma ramps and calculte the grand size */
-n  = ramps.  red_size = info.  red_gamma_size;
-n += ramps.green_size = info.green_gamma_size;
-n += ramps. blue_size = info. blue_gamma_size;
+n  = ramps.  red_size = this->cached_red_gamma_size;
+n += ramps.green_size = this->cached_green_gamma_size;
+n += ramps. blue_size = this->cached_blue_gamma_size;
 
-/* Allocate gamma ramps */
-ramps.  red = malloc(n * sizeof(TYPE));
-ramps.green = &ramps.  red[ramps.  red_size];
-ramps. blue = &ramps.green[ramps.green_size];
+/* Allocate gamma ramps, unless the buffer from the last call is large enough */
+ramps.  red = libgamma_internal_ramps_buffer(this, n * sizeof(TYPE));
 if (!ramps.red)
 	return LIBGAMMA_ERRNO_SET;
+ramps.green = &ramps.  red[ramps.  red_size];
+ramps. blue = &ramps.green[ramps.green_size];
 
 /* Generate the gamma ramp for the red channel */
 for (i = 0, n = ramps.red_size; i < n; i++)
@@ -44,7 +38,10 @@ for (i = 0, n = ramps.green_size; i < n; i++)
 for (i = 0, n = ramps.blue_size; i < n; i++)
 	ramps.blue[i] = blue_function((float)i / (float)(n - 1));
 
-/* Apply the gamma ramps */
+/* Apply the gamma ramps, and if that fails, the cached
+ * gamma ramp sizes may be stale (the error could be
+ * `LIBGAMMA_GAMMA_RAMP_SIZE_CHANGED`), so forget them */
 e = APPEND_RAMPS(libgamma_crtc_set_gamma_)(this, &ramps);
-free(ramps.red);
+if (e)
+	libgamma_crtc_invalidate_cache(this);
 return e;
@@ -0,0 +1,82 @@
+/* See LICENSE file for copyright and license details. */
+
+/*
+ * This file is intended to be included from
+ * libgamma_crtc_set_gamma_ramps{8,16,32,64,f,d}_fb
+ */
+
+
+struct APPEND_RAMPS(libgamma_gamma_) ramps;
+ENCODING *encodings;
+size_t i, n, max, offset, encodings_size = 0;
+int e;
+
+/* Get the size of the gamma ramps, unless it is cached */
+if ((e = libgamma_internal_cache_gamma_sizes(this)))
+	return e;
+
+/* Copy the size of the gamma ramps and calculate the grand size and the largest size */
+n  = max = ramps.  red_size = this->cached_red_gamma_size;
+n += ramps.green_size = this->cached_green_gamma_size;
+n += ramps. blue_size = this->cached_blue_gamma_size;
+if (max < ramps.green_size)
+	max = ramps.green_size;
+if (max < ramps.blue_size)
+	max = ramps.blue_size;
+
+/* Allocate gamma ramps, followed by the encoding values, unless the
+ * buffer from the last call is large enough; the encoding values are
+ * aligned to their own size, which is all the alignment they need */
+offset = n * sizeof(TYPE);
+offset = (offset + sizeof(ENCODING) - 1) / sizeof(ENCODING) * sizeof(ENCODING);
+ramps.  red = libgamma_internal_ramps_buffer(this, offset + max * sizeof(ENCODING));
+if (!ramps.red)
+	return LIBGAMMA_ERRNO_SET;
+ramps.green = &ramps.  red[ramps.  red_size];
+ramps. blue = &ramps.green[ramps.green_size];
+encodings = (void *)&((char *)ramps.red)[offset];
+
+/* Generate the gamma ramp for a channel, but first calculate the encoding
+ * values, unless they were already calculated for a channel of the same size */
+#define GENERATE(FUNCTION, CHANNEL)\
+	do {\
+		if (encodings_size != ramps.CHANNEL##_size) {\
+			encodings_size = ramps.CHANNEL##_size;\
+			for (i = 0; i < encodings_size; i++)\
+				encodings[i] = (ENCODING)i / (ENCODING)(encodings_size - 1);\
+		}\
+		(FUNCTION)(ramps.CHANNEL##_size, encodings, ramps.CHANNEL);\
+	} while (0)
+
+/* Generate the gamma ramp for the red channel */
+GENERATE(red_function, red);
+
+/* Generate the gamma ramp for the green channel, or copy
+ * the red gamma ramp if the green channel uses the same
+ * function and is of the same size */
+if (green_function)
+	GENERATE(green_function, green);
+else if (ramps.green_size == ramps.red_size)
+	memcpy(ramps.green, ramps.red, ramps.red_size * sizeof(TYPE));
+else
+	GENERATE(red_function, green);
+
+/* Generate the gamma ramp for the blue channel, or copy
+ * the red gamma ramp if the blue channel uses the same
+ * function and is of the same size */
+if (blue_function)
+	GENERATE(blue_function, blue);
+else if (ramps.blue_size == ramps.red_size)
+	memcpy(ramps.blue, ramps.red, ramps.red_size * sizeof(TYPE));
+else
+	GENERATE(red_function, blue);
+
+#undef GENERATE
+
+/* Apply the gamma ramps, and if that fails, the cached
+ * gamma ramp sizes may be stale (the error could be
+ * `LIBGAMMA_GAMMA_RAMP_SIZE_CHANGED`), so forget them */
+e = APPEND_RAMPS(libgamma_crtc_set_gamma_)(this, &ramps);
+if (e)
+	libgamma_crtc_invalidate_cache(this);
+return e;
@@ -4,6 +4,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -13,6 +14,8 @@
 
 #ifdef __WIN32__
 # define gid_t short
+#else
+# include <poll.h>
 #endif
 
 
@@ -22,6 +25,14 @@
 
 
 
+/* Internal functions (from common.h) used to test gamma ramp translation */
+typedef void translate_fun(size_t, void *restrict, const void *restrict);
+translate_fun *libgamma_internal_scalar_translator(signed, signed);
+translate_fun *libgamma_internal_simd_translator(signed, signed, size_t);
+extern const size_t libgamma_internal_simd_kernel_sets;
+
+
+
 /**
  * X macro of all integer gamma ramps
  * 
@@ -69,6 +80,22 @@ inv_ramps16(float encoding)
 }
 
 
+/**
+ * Batch invertion mapping function from [0, 1] float encoding values to [0, 2¹⁶ − 1] integer output values
+ * 
+ * @param  n          The number of stops to generate
+ * @param  encodings  [0, 1] float encoding values, `n` elements
+ * @param  output     Output parameter for the [0, 2¹⁶ − 1] integer output values, `n` elements
+ */
+static void
+inv_ramps16_batch(size_t n, const float *restrict encodings, uint16_t *restrict output)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		output[i] = inv_ramps16(encodings[i]);
+}
+
+
 /**
  * Test mapping function from [0, 1] float encoding value to [0, 2⁸ − 1] integer output value
  * 
@@ -653,6 +680,48 @@ crtc_information(struct libgamma_crtc_state *restrict crtc)
 }
 
 
+/**
+ * Test configuration change notifications for a site
+ * 
+ * @param   site  The site
+ * @return        Non-zero on failure
+ */
+static int
+configuration_events(struct libgamma_site_state *restrict site)
+{
+	int r, fd;
+
+	r = libgamma_site_get_event_fd(site, &fd);
+	if (r == LIBGAMMA_ERRNO_SET && errno == ENOTSUP) {
+		if (fd != -1) {
+			fprintf(stderr, "libgamma_site_get_event_fd did not set the file descriptor to -1 on failure\n");
+			return 1;
+		}
+		r = libgamma_site_process_events(site);
+		if (r != LIBGAMMA_ERRNO_SET || errno != ENOTSUP) {
+			fprintf(stderr, "libgamma_site_process_events did not fail with ENOTSUP\n");
+			return 1;
+		}
+		printf("Configuration change notifications: not supported\n\n");
+		return 0;
+	} else if (r) {
+		libgamma_perror("libgamma_site_get_event_fd", r);
+		return 1;
+	} else if (site->method == LIBGAMMA_METHOD_DUMMY) {
+		fprintf(stderr, "libgamma_site_get_event_fd did not fail with ENOTSUP for the dummy method\n");
+		return 1;
+	}
+
+	r = libgamma_site_process_events(site);
+	if (r < 0) {
+		libgamma_perror("libgamma_site_process_events", r);
+		return 1;
+	}
+	printf("Configuration change notifications: file descriptor %i, %s\n\n", fd, r ? "changed" : "unchanged");
+	return 0;
+}
+
+
 /**
  * Test that count macros are set to the same values as the count variables
  */
@@ -1395,12 +1464,488 @@ test_errors(void)
 }
 
 
+/**
+ * Test that the SIMD translators between gamma ramp
+ * depths are bit-exact with the scalar translators
+ */
+static void
+test_translations(void)
+{
+	static const signed depths[] = {8, 16, 32, 64, -1, -2};
+	/* Beyond ±2⁶³ the scalar conversion to 64-bit integers is undefined */
+	static const float special_floats[] = {0.f, -0.f, 1.f, -1.f, 0.5f, 2.f, 1e-45f, 1e-30f, 1e18f, -1e18f, 0x1p62f};
+	static const double special_doubles[] = {0., -0., 1., -1., 0.5, 2., 5e-324, 1e-300, 1e18, -1e18, 0x1p62};
+	/* Odd size so that the scalar tail of the SIMD translators is tested too */
+	const size_t n = 3 * 65536 + 37;
+	uint8_t *in = malloc(n * 8), *expected = malloc(n * 8), *got = malloc(n * 8);
+	translate_fun *simd;
+	uint64_t x = 1;
+	size_t i, j, k, set, size;
+
+	if (!in || !expected || !got) {
+		perror("malloc");
+		exit(1);
+	}
+
+	for (i = 0; i < sizeof(depths) / sizeof(*depths); i++) {
+		/* Fill input with every value for low depths, plausible and
+		 * special values for floating point, and otherwise random values */
+		for (k = 0; k < n; k++) {
+			x = x * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+			switch (depths[i]) {
+			case  8: in[k] = (uint8_t)k; break;
+			case 16: ((uint16_t *)in)[k] = (uint16_t)k; break;
+			case 32: ((uint32_t *)in)[k] = (uint32_t)(x >> 32); break;
+			case 64: ((uint64_t *)in)[k] = x; break;
+			case -1:
+				if (k % 3 == 0)
+					((float *)in)[k] = (float)(k / 3) / 65535.f;
+				else if (k % 3 == 1)
+					((float *)in)[k] = (float)(x >> 40) / (float)(UINT64_C(1) << 24) * 1.25f - 0.125f;
+				else
+					((float *)in)[k] = special_floats[k / 3 % (sizeof(special_floats) / sizeof(*special_floats))];
+				break;
+			default:
+				if (k % 3 == 0)
+					((double *)in)[k] = (double)(k / 3) / 65535.;
+				else if (k % 3 == 1)
+					((double *)in)[k] = (double)(x >> 11) / (double)(UINT64_C(1) << 53) * 1.25 - 0.125;
+				else
+					((double *)in)[k] = special_doubles[k / 3 % (sizeof(special_doubles) / sizeof(*special_doubles))];
+				break;
+			}
+		}
+		for (j = 0; j < sizeof(depths) / sizeof(*depths); j++) {
+			size = depths[j] > 0 ? (size_t)depths[j] / 8 : depths[j] == -1 ? sizeof(float) : sizeof(double);
+			libgamma_internal_scalar_translator(depths[j], depths[i])(n, expected, in);
+			for (set = 0; set < libgamma_internal_simd_kernel_sets; set++) {
+				simd = libgamma_internal_simd_translator(depths[j], depths[i], set);
+				if (!simd)
+					continue;
+				memset(got, 0, n * 8);
+				simd(n, got, in);
+				if (memcmp(got, expected, n * size)) {
+					fprintf(stderr, "SIMD translation from depth %i to depth %i (kernel set %zu) is not bit-exact\n",
+					        depths[i], depths[j], set);
+					exit(1);
+				}
+			}
+		}
+	}
+
+	free(in);
+	free(expected);
+	free(got);
+}
+
+
+/**
+ * Test that runtime statistics are collected
+ * for the dummy adjustment method
+ */
+static void
+test_stats(void)
+{
+	struct libgamma_site_state site;
+	struct libgamma_partition_state partition;
+	struct libgamma_crtc_state crtc;
+	struct libgamma_crtc_information info;
+	struct libgamma_gamma_ramps16 ramps;
+	struct libgamma_stats stats;
+	struct libgamma_method_stats *dummy = &stats.methods[LIBGAMMA_METHOD_DUMMY];
+	uint64_t count;
+	size_t i, j;
+
+	if (!libgamma_is_method_available(LIBGAMMA_METHOD_DUMMY))
+		return;
+
+	if (libgamma_stats_enable(1)) {
+		fprintf(stderr, "Runtime statistics were enabled by default\n");
+		exit(1);
+	}
+	libgamma_stats_reset();
+
+	if (libgamma_site_initialise(&site, LIBGAMMA_METHOD_DUMMY, NULL) ||
+	    libgamma_partition_initialise(&partition, &site, 0) ||
+	    libgamma_crtc_initialise(&crtc, &partition, 0)) {
+		fprintf(stderr, "Failed to initialise the dummy adjustment method\n");
+		exit(1);
+	}
+	libgamma_get_crtc_information(&info, sizeof(info), &crtc, LIBGAMMA_CRTC_INFO_GAMMA_SIZE);
+	ramps.red_size   = info.  red_gamma_size;
+	ramps.green_size = info.green_gamma_size;
+	ramps.blue_size  = info. blue_gamma_size;
+	libgamma_crtc_information_destroy(&info);
+	if (libgamma_gamma_ramps16_initialise(&ramps)) {
+		perror("libgamma_gamma_ramps16_initialise");
+		exit(1);
+	}
+	if (libgamma_crtc_get_gamma_ramps16(&crtc, &ramps) || libgamma_crtc_set_gamma_ramps16(&crtc, &ramps)) {
+		fprintf(stderr, "Failed to use the dummy adjustment method\n");
+		exit(1);
+	}
+	libgamma_gamma_ramps16_destroy(&ramps);
+	libgamma_crtc_destroy(&crtc);
+
+	libgamma_stats_get(&stats, sizeof(stats));
+	if (dummy->operations[LIBGAMMA_STATS_INITIALISE].calls != 3 ||
+	    dummy->operations[LIBGAMMA_STATS_GET_INFORMATION].calls != 1 ||
+	    dummy->operations[LIBGAMMA_STATS_GET_GAMMA].calls != 1 ||
+	    dummy->operations[LIBGAMMA_STATS_SET_GAMMA].calls != 1) {
+		fprintf(stderr, "Runtime statistics did not count all calls\n");
+		exit(1);
+	}
+	for (i = 0; i < LIBGAMMA_STATS_OPERATION_COUNT; i++) {
+		count = 0;
+		for (j = 0; j < LIBGAMMA_STATS_LATENCY_BUCKETS; j++)
+			count += dummy->operations[i].latency_histogram[j];
+		if (count != dummy->operations[i].calls || dummy->operations[i].errors) {
+			fprintf(stderr, "Runtime statistics have an inconsistent latency histogram\n");
+			exit(1);
+		}
+	}
+	if (info.gamma_depth != 16 && (!dummy->translated_bytes || !dummy->allocations)) {
+		fprintf(stderr, "Runtime statistics did not count gamma ramp translations\n");
+		exit(1);
+	}
+
+	/* A smaller structure, as from an older version of the library, is filled partially */
+	memset(&stats, 0xFF, sizeof(stats));
+	libgamma_stats_get(&stats, offsetof(struct libgamma_stats, methods[1]));
+	if (stats.methods[LIBGAMMA_METHOD_COUNT - 1].operations[0].calls != UINT64_MAX) {
+		fprintf(stderr, "libgamma_stats_get wrote beyond the end of the structure\n");
+		exit(1);
+	}
+
+	libgamma_stats_reset();
+	libgamma_stats_get(&stats, sizeof(stats));
+	if (dummy->operations[LIBGAMMA_STATS_INITIALISE].calls || dummy->translated_bytes || dummy->allocations) {
+		fprintf(stderr, "libgamma_stats_reset did not reset the runtime statistics\n");
+		exit(1);
+	}
+
+	if (!libgamma_stats_enable(0)) {
+		fprintf(stderr, "libgamma_stats_enable did not return the previous setting\n");
+		exit(1);
+	}
+	if (libgamma_crtc_initialise(&crtc, &partition, 0)) {
+		fprintf(stderr, "Failed to use the dummy adjustment method\n");
+		exit(1);
+	}
+	libgamma_crtc_destroy(&crtc);
+	libgamma_stats_get(&stats, sizeof(stats));
+	if (dummy->operations[LIBGAMMA_STATS_INITIALISE].calls) {
+		fprintf(stderr, "Runtime statistics were collected while disabled\n");
+		exit(1);
+	}
+
+	libgamma_partition_destroy(&partition);
+	libgamma_site_destroy(&site);
+}
+
+
+/**
+ * Test that `libgamma_site_restore` makes the library forget
+ * which gamma ramps were applied, so that writing the same
+ * gamma ramps again is not skipped, with the dummy adjustment
+ * method
+ */
+static void
+test_site_restore(void)
+{
+	struct libgamma_site_state site;
+	struct libgamma_partition_state partition;
+	struct libgamma_crtc_state crtc;
+	struct libgamma_crtc_information info;
+	struct libgamma_gamma_ramps16 ramps;
+	struct libgamma_stats stats;
+	struct libgamma_operation_stats *set = &stats.methods[LIBGAMMA_METHOD_DUMMY].operations[LIBGAMMA_STATS_SET_GAMMA];
+	int enabled;
+
+	if (!libgamma_is_method_available(LIBGAMMA_METHOD_DUMMY))
+		return;
+
+	if (libgamma_site_initialise(&site, LIBGAMMA_METHOD_DUMMY, NULL) ||
+	    libgamma_partition_initialise(&partition, &site, 0) ||
+	    libgamma_crtc_initialise(&crtc, &partition, 0)) {
+		fprintf(stderr, "Failed to initialise the dummy adjustment method\n");
+		exit(1);
+	}
+	libgamma_get_crtc_information(&info, sizeof(info), &crtc, LIBGAMMA_CRTC_INFO_GAMMA_SIZE);
+	ramps.red_size   = info.  red_gamma_size;
+	ramps.green_size = info.green_gamma_size;
+	ramps.blue_size  = info. blue_gamma_size;
+	libgamma_crtc_information_destroy(&info);
+	if (libgamma_gamma_ramps16_initialise(&ramps)) {
+		perror("libgamma_gamma_ramps16_initialise");
+		exit(1);
+	}
+
+	/* Count the writes that reach the adjustment method */
+	enabled = libgamma_stats_enable(1);
+	libgamma_stats_reset();
+	crtc.deduplicate_writes = 1;
+	if (libgamma_crtc_set_gamma_ramps16(&crtc, &ramps) ||
+	    libgamma_site_restore(&site) ||
+	    libgamma_crtc_set_gamma_ramps16(&crtc, &ramps)) {
+		fprintf(stderr, "Failed to use the dummy adjustment method\n");
+		exit(1);
+	}
+	libgamma_stats_get(&stats, sizeof(stats));
+	if (set->calls != 2) {
+		fprintf(stderr, "libgamma_crtc_set_gamma_ramps16 skipped a write after libgamma_site_restore\n");
+		exit(1);
+	}
+	libgamma_stats_reset();
+	libgamma_stats_enable(enabled);
+
+	libgamma_gamma_ramps16_destroy(&ramps);
+	libgamma_crtc_destroy(&crtc);
+	libgamma_partition_destroy(&partition);
+	libgamma_site_destroy(&site);
+}
+
+
+/**
+ * Test that gamma ramps generated from parameters have the expected values
+ */
+static void
+test_parametric(void)
+{
+	struct libgamma_gamma_ramp_parameters params;
+	struct libgamma_gamma_ramps8 ramps8;
+	struct libgamma_gamma_ramps16 ramps16;
+	size_t i;
+
+	ramps8.red_size = ramps8.green_size = ramps8.blue_size = 256;
+	ramps16.red_size = ramps16.green_size = ramps16.blue_size = 256;
+	if (libgamma_gamma_ramps8_initialise(&ramps8) || libgamma_gamma_ramps16_initialise(&ramps16)) {
+		perror("libgamma_gamma_ramps*_initialise");
+		exit(1);
+	}
+
+	/* The identity, also with a neutral whitepoint */
+	libgamma_gamma_ramp_parameters_initialise(&params);
+	for (params.temperature = 0; params.temperature <= 6500; params.temperature += 6500) {
+		if (libgamma_gamma_ramps8_generate(&ramps8, &params) || libgamma_gamma_ramps16_generate(&ramps16, &params)) {
+			fprintf(stderr, "libgamma_gamma_ramps*_generate failed for the identity\n");
+			exit(1);
+		}
+		for (i = 0; i < 3 * 256; i++) {
+			if (ramps8.red[i] != (uint8_t)(i % 256) || ramps16.red[i] != (uint16_t)(i % 256 * 257)) {
+				fprintf(stderr, "libgamma_gamma_ramps*_generate did not generate the identity\n");
+				exit(1);
+			}
+		}
+	}
+
+	/* Half brightness, full contrast, and inverted gamma cancelling squared contrast */
+	libgamma_gamma_ramp_parameters_initialise(&params);
+	params.red_max = 0.5;
+	params.green_contrast = 0;
+	params.blue_gamma = 0.5;
+	if (libgamma_gamma_ramps16_generate(&ramps16, &params)) {
+		fprintf(stderr, "libgamma_gamma_ramps16_generate failed\n");
+		exit(1);
+	}
+	if (ramps16.red[0] != 0 || ramps16.red[255] != UINT16_MAX / 2 + 1 ||
+	    ramps16.green[0] != UINT16_MAX / 2 + 1 || ramps16.green[255] != UINT16_MAX / 2 + 1 ||
+	    ramps16.blue[0] != 0 || ramps16.blue[255] != UINT16_MAX || ramps16.blue[128] >= ramps16.red[255]) {
+		fprintf(stderr, "libgamma_gamma_ramps16_generate generated unexpected values\n");
+		exit(1);
+	}
+
+	/* A warm whitepoint dims blue more than green, and does not dim red */
+	libgamma_gamma_ramp_parameters_initialise(&params);
+	params.temperature = 3000;
+	if (libgamma_gamma_ramps16_generate(&ramps16, &params)) {
+		fprintf(stderr, "libgamma_gamma_ramps16_generate failed\n");
+		exit(1);
+	}
+	if (ramps16.red[255] != UINT16_MAX || !(ramps16.green[255] < ramps16.red[255]) ||
+	    !(ramps16.blue[255] < ramps16.green[255])) {
+		fprintf(stderr, "libgamma_gamma_ramps16_generate generated unexpected whitepoint\n");
+		exit(1);
+	}
+
+	/* Invalid parameters */
+	libgamma_gamma_ramp_parameters_initialise(&params);
+	params.green_gamma = 0;
+	errno = 0;
+	if (libgamma_gamma_ramps16_generate(&ramps16, &params) != LIBGAMMA_ERRNO_SET || errno != EINVAL) {
+		fprintf(stderr, "libgamma_gamma_ramps16_generate accepted invalid parameters\n");
+		exit(1);
+	}
+
+	libgamma_gamma_ramps8_destroy(&ramps8);
+	libgamma_gamma_ramps16_destroy(&ramps16);
+}
+
+
 /**
  * Test libgamma
  * 
  * @return  Non-zero on machine detectable error, this library
  *          may still be faulty if zero is returned
  */
+/**
+ * The requests used by `test_request_queue`
+ */
+static struct libgamma_crtc_request test_request_queue_requests[4];
+
+
+/**
+ * Callback function for asynchronous gamma ramp requests,
+ * that records the order in which the requests complete
+ * 
+ * @param  request  The request
+ * @param  result   The result of the request
+ * @param  user     Pointer to a `char *` to append a letter to,
+ *                  the letter is the request's index in the
+ *                  array of requests it is taken from
+ */
+static void
+request_order(struct libgamma_crtc_request *request, int result, void *user)
+{
+	char **order = user;
+	(void) result;
+	*(*order)++ = (char)('a' + (request - test_request_queue_requests));
+}
+
+
+/**
+ * Test that asynchronous gamma ramp requests are
+ * dispatched in order, also after one has been
+ * discarded, with the dummy adjustment method
+ */
+static void
+test_request_queue(void)
+{
+	struct libgamma_site_state site;
+	struct libgamma_partition_state partition;
+	struct libgamma_crtc_state crtc;
+	struct libgamma_crtc_request *requests = test_request_queue_requests;
+	struct libgamma_crtc_information info;
+	struct libgamma_gamma_ramps16 ramps;
+	char order[5], *p = order;
+
+	if (!libgamma_is_method_available(LIBGAMMA_METHOD_DUMMY))
+		return;
+
+	if (libgamma_site_initialise(&site, LIBGAMMA_METHOD_DUMMY, NULL) ||
+	    libgamma_partition_initialise(&partition, &site, 0) ||
+	    libgamma_crtc_initialise(&crtc, &partition, 0)) {
+		fprintf(stderr, "Failed to initialise the dummy adjustment method\n");
+		exit(1);
+	}
+	libgamma_get_crtc_information(&info, sizeof(info), &crtc, LIBGAMMA_CRTC_INFO_GAMMA_SIZE);
+	ramps.red_size   = info.  red_gamma_size;
+	ramps.green_size = info.green_gamma_size;
+	ramps.blue_size  = info. blue_gamma_size;
+	libgamma_crtc_information_destroy(&info);
+	if (libgamma_gamma_ramps16_initialise(&ramps)) {
+		perror("libgamma_gamma_ramps16_initialise");
+		exit(1);
+	}
+
+	/* Discarding the last request must leave the queue appendable */
+	if (libgamma_crtc_set_gamma_ramps16_async(&requests[0], &crtc, &ramps, request_order, &p) ||
+	    libgamma_crtc_set_gamma_ramps16_async(&requests[1], &crtc, &ramps, request_order, &p) ||
+	    libgamma_crtc_set_gamma_ramps16_async(&requests[2], &crtc, &ramps, request_order, &p)) {
+		fprintf(stderr, "Failed to submit asynchronous gamma ramp requests\n");
+		exit(1);
+	}
+	libgamma_crtc_discard_request(&requests[2]);
+	if (libgamma_crtc_set_gamma_ramps16_async(&requests[3], &crtc, &ramps, request_order, &p)) {
+		fprintf(stderr, "Failed to submit asynchronous gamma ramp requests\n");
+		exit(1);
+	}
+	while (libgamma_site_dispatch_requests(&site));
+	*p = '\0';
+	if (strcmp(order, "abd")) {
+		fprintf(stderr, "Asynchronous gamma ramp requests were dispatched as %s rather than abd\n", order);
+		exit(1);
+	}
+
+	libgamma_gamma_ramps16_destroy(&ramps);
+	libgamma_crtc_destroy(&crtc);
+	libgamma_partition_destroy(&partition);
+	libgamma_site_destroy(&site);
+}
+
+
+/**
+ * Callback function for asynchronous gamma ramp requests,
+ * that stores the result of the request
+ * 
+ * @param  request  The request
+ * @param  result   The result of the request
+ * @param  user     Pointer to an `int` to store `result` in
+ */
+static void
+request_completed(struct libgamma_crtc_request *request, int result, void *user)
+{
+	(void) request;
+	*(int *)user = result;
+}
+
+
+/**
+ * Wait for a gamma ramp request to complete
+ * 
+ * @param   request  The request
+ * @return           The return value of `libgamma_crtc_complete_request`
+ */
+static int
+await_request(struct libgamma_crtc_request *restrict request)
+{
+#ifndef __WIN32__
+	struct pollfd pfd;
+#endif
+	int r;
+	while ((r = libgamma_crtc_complete_request(request)) == LIBGAMMA_ERRNO_SET && errno == EAGAIN) {
+#ifndef __WIN32__
+		if ((r = libgamma_partition_get_fd(request->crtc->partition, &pfd.fd))) {
+			libgamma_crtc_discard_request(request);
+			return r;
+		}
+		pfd.events = POLLIN;
+		poll(&pfd, 1, -1);
+#endif
+	}
+	return r;
+}
+
+
+/**
+ * Run a transition until it finishes
+ * 
+ * @param   transition  The transition
+ * @return              The return value of the last call
+ *                      to `libgamma_transition_step`
+ */
+static int
+run_transition(struct libgamma_transition *restrict transition)
+{
+#ifndef __WIN32__
+	struct pollfd pfd;
+#endif
+	unsigned long int delay;
+	int r;
+#ifndef __WIN32__
+	if (libgamma_transition_get_fd(transition, &pfd.fd))
+		pfd.fd = -1;
+	pfd.events = POLLIN;
+#endif
+	while ((r = libgamma_transition_step(transition, &delay)) > 0) {
+#ifndef __WIN32__
+		poll(&pfd, 1, pfd.fd < 0 ? (int)delay : -1);
+#endif
+	}
+	return r;
+}
+
+
 int
 main(void)
 {
@@ -1408,19 +1953,33 @@ main(void)
 	struct libgamma_partition_state *part_state = malloc(sizeof(*part_state));
 	struct libgamma_crtc_state      *crtc_state = malloc(sizeof(*crtc_state));
 	struct libgamma_crtc_information info;
+	struct libgamma_prepared_ramps prepared, old_prepared;
+	struct libgamma_gamma_ramp_parameters params;
+	struct libgamma_gamma_ramps16_interleaved interleaved;
+	struct libgamma_crtc_request request;
+	struct libgamma_transaction transaction;
+	struct libgamma_transition transition;
+#ifndef __WIN32__
+	struct pollfd pfd;
+#endif
 #define X(RAMPS)\
 	struct libgamma_gamma_##RAMPS old_##RAMPS, RAMPS;\
 	libgamma_gamma_##RAMPS##_fun *f_##RAMPS = dim_##RAMPS;
 	LIST_RAMPS(X)
 #undef X
 	size_t i, n;
-	int r, rr = 0;
+	int r, rr = 0, result;
 
 	/* Test miscellaneous parts of the library */
 	test_count_consts();
 	test_connector_types();
 	test_subpixel_orders();
 	test_errors();
+	test_translations();
+	test_parametric();
+	test_stats();
+	test_site_restore();
+	test_request_queue();
 	list_methods_lists();
 	method_availability();
 	list_default_sites();
@@ -1433,6 +1992,9 @@ main(void)
 	/* Test CRTC information functions */
 	crtc_information(crtc_state);
 
+	/* Test configuration change notifications */
+	rr |= configuration_events(site_state);
+
 	/* Get the sizes of the gamma ramps for the selected CRTC */
 	libgamma_get_crtc_information(&info, sizeof(info), crtc_state, LIBGAMMA_CRTC_INFO_GAMMA_SIZE);
 
@@ -1547,6 +2109,327 @@ main(void)
 	printf("Done!\n");
 	sleep(1);
 
+	/* Test batch function assisted gamma ramps setting, with the same function for all channels */
+	printf("Inverting monitor output for 1 second... (does not work properly on all devices) (ramps16, batch)\n");
+	if ((rr |= r = libgamma_crtc_set_gamma_ramps16_fb(crtc_state, inv_ramps16_batch, NULL, NULL))) {
+		libgamma_perror("libgamma_crtc_set_gamma_ramps16_fb", r);
+	} else if ((rr |= r = libgamma_crtc_get_gamma_ramps16(crtc_state, &ramps16))) {
+		libgamma_perror("libgamma_crtc_get_gamma_ramps16", r);
+	} else {
+#define X(C)\
+		for (i = 0; i < ramps16.C##_size; i++)\
+			if (ramps16.C[i] != inv_ramps16((float)i / (float)(ramps16.C##_size - 1)))\
+				break;\
+		if (i < ramps16.C##_size) {\
+			printf("Batch function generated " #C " gamma ramp differs from per-stop function\n");\
+			rr |= 1;\
+		}
+		X(red)
+		X(green)
+		X(blue)
+#undef X
+	}
+	sleep(1);
+	if ((rr |= r = libgamma_crtc_set_gamma_ramps16(crtc_state, &old_ramps16)))
+		libgamma_perror("libgamma_crtc_set_gamma_ramps16", r);
+	printf("Done!\n");
+	sleep(1);
+
+	/* Test deferred gamma ramp updates */
+	printf("Dimming monitor for 1 second... (deferred)\n");
+	if ((rr |= r = libgamma_partition_defer_updates(part_state)))
+		libgamma_perror("libgamma_partition_defer_updates", r);
+	if ((rr |= r = libgamma_crtc_set_gamma_ramps16_f(crtc_state, dim_ramps16, dim_ramps16, dim_ramps16)))
+		libgamma_perror("libgamma_crtc_set_gamma_ramps16_f", r);
+	if ((rr |= r = libgamma_partition_commit_updates(part_state)))
+		libgamma_perror("libgamma_partition_commit_updates", r);
+	sleep(1);
+	if ((rr |= r = libgamma_crtc_set_gamma_ramps16(crtc_state, &old_ramps16)))
+		libgamma_perror("libgamma_crtc_set_gamma_ramps16", r);
+	printf("Done!\n");
+	sleep(1);
+
+	/* Test parametric gamma ramps */
+	libgamma_gamma_ramp_parameters_initialise(&params);
+	params.red_max = params.green_max = params.blue_max = 0.5;
+	params.temperature = 4500;
+	printf("Dimming and warming monitor for 1 second... (parametric)\n");
+	if ((rr |= r = libgamma_crtc_set_gamma_parametric(crtc_state, &params)))
+		libgamma_perror("libgamma_crtc_set_gamma_parametric", r);
+	sleep(1);
+	if ((rr |= r = libgamma_crtc_set_gamma_ramps16(crtc_state, &old_ramps16)))
+		libgamma_perror("libgamma_crtc_set_gamma_ramps16", r);
+	printf("Done!\n");
+	sleep(1);
+
+	/* Test interleaved gamma ramps */
+	if (old_ramps16.red_size == old_ramps16.green_size && old_ramps16.red_size == old_ramps16.blue_size) {
+		interleaved.size = old_ramps16.red_size;
+		interleaved.stops = malloc(interleaved.size * sizeof(*interleaved.stops));
+		if (!interleaved.stops) {
+			perror("malloc");
+			rr |= 1;
+			goto done;
+		}
+		for (i = 0; i < interleaved.size; i++) {
+			interleaved.stops[i].red      = old_ramps16.  red[i] / 2;
+			interleaved.stops[i].green    = old_ramps16.green[i] / 2;
+			interleaved.stops[i].blue     = old_ramps16. blue[i] / 2;
+			interleaved.stops[i].reserved = 0;
+		}
+		printf("Dimming monitor for 1 second... (interleaved)\n");
+		if ((rr |= r = libgamma_crtc_set_gamma_ramps16_interleaved(crtc_state, &interleaved))) {
+			libgamma_perror("libgamma_crtc_set_gamma_ramps16_interleaved", r);
+		} else if ((rr |= r = libgamma_crtc_get_gamma_ramps16(crtc_state, &ramps16))) {
+			libgamma_perror("libgamma_crtc_get_gamma_ramps16", r);
+		} else {
+			for (i = 0; i < interleaved.size; i++)
+				if (ramps16.  red[i] != interleaved.stops[i].red   ||
+				    ramps16.green[i] != interleaved.stops[i].green ||
+				    ramps16. blue[i] != interleaved.stops[i].blue)
+					break;
+			if (i < interleaved.size) {
+				printf("Interleaved gamma ramps were not applied exactly\n");
+				rr |= 1;
+			}
+		}
+		sleep(1);
+		if ((rr |= r = libgamma_crtc_set_gamma_ramps16(crtc_state, &old_ramps16))) {
+			libgamma_perror("libgamma_crtc_set_gamma_ramps16", r);
+		} else if ((rr |= r = libgamma_crtc_get_gamma_ramps16_interleaved(crtc_state, &interleaved))) {
+			libgamma_perror("libgamma_crtc_get_gamma_ramps16_interleaved", r);
+		} else {
+			for (i = 0; i < interleaved.size; i++)
+				if (interleaved.stops[i].red   != old_ramps16.  red[i] ||
+				    interleaved.stops[i].green != old_ramps16.green[i] ||
+				    interleaved.stops[i].blue  != old_ramps16. blue[i])
+					break;
+			if (i < interleaved.size) {
+				printf("Interleaved gamma ramps were not read exactly\n");
+				rr |= 1;
+			}
+		}
+		free(interleaved.stops);
+		printf("Done!\n");
+		sleep(1);
+	}
+
+	/* Test non-blocking gamma ramp requests */
+	for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+		ramps16.red[i] = old_ramps16.red[i] / 2;
+	printf("Dimming monitor for 1 second... (non-blocking)\n");
+	if ((rr |= r = libgamma_crtc_submit_set_gamma_ramps16(&request, crtc_state, &ramps16)))
+		libgamma_perror("libgamma_crtc_submit_set_gamma_ramps16", r);
+	else if ((rr |= r = await_request(&request)))
+		libgamma_perror("libgamma_crtc_complete_request", r);
+	sleep(1);
+	if ((rr |= r = libgamma_crtc_submit_set_gamma_ramps16(&request, crtc_state, &old_ramps16)))
+		libgamma_perror("libgamma_crtc_submit_set_gamma_ramps16", r);
+	else if ((rr |= r = await_request(&request)))
+		libgamma_perror("libgamma_crtc_complete_request", r);
+	if ((rr |= r = libgamma_crtc_submit_get_gamma_ramps16(&request, crtc_state, &ramps16))) {
+		libgamma_perror("libgamma_crtc_submit_get_gamma_ramps16", r);
+	} else if ((rr |= r = await_request(&request))) {
+		libgamma_perror("libgamma_crtc_complete_request", r);
+	} else {
+		for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+			if (ramps16.red[i] != old_ramps16.red[i])
+				break;
+		if (i < ramps16.red_size + ramps16.green_size + ramps16.blue_size) {
+			fprintf(stderr, "libgamma_crtc_submit_get_gamma_ramps16 did not return the applied gamma ramps\n");
+			rr |= 1;
+		}
+	}
+	printf("Done!\n");
+	sleep(1);
+
+	/* Test asynchronous gamma ramp requests */
+	for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+		ramps16.red[i] = (uint16_t)~old_ramps16.red[i];
+	result = 1;
+	if ((rr |= r = libgamma_crtc_get_gamma_ramps16_async(&request, crtc_state, &ramps16, request_completed, &result))) {
+		libgamma_perror("libgamma_crtc_get_gamma_ramps16_async", r);
+	} else {
+#ifndef __WIN32__
+		if (!libgamma_site_get_request_fd(site_state, &pfd.fd)) {
+			pfd.events = POLLIN;
+			poll(&pfd, 1, -1);
+		}
+#endif
+		while (!libgamma_site_dispatch_requests(site_state));
+		if ((rr |= r = result)) {
+			libgamma_perror("libgamma_crtc_get_gamma_ramps16_async", r);
+		} else {
+			for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+				if (ramps16.red[i] != old_ramps16.red[i])
+					break;
+			if (i < ramps16.red_size + ramps16.green_size + ramps16.blue_size) {
+				fprintf(stderr, "libgamma_crtc_get_gamma_ramps16_async did not return the applied gamma ramps\n");
+				rr |= 1;
+			}
+		}
+	}
+
+	/* Test transactions */
+	libgamma_transaction_initialise(&transaction, site_state);
+	for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+		ramps16.red[i] = old_ramps16.red[i] / 4;
+	if ((rr |= r = libgamma_transaction_set_gamma_ramps16(&transaction, crtc_state, &ramps16)))
+		libgamma_perror("libgamma_transaction_set_gamma_ramps16", r);
+	for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+		ramps16.red[i] = old_ramps16.red[i] / 2;
+	if ((rr |= r = libgamma_transaction_set_gamma_ramps16(&transaction, crtc_state, &ramps16)))
+		libgamma_perror("libgamma_transaction_set_gamma_ramps16", r);
+	if (transaction.count != 1) {
+		fprintf(stderr, "libgamma_transaction_set_gamma_ramps16 did not replace the staged gamma ramps\n");
+		rr |= 1;
+	}
+	printf("Dimming monitor for 1 second... (transaction)\n");
+	if ((rr |= r = libgamma_transaction_commit(&transaction))) {
+		libgamma_perror("libgamma_transaction_commit", r);
+	} else if ((rr |= r = libgamma_crtc_get_gamma_ramps16(crtc_state, &ramps16))) {
+		libgamma_perror("libgamma_crtc_get_gamma_ramps16", r);
+	} else {
+		for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+			if (ramps16.red[i] != old_ramps16.red[i] / 2)
+				break;
+		if (i < ramps16.red_size + ramps16.green_size + ramps16.blue_size) {
+			fprintf(stderr, "libgamma_transaction_commit did not apply the staged gamma ramps\n");
+			rr |= 1;
+		}
+	}
+	sleep(1);
+	libgamma_transaction_clear(&transaction);
+	if ((rr |= r = libgamma_transaction_set_gamma_ramps16(&transaction, crtc_state, &old_ramps16)))
+		libgamma_perror("libgamma_transaction_set_gamma_ramps16", r);
+	else if ((rr |= r = libgamma_transaction_commit(&transaction)))
+		libgamma_perror("libgamma_transaction_commit", r);
+	libgamma_transaction_destroy(&transaction);
+	printf("Done!\n");
+	sleep(1);
+
+	/* Test deduplication of writes */
+	crtc_state->deduplicate_writes = 1;
+	for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+		ramps16.red[i] = old_ramps16.red[i] / 2;
+	printf("Dimming monitor for 1 second... (deduplicated)\n");
+	if ((rr |= r = libgamma_crtc_set_gamma_ramps16(crtc_state, &ramps16)))
+		libgamma_perror("libgamma_crtc_set_gamma_ramps16", r);
+	else if ((rr |= r = libgamma_crtc_set_gamma_ramps16(crtc_state, &ramps16)))
+		libgamma_perror("libgamma_crtc_set_gamma_ramps16", r);
+	else if (crtc_state->applied_depth != 16) {
+		fprintf(stderr, "libgamma_crtc_set_gamma_ramps16 did not record the applied gamma ramps\n");
+		rr |= 1;
+	}
+	sleep(1);
+	if ((rr |= r = libgamma_crtc_set_gamma_ramps16(crtc_state, &old_ramps16))) {
+		libgamma_perror("libgamma_crtc_set_gamma_ramps16", r);
+	} else if ((rr |= r = libgamma_crtc_get_gamma_ramps16(crtc_state, &ramps16))) {
+		libgamma_perror("libgamma_crtc_get_gamma_ramps16", r);
+	} else {
+		for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+			if (ramps16.red[i] != old_ramps16.red[i])
+				break;
+		if (i < ramps16.red_size + ramps16.green_size + ramps16.blue_size) {
+			fprintf(stderr, "libgamma_crtc_set_gamma_ramps16 skipped a write of different gamma ramps\n");
+			rr |= 1;
+		}
+	}
+	libgamma_crtc_invalidate_cache(crtc_state);
+	if (crtc_state->applied_depth) {
+		fprintf(stderr, "libgamma_crtc_invalidate_cache did not forget the applied gamma ramps\n");
+		rr |= 1;
+	}
+	crtc_state->deduplicate_writes = 0;
+	printf("Done!\n");
+	sleep(1);
+
+	/* Test caching of reads */
+	crtc_state->cache_reads = 1;
+	for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+		ramps16.red[i] = old_ramps16.red[i] / 2;
+	printf("Dimming monitor for 1 second... (cached)\n");
+	if ((rr |= r = libgamma_crtc_set_gamma_ramps16(crtc_state, &ramps16))) {
+		libgamma_perror("libgamma_crtc_set_gamma_ramps16", r);
+	} else if (crtc_state->read_cache_depth != 16) {
+		fprintf(stderr, "libgamma_crtc_set_gamma_ramps16 did not cache the applied gamma ramps\n");
+		rr |= 1;
+	} else {
+		memset(ramps16.red, 0, (ramps16.red_size + ramps16.green_size + ramps16.blue_size) * sizeof(*ramps16.red));
+		if ((rr |= r = libgamma_crtc_get_gamma_ramps16(crtc_state, &ramps16))) {
+			libgamma_perror("libgamma_crtc_get_gamma_ramps16", r);
+		} else {
+			for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+				if (ramps16.red[i] != old_ramps16.red[i] / 2)
+					break;
+			if (i < ramps16.red_size + ramps16.green_size + ramps16.blue_size) {
+				fprintf(stderr, "libgamma_crtc_get_gamma_ramps16 did not return the cached gamma ramps\n");
+				rr |= 1;
+			}
+		}
+	}
+	sleep(1);
+	if ((rr |= r = libgamma_crtc_set_gamma_ramps16(crtc_state, &old_ramps16)))
+		libgamma_perror("libgamma_crtc_set_gamma_ramps16", r);
+	libgamma_crtc_invalidate_cache(crtc_state);
+	if (crtc_state->read_cache_depth) {
+		fprintf(stderr, "libgamma_crtc_invalidate_cache did not forget the cached gamma ramps\n");
+		rr |= 1;
+	}
+	crtc_state->cache_reads = 0;
+	printf("Done!\n");
+	sleep(1);
+
+	/* Test prepared gamma ramps */
+	for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+		ramps16.red[i] = old_ramps16.red[i] / 2;
+	if ((rr |= r = libgamma_crtc_prepare_gamma_ramps16(crtc_state, &prepared, &ramps16))) {
+		libgamma_perror("libgamma_crtc_prepare_gamma_ramps16", r);
+	} else if ((rr |= r = libgamma_crtc_prepare_gamma_ramps16(crtc_state, &old_prepared, &old_ramps16))) {
+		libgamma_perror("libgamma_crtc_prepare_gamma_ramps16", r);
+		libgamma_prepared_ramps_destroy(&prepared);
+	} else {
+		printf("Dimming monitor for 1 second... (prepared)\n");
+		if ((rr |= r = libgamma_crtc_apply_prepared(crtc_state, &prepared)))
+			libgamma_perror("libgamma_crtc_apply_prepared", r);
+		sleep(1);
+		if ((rr |= r = libgamma_crtc_apply_prepared(crtc_state, &old_prepared)))
+			libgamma_perror("libgamma_crtc_apply_prepared", r);
+		printf("Done!\n");
+		if ((rr |= r = libgamma_crtc_get_gamma_ramps16(crtc_state, &ramps16))) {
+			libgamma_perror("libgamma_crtc_get_gamma_ramps16", r);
+		} else if (memcmp(ramps16.red, old_ramps16.red,
+		                  (ramps16.red_size + ramps16.green_size + ramps16.blue_size) * sizeof(*ramps16.red))) {
+			printf("Prepared gamma ramps were not restored exactly\n");
+			rr |= 1;
+		}
+		printf("Fading monitor for 1 second... (transition)\n");
+		if ((rr |= r = libgamma_transition_initialise(&transition, crtc_state, &old_prepared, &prepared, 1000))) {
+			libgamma_perror("libgamma_transition_initialise", r);
+		} else {
+			if ((rr |= r = run_transition(&transition))) {
+				libgamma_perror("libgamma_transition_step", r);
+			} else if ((rr |= r = libgamma_crtc_get_gamma_ramps16(crtc_state, &ramps16))) {
+				libgamma_perror("libgamma_crtc_get_gamma_ramps16", r);
+			} else {
+				for (i = 0; i < ramps16.red_size + ramps16.green_size + ramps16.blue_size; i++)
+					if (ramps16.red[i] != old_ramps16.red[i] / 2)
+						break;
+				if (i < ramps16.red_size + ramps16.green_size + ramps16.blue_size) {
+					fprintf(stderr, "libgamma_transition_step did not apply the final gamma ramps\n");
+					rr |= 1;
+				}
+			}
+			libgamma_transition_destroy(&transition);
+			if ((rr |= r = libgamma_crtc_apply_prepared(crtc_state, &old_prepared)))
+				libgamma_perror("libgamma_crtc_apply_prepared", r);
+		}
+		printf("Done!\n");
+		libgamma_prepared_ramps_destroy(&prepared);
+		libgamma_prepared_ramps_destroy(&old_prepared);
+		sleep(1);
+	}
+
 	/* TODO Test gamma ramp restore functions */
   
 done:
@@ -0,0 +1,83 @@
+/* See LICENSE file for copyright and license details. */
+
+/*
+ * This file is intended to be included from
+ * libgamma_internal_simd_translator.c, once per
+ * kernel set, with `KERNEL_SET` (the name of the
+ * kernel set), `LANES` (the number of stops to
+ * translate at a time) and optionally `TARGET`
+ * (the instruction set to compile for) defined
+ */
+
+
+#ifdef TARGET
+# define KERNEL_ATTRIBUTES __attribute__((__target__(TARGET)))
+#else
+# define KERNEL_ATTRIBUTES
+#endif
+
+#define KERNEL(OUT, IN, ...)\
+	KERNEL_ATTRIBUTES static void\
+	KERNEL_NAME(OUT, IN, KERNEL_SET)(size_t n, void *restrict out_, const void *restrict in_)\
+	{\
+		typedef uint8_t  vu8  __attribute__((__vector_size__(LANES * sizeof(uint8_t)),  __unused__));\
+		typedef uint16_t vu16 __attribute__((__vector_size__(LANES * sizeof(uint16_t)), __unused__));\
+		typedef uint32_t vu32 __attribute__((__vector_size__(LANES * sizeof(uint32_t)), __unused__));\
+		typedef uint64_t vu64 __attribute__((__vector_size__(LANES * sizeof(uint64_t)), __unused__));\
+		typedef int32_t  vi32 __attribute__((__vector_size__(LANES * sizeof(int32_t)),  __unused__));\
+		typedef int64_t  vi64 __attribute__((__vector_size__(LANES * sizeof(int64_t)),  __unused__));\
+		typedef float    vf   __attribute__((__vector_size__(LANES * sizeof(float)),    __unused__));\
+		typedef double   vd   __attribute__((__vector_size__(LANES * sizeof(double)),   __unused__));\
+		TYPE_##OUT *restrict out = out_;\
+		const TYPE_##IN *restrict in = in_;\
+		VECTOR_##IN v;\
+		VECTOR_##OUT r;\
+		size_t i;\
+		for (i = 0; n - i >= LANES; i += LANES) {\
+			memcpy(&v, &in[i], sizeof(v));\
+			__VA_ARGS__;\
+			memcpy(&out[i], &r, sizeof(r));\
+		}\
+		libgamma_internal_scalar_translator(DEPTH_##OUT, DEPTH_##IN)(n - i, &out[i], &in[i]);\
+	}
+
+
+/* Integer widening, by repeating the bit pattern, one doubling at a time */
+KERNEL(16,  8, vu16 a = CONVERT(v, vu16); r = a | a << 8)
+KERNEL(32,  8, vu16 a = CONVERT(v, vu16); a |= a << 8; vu32 b = CONVERT(a, vu32); r = b | b << 16)
+KERNEL(64,  8, vu16 a = CONVERT(v, vu16); a |= a << 8; vu32 b = CONVERT(a, vu32); b |= b << 16;
+               vu64 c = CONVERT(b, vu64); r = c | c << 32)
+KERNEL(32, 16, vu32 a = CONVERT(v, vu32); r = a | a << 16)
+KERNEL(64, 16, vu32 a = CONVERT(v, vu32); a |= a << 16; vu64 b = CONVERT(a, vu64); r = b | b << 32)
+KERNEL(64, 32, vu64 a = CONVERT(v, vu64); r = a | a << 32)
+
+/* Integer narrowing, by division by 0x0101…, one halving at a time */
+KERNEL( 8, 16, NARROW(v, 8); r = CONVERT(v, vu8))
+KERNEL( 8, 32, NARROW(v, 16); vu16 a = CONVERT(v, vu16); NARROW(a, 8); r = CONVERT(a, vu8))
+KERNEL( 8, 64, NARROW(v, 32); vu32 a = CONVERT(v, vu32); NARROW(a, 16); vu16 b = CONVERT(a, vu16);
+               NARROW(b, 8); r = CONVERT(b, vu8))
+KERNEL(16, 32, NARROW(v, 16); r = CONVERT(v, vu16))
+KERNEL(16, 64, NARROW(v, 32); vu32 a = CONVERT(v, vu32); NARROW(a, 16); r = CONVERT(a, vu16))
+KERNEL(32, 64, NARROW(v, 32); r = CONVERT(v, vu32))
+
+#ifdef HAVE_SIMD_FLOAT_TRANSLATORS
+/* Floating point to low depth integer, by clamping and scaling */
+KERNEL( 8,  f, vd d = CONVERT(v, vd) * (double)UINT8_MAX;  CLAMP(d, vd, vi64, UINT8_MAX);  r = CONVERT(CONVERT(d, vi32), vu8))
+KERNEL(16,  f, vd d = CONVERT(v, vd) * (double)UINT16_MAX; CLAMP(d, vd, vi64, UINT16_MAX); r = CONVERT(CONVERT(d, vi32), vu16))
+#endif
+
+
+/**
+ * Table of the translators in this kernel set,
+ * indexed by output depth and input depth
+ */
+static translate_fun *const KERNEL_TABLE(KERNEL_SET)[6][6] = {
+#define X(OUT, IN)\
+	[INDEX_##OUT][INDEX_##IN] = &KERNEL_NAME(OUT, IN, KERNEL_SET),
+	LIST_SIMD_TRANSLATIONS(X)
+#undef X
+};
+
+
+#undef KERNEL
+#undef KERNEL_ATTRIBUTES